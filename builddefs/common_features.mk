@@ -250,6 +250,11 @@ else
   endif
 endif
 
+ifeq ($(strip $(EEPROM_WRITE_BEHIND_ENABLE)), yes)
+  OPT_DEFS += -DEEPROM_WRITE_BEHIND_ENABLE
+  SRC += eeprom_write_behind.c
+endif
+
 VALID_WEAR_LEVELING_DRIVER_TYPES := custom embedded_flash spi_flash rp2040_flash legacy
 WEAR_LEVELING_DRIVER ?= none
 ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
@@ -458,6 +463,7 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_drivers.c
+    SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_geometry.c
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
     RGB_KEYCODES_ENABLE := yes
@@ -570,6 +576,24 @@ ifneq ($(strip $(VARIABLE_TRACE)),no)
     endif
 endif
 
+ifeq ($(strip $(TICKLESS_IDLE_ENABLE)), yes)
+    ifeq ($(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/tickless_idle.c),)
+        $(call CATASTROPHIC_ERROR,Invalid TICKLESS_IDLE_ENABLE,Tickless idle is not supported on the $(PLATFORM_KEY) platform)
+    endif
+    ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
+        $(call CATASTROPHIC_ERROR,Invalid TICKLESS_IDLE_ENABLE,Tickless idle is not supported on split keyboards)
+    endif
+    SRC += $(QUANTUM_DIR)/tickless_idle.c
+    SRC += $(PLATFORM_COMMON_DIR)/tickless_idle.c
+    OPT_DEFS += -DTICKLESS_IDLE_ENABLE
+endif
+
+ifeq ($(strip $(KEY_EVENT_QUEUE_ENABLE)), yes)
+    SRC += $(QUANTUM_DIR)/key_event_queue.c
+    SRC += $(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/key_event_queue_scan_thread.c)
+    OPT_DEFS += -DKEY_EVENT_QUEUE_ENABLE
+endif
+
 ifeq ($(strip $(SLEEP_LED_ENABLE)), yes)
     SRC += $(PLATFORM_COMMON_DIR)/sleep_led.c
     OPT_DEFS += -DSLEEP_LED_ENABLE
@@ -742,6 +766,7 @@ ifeq ($(strip $(OLED_ENABLE)), yes)
             COMMON_VPATH += $(DRIVER_PATH)/oled
             ifneq ($(strip $(OLED_DRIVER)), custom)
                 SRC += oled_driver.c
+                SRC += $(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/oled_flush_async.c)
             endif
 
             OPT_DEFS += -DOLED_TRANSPORT_$(strip $(shell echo $(OLED_TRANSPORT) | tr '[:lower:]' '[:upper:]'))
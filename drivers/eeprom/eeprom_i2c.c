@@ -37,6 +37,9 @@
 #include "i2c_master.h"
 #include "eeprom.h"
 #include "eeprom_i2c.h"
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
 
 // #define DEBUG_EEPROM_OUTPUT
 
@@ -53,6 +56,8 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+static void i2c_eeprom_write_block(const void *buf, void *addr, size_t len);
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -67,10 +72,14 @@ void eeprom_driver_erase(void) {
     uint32_t start = timer_read32();
 #endif
 
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_clear();
+#endif
+
     uint8_t buf[EXTERNAL_EEPROM_PAGE_SIZE];
     memset(buf, 0x00, EXTERNAL_EEPROM_PAGE_SIZE);
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
-        eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
+        i2c_eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
     }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
@@ -84,6 +93,9 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 
     i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
     i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_apply(buf, addr, len);
+#endif
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
@@ -94,7 +106,7 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 #endif // DEBUG_EEPROM_OUTPUT
 }
 
-void eeprom_write_block(const void *buf, void *addr, size_t len) {
+static void i2c_eeprom_write_block(const void *buf, void *addr, size_t len) {
     uint8_t   complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
     uint8_t * read_buf    = (uint8_t *)buf;
     uintptr_t target_addr = (uintptr_t)addr;
@@ -138,3 +150,12 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     gpio_set_pin_input_high(EXTERNAL_EEPROM_WP_PIN);
 #endif
 }
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    if (eeprom_write_behind_defer(buf, addr, len)) {
+        return;
+    }
+#endif
+    i2c_eeprom_write_block(buf, addr, len);
+}
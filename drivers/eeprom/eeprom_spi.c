@@ -36,6 +36,9 @@
 #include "spi_master.h"
 #include "eeprom.h"
 #include "eeprom_spi.h"
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
 
 #define CMD_WREN 6
 #define CMD_WRDI 4
@@ -88,6 +91,8 @@ static void spi_eeprom_transmit_address(uintptr_t addr) {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+static void spi_eeprom_write_block(const void *buf, void *addr, size_t len);
+
 void eeprom_driver_init(void) {
     spi_init();
 }
@@ -97,10 +102,14 @@ void eeprom_driver_erase(void) {
     uint32_t start = timer_read32();
 #endif
 
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_clear();
+#endif
+
     uint8_t buf[EXTERNAL_EEPROM_PAGE_SIZE];
     memset(buf, 0x00, EXTERNAL_EEPROM_PAGE_SIZE);
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
-        eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
+        spi_eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
     }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
@@ -132,6 +141,9 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     spi_write(CMD_READ);
     spi_eeprom_transmit_address((uintptr_t)addr);
     spi_receive(buf, len);
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_apply(buf, addr, len);
+#endif
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%08lX: ", ((uint32_t)(uintptr_t)addr));
@@ -144,7 +156,7 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     spi_stop();
 }
 
-void eeprom_write_block(const void *buf, void *addr, size_t len) {
+static void spi_eeprom_write_block(const void *buf, void *addr, size_t len) {
     bool      res;
     uint8_t * read_buf    = (uint8_t *)buf;
     uintptr_t target_addr = (uintptr_t)addr;
@@ -215,3 +227,12 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     spi_write(CMD_WRDI);
     spi_stop();
 }
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    if (eeprom_write_behind_defer(buf, addr, len)) {
+        return;
+    }
+#endif
+    spi_eeprom_write_block(buf, addr, len);
+}
@@ -5,19 +5,33 @@
 
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
 
 void eeprom_driver_init(void) {
     wear_leveling_init();
 }
 
 void eeprom_driver_erase(void) {
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_clear();
+#endif
     wear_leveling_erase();
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
     wear_leveling_read((uint32_t)addr, buf, len);
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_apply(buf, addr, len);
+#endif
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    if (eeprom_write_behind_defer(buf, addr, len)) {
+        return;
+    }
+#endif
     wear_leveling_write((uint32_t)addr, buf, len);
 }
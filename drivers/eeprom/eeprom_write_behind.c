@@ -0,0 +1,166 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdint.h>
+#include <string.h>
+
+#include "eeprom.h"
+#include "eeprom_write_behind.h"
+#include "timer.h"
+#include "util.h"
+
+#if !defined(EEPROM_I2C) && !defined(EEPROM_SPI) && !defined(EEPROM_WEAR_LEVELING) && !defined(EEPROM_CUSTOM) && !defined(EEPROM_TEST_HARNESS)
+#    error "EEPROM_WRITE_BEHIND_ENABLE is not supported by this EEPROM driver"
+#endif
+
+// Custom drivers only hold writes in the cache if they call the hooks, so they have to say that they do
+#if defined(EEPROM_CUSTOM) && !defined(EEPROM_WRITE_BEHIND_CUSTOM_DRIVER)
+#    error "EEPROM_WRITE_BEHIND_ENABLE needs the custom EEPROM driver to call the write-behind hooks, and to define EEPROM_WRITE_BEHIND_CUSTOM_DRIVER in config.h"
+#endif
+
+#ifndef EEPROM_WRITE_BEHIND_DELAY
+#    define EEPROM_WRITE_BEHIND_DELAY 1000
+#endif
+
+#ifndef EEPROM_WRITE_BEHIND_BLOCK_SIZE
+#    define EEPROM_WRITE_BEHIND_BLOCK_SIZE 16
+#endif
+
+#ifndef EEPROM_WRITE_BEHIND_BLOCK_COUNT
+#    define EEPROM_WRITE_BEHIND_BLOCK_COUNT 8
+#endif
+
+_Static_assert(EEPROM_WRITE_BEHIND_BLOCK_SIZE <= 32 && (EEPROM_WRITE_BEHIND_BLOCK_SIZE & (EEPROM_WRITE_BEHIND_BLOCK_SIZE - 1)) == 0, "EEPROM_WRITE_BEHIND_BLOCK_SIZE must be a power of two, no larger than 32");
+_Static_assert(EEPROM_WRITE_BEHIND_BLOCK_COUNT > 0 && EEPROM_WRITE_BEHIND_BLOCK_COUNT <= UINT8_MAX, "EEPROM_WRITE_BEHIND_BLOCK_COUNT must be between 1 and 255");
+
+#define BLOCK_BASE(address) ((address) & ~(uintptr_t)(EEPROM_WRITE_BEHIND_BLOCK_SIZE - 1))
+#define BYTE_MASK(offset, count) ((UINT32_MAX >> (32 - (count))) << (offset))
+
+typedef struct {
+    uintptr_t base;                                 // address of data[0], a multiple of the block size
+    uint32_t  dirty;                                // one bit per byte of data[] waiting to be written
+    uint8_t   data[EEPROM_WRITE_BEHIND_BLOCK_SIZE]; // the bytes to write
+} write_behind_block_t;
+
+// Blocks in use, sorted by address so that they're written back in order
+static write_behind_block_t blocks[EEPROM_WRITE_BEHIND_BLOCK_COUNT];
+static uint8_t              blocks_used = 0;
+static uint16_t             last_write  = 0;
+static bool                 flushing    = false;
+
+// Returns the index of the block with the given base address, or where it would be inserted if not in use
+static uint8_t find_block(uintptr_t base) {
+    uint8_t i = 0;
+    while (i < blocks_used && blocks[i].base < base) {
+        i++;
+    }
+    return i;
+}
+
+static bool block_in_use(uint8_t i, uintptr_t base) {
+    return i < blocks_used && blocks[i].base == base;
+}
+
+// Returns the number of blocks not yet in use that would be needed to hold the given range
+static size_t blocks_needed(uintptr_t start, uintptr_t end) {
+    size_t needed = 0;
+    for (uintptr_t base = BLOCK_BASE(start); base < end; base += EEPROM_WRITE_BEHIND_BLOCK_SIZE) {
+        if (!block_in_use(find_block(base), base)) {
+            needed++;
+        }
+    }
+    return needed;
+}
+
+bool eeprom_write_behind_defer(const void *buf, const void *addr, size_t len) {
+    if (flushing) {
+        return false;
+    }
+
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end   = start + len;
+    if (blocks_needed(start, end) > EEPROM_WRITE_BEHIND_BLOCK_COUNT - blocks_used) {
+        // Write back what's already held first, so that none of it can later land on top of this write
+        eeprom_write_behind_flush();
+        if (blocks_needed(start, end) > EEPROM_WRITE_BEHIND_BLOCK_COUNT) {
+            return false;
+        }
+    }
+
+    const uint8_t *src = (const uint8_t *)buf;
+    for (uintptr_t address = start; address < end;) {
+        uintptr_t base = BLOCK_BASE(address);
+        uint8_t   i    = find_block(base);
+        if (!block_in_use(i, base)) {
+            memmove(&blocks[i + 1], &blocks[i], (blocks_used - i) * sizeof(blocks[0]));
+            blocks[i].base  = base;
+            blocks[i].dirty = 0;
+            blocks_used++;
+        }
+
+        uint8_t offset = address - base;
+        uint8_t count  = MIN(end - address, EEPROM_WRITE_BEHIND_BLOCK_SIZE - offset);
+        memcpy(&blocks[i].data[offset], src, count);
+        blocks[i].dirty |= BYTE_MASK(offset, count);
+        src += count;
+        address += count;
+    }
+
+    last_write = timer_read();
+    return true;
+}
+
+void eeprom_write_behind_apply(void *buf, const void *addr, size_t len) {
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end   = start + len;
+    uint8_t * dest  = (uint8_t *)buf;
+    for (uint8_t i = find_block(BLOCK_BASE(start)); i < blocks_used && blocks[i].base < end; i++) {
+        for (uint8_t offset = 0; offset < EEPROM_WRITE_BEHIND_BLOCK_SIZE; offset++) {
+            uintptr_t address = blocks[i].base + offset;
+            if ((blocks[i].dirty & (1UL << offset)) && address >= start && address < end) {
+                dest[address - start] = blocks[i].data[offset];
+            }
+        }
+    }
+}
+
+void eeprom_write_behind_clear(void) {
+    blocks_used = 0;
+}
+
+bool eeprom_write_behind_pending(void) {
+    return blocks_used > 0;
+}
+
+void eeprom_write_behind_flush(void) {
+    if (flushing) {
+        return;
+    }
+
+    // Writes made from here on go straight to the backing EEPROM
+    flushing = true;
+    for (uint8_t i = 0; i < blocks_used; i++) {
+        // One write per run of consecutive dirty bytes
+        uint8_t offset = 0;
+        while (offset < EEPROM_WRITE_BEHIND_BLOCK_SIZE) {
+            if (!(blocks[i].dirty & (1UL << offset))) {
+                offset++;
+                continue;
+            }
+            uint8_t count = 1;
+            while (offset + count < EEPROM_WRITE_BEHIND_BLOCK_SIZE && (blocks[i].dirty & (1UL << (offset + count)))) {
+                count++;
+            }
+            eeprom_write_block(&blocks[i].data[offset], (void *)(blocks[i].base + offset), count);
+            offset += count;
+        }
+    }
+    blocks_used = 0;
+    flushing    = false;
+}
+
+void eeprom_write_behind_task(void) {
+    if (blocks_used > 0 && timer_elapsed(last_write) >= EEPROM_WRITE_BEHIND_DELAY) {
+        eeprom_write_behind_flush();
+    }
+}
@@ -0,0 +1,49 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Write-behind cache for EEPROM writes.
+ *
+ * Writes are held in RAM, where later writes to the same bytes replace earlier ones, and only committed to the
+ * backing EEPROM once no further writes have been made for EEPROM_WRITE_BEHIND_DELAY milliseconds, or when the
+ * keyboard suspends or resets. This spares flash-backed stores from a log entry per step of a settings change, and
+ * external EEPROMs from a write cycle per byte.
+ *
+ * EEPROM drivers call the hooks below from their read, write and erase functions.
+ */
+
+/**
+ * Holds the given write in the cache, flushing the cache first if there isn't room for it. Returns false if the write
+ * must be made directly instead, which is when it is larger than the whole cache, or the cache is being flushed.
+ */
+bool eeprom_write_behind_defer(const void *buf, const void *addr, size_t len);
+
+/**
+ * Overlays any cached writes onto data just read from the backing EEPROM.
+ */
+void eeprom_write_behind_apply(void *buf, const void *addr, size_t len);
+
+/**
+ * Discards all cached writes, for when the backing EEPROM is erased.
+ */
+void eeprom_write_behind_clear(void);
+
+/**
+ * Returns whether there are cached writes still to be committed.
+ */
+bool eeprom_write_behind_pending(void);
+
+/**
+ * Commits all cached writes to the backing EEPROM.
+ */
+void eeprom_write_behind_flush(void);
+
+/**
+ * Commits all cached writes once no writes have been made for EEPROM_WRITE_BEHIND_DELAY milliseconds.
+ */
+void eeprom_write_behind_task(void);
@@ -30,6 +30,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <string.h>
 #include "progmem.h"
 #include "wait.h"
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
 
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
@@ -165,6 +168,17 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#if defined(OLED_DIFF_RENDER)
+// What the panel is showing, in its own memory layout -- which, unless rotated, matches oled_buffer
+static uint8_t oled_shadow[OLED_MATRIX_SIZE];
+static bool    oled_shadow_valid = false;
+#endif
+#if defined(OLED_ASYNC_FLUSH)
+// Changes waiting to be sent, as (page, column, length, data...) records
+static uint8_t       oled_flush_buffer[OLED_ASYNC_FLUSH_BUFFER_SIZE];
+static uint16_t      oled_flush_length = 0;
+static volatile bool oled_flush_failed = false;
+#endif
 
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
@@ -204,6 +218,9 @@ __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
     i2c_status_t status = i2c_transmit((OLED_DISPLAY_ADDRESS << 1), data, size, OLED_I2C_TIMEOUT);
 
     return (status == I2C_STATUS_SUCCESS);
+#else
+    // Custom transports provide their own implementation
+    return false;
 #endif
 }
 
@@ -250,6 +267,28 @@ __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
 #elif defined(OLED_TRANSPORT_I2C)
     i2c_status_t status = i2c_write_register((OLED_DISPLAY_ADDRESS << 1), I2C_DATA, data, size, OLED_I2C_TIMEOUT);
     return (status == I2C_STATUS_SUCCESS);
+#else
+    // Custom transports provide their own implementation
+    return false;
+#endif
+}
+
+#if defined(OLED_ASYNC_FLUSH)
+__attribute__((weak)) void oled_flush_async(void) {
+    oled_flush_batch();
+}
+
+__attribute__((weak)) bool oled_flush_async_busy(void) {
+    return false;
+}
+#endif
+
+// Commands can't be sent while a batch of changes is being sent in the background
+static void oled_flush_wait(void) {
+#if defined(OLED_ASYNC_FLUSH)
+    while (oled_flush_async_busy()) {
+        wait_ms(1);
+    }
 #endif
 }
 
@@ -296,7 +335,11 @@ bool oled_init(oled_rotation_t rotation) {
     } else {
         oled_rotation_width = OLED_DISPLAY_HEIGHT;
     }
+    oled_flush_wait();
     oled_driver_init();
+#if defined(OLED_DIFF_RENDER)
+    oled_shadow_valid = false;
+#endif
 
     static const uint8_t PROGMEM display_setup1[] = {
         I2C_CMD,
@@ -382,6 +425,7 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
+#if !defined(OLED_DIFF_RENDER)
 static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
     uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
@@ -430,6 +474,7 @@ static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
     cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) % OLED_DISPLAY_HEIGHT / 8 + cmd_array[4];
 #endif
 }
+#endif
 
 uint8_t crot(uint8_t a, int8_t n) {
     const uint8_t mask = 0x7;
@@ -446,6 +491,180 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+#if defined(OLED_DIFF_RENDER)
+// Builds the commands to address a run of columns within a page, returning their length
+static uint8_t oled_span_address(uint8_t page, uint8_t column, uint8_t length, uint8_t *cmd) {
+    cmd[0] = I2C_CMD;
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+    cmd[1] = COLUMN_ADDR;
+    cmd[2] = column + OLED_COLUMN_OFFSET;
+    cmd[3] = column + OLED_COLUMN_OFFSET + length - 1;
+    cmd[4] = PAGE_ADDR;
+    cmd[5] = page;
+    cmd[6] = page;
+    return 7;
+#    else
+    cmd[1] = PAM_PAGE_ADDR | page;
+    cmd[2] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + column) & 0x0f);
+    cmd[3] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + column) >> 4 & 0x0f);
+    return 4;
+#    endif
+}
+
+// Sends a run of columns within a page, or adds it to the batch to send in the background
+static bool oled_send_span(uint8_t page, uint8_t column, const uint8_t *data, uint8_t length) {
+#    if defined(OLED_ASYNC_FLUSH)
+    if (oled_flush_length + 3 + length > sizeof(oled_flush_buffer)) {
+        return false;
+    }
+    uint8_t *record = &oled_flush_buffer[oled_flush_length];
+    record[0]       = page;
+    record[1]       = column;
+    record[2]       = length;
+    memcpy(&record[3], data, length);
+    oled_flush_length += 3 + length;
+    return true;
+#    else
+    uint8_t cmd[7];
+    if (!oled_send_cmd(cmd, oled_span_address(page, column, length, cmd))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+    if (!oled_send_data(data, length)) {
+        print("oled_render data failed\n");
+        return false;
+    }
+    return true;
+#    endif
+}
+
+#    if defined(OLED_ASYNC_FLUSH)
+bool oled_flush_batch(void) {
+    uint16_t offset = 0;
+    while (offset < oled_flush_length) {
+        const uint8_t *record = &oled_flush_buffer[offset];
+        uint8_t        cmd[7];
+        if (!oled_send_cmd(cmd, oled_span_address(record[0], record[1], record[2], cmd)) || !oled_send_data(&record[3], record[2])) {
+            oled_flush_failed = true;
+            break;
+        }
+        offset += 3 + record[2];
+    }
+    oled_flush_length = 0;
+    return !oled_flush_failed;
+}
+#    endif
+
+// Sends the columns of a page that differ from what the panel is showing. Returns the number of bytes sent, or -1 on failure
+static int16_t oled_render_page_diff(uint8_t page, uint8_t column, const uint8_t *data, uint8_t length) {
+    uint8_t *shadow = &oled_shadow[page * OLED_DISPLAY_WIDTH + column];
+    int16_t  sent   = 0;
+    uint8_t  i      = 0;
+    while (true) {
+        // Skip over what hasn't changed
+        while (i < length && oled_shadow_valid && data[i] == shadow[i]) {
+            ++i;
+        }
+        if (i >= length) {
+            return sent;
+        }
+
+        // Extend the span over short unchanged runs, as the extra data costs less than addressing a new span
+        uint8_t start = i;
+        uint8_t end   = ++i;
+        while (i < length && i - end <= OLED_DIFF_MAX_GAP) {
+            if (!oled_shadow_valid || data[i] != shadow[i]) {
+                end = i + 1;
+            }
+            ++i;
+        }
+
+        if (!oled_send_span(page, column + start, &data[start], end - start)) {
+            return -1;
+        }
+        memcpy(&shadow[start], &data[start], end - start);
+        sent += end - start;
+        i = end;
+    }
+}
+
+// Sends the dirty blocks a page at a time, leaving out anything the panel is already showing
+static void oled_render_diff(bool all) {
+#    if defined(OLED_ASYNC_FLUSH)
+    if (oled_flush_failed) {
+        print("oled_render data failed\n");
+        oled_flush_failed = false;
+        oled_shadow_valid = false;
+        oled_dirty        = OLED_ALL_BLOCKS_MASK;
+    }
+#    endif
+
+    uint8_t num_processed = 0;
+    for (uint8_t update_start = 0; update_start < OLED_BLOCK_COUNT && (num_processed < OLED_UPDATE_PROCESS_LIMIT || all); ++update_start) {
+        if (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
+            continue;
+        }
+
+        int16_t sent = 0;
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            // The block is laid out as the panel expects, split it at the page boundaries
+            uint16_t index = OLED_BLOCK_SIZE * update_start;
+            uint16_t end   = index + OLED_BLOCK_SIZE;
+            while (index < end && sent >= 0) {
+                uint8_t column = index % OLED_DISPLAY_WIDTH;
+                uint8_t length = MIN(end - index, OLED_DISPLAY_WIDTH - column);
+                int16_t result = oled_render_page_diff(index / OLED_DISPLAY_WIDTH, column, &oled_buffer[index], length);
+                sent           = result < 0 ? result : sent + result;
+                index += length;
+            }
+        } else {
+            // Rotate the block into the panel's layout, then diff it a page at a time
+            const static uint8_t source_map[] = OLED_SOURCE_MAP;
+            const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+            memset(temp_buffer, 0, sizeof(temp_buffer));
+            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+            }
+
+            const uint8_t height_in_pages       = OLED_DISPLAY_HEIGHT / 8;
+            const uint8_t page_inc_per_block    = OLED_BLOCK_SIZE % OLED_DISPLAY_HEIGHT / 8;
+            const uint8_t bottom_block_top_page = (height_in_pages - page_inc_per_block) % height_in_pages;
+            const uint8_t start_page            = bottom_block_top_page - (OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT / 8);
+            const uint8_t start_column          = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8;
+            const uint8_t columns_in_block      = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
+            const uint8_t num_pages             = OLED_BLOCK_SIZE / columns_in_block;
+            for (uint8_t i = 0; i < num_pages && sent >= 0; ++i) {
+                int16_t result = oled_render_page_diff(start_page + i, start_column, &temp_buffer[columns_in_block * i], columns_in_block);
+                sent           = result < 0 ? result : sent + result;
+            }
+        }
+
+        if (sent < 0) {
+            break;
+        }
+
+        // Clear dirty flag of just rendered block -- blocks that turned out not to have changed don't count towards the limit
+        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        if (sent > 0) {
+            ++num_processed;
+        }
+    }
+
+    // The whole panel has been written once every block has been
+    if (!oled_dirty) {
+        oled_shadow_valid = true;
+    }
+
+#    if defined(OLED_ASYNC_FLUSH)
+    if (oled_flush_length > 0) {
+        oled_flush_async();
+    }
+#    endif
+}
+#endif
+
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
@@ -453,9 +672,19 @@ void oled_render_dirty(bool all) {
         return;
     }
 
+#if defined(OLED_ASYNC_FLUSH)
+    // The last batch is still being sent, the changes since will go in the next one
+    if (oled_flush_async_busy()) {
+        return;
+    }
+#endif
+
     // Turn on display if it is off
     oled_on();
 
+#if defined(OLED_DIFF_RENDER)
+    oled_render_diff(all);
+#else
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
     while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
@@ -530,6 +759,7 @@ void oled_render_dirty(bool all) {
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
+#endif
 }
 
 void oled_set_cursor(uint8_t col, uint8_t line) {
@@ -749,6 +979,7 @@ bool oled_on(void) {
 #endif
 
     if (!oled_active) {
+        oled_flush_wait();
         if (!oled_send_cmd_P(display_on, ARRAY_SIZE(display_on))) {
             print("oled_on cmd failed\n");
             return oled_active;
@@ -771,6 +1002,7 @@ bool oled_off(void) {
 #endif
 
     if (oled_active) {
+        oled_flush_wait();
         if (!oled_send_cmd_P(display_off, ARRAY_SIZE(display_off))) {
             print("oled_off cmd failed\n");
             return oled_active;
@@ -791,6 +1023,7 @@ uint8_t oled_set_brightness(uint8_t level) {
 
     uint8_t set_contrast[] = {I2C_CMD, CONTRAST, level};
     if (oled_brightness != level) {
+        oled_flush_wait();
         if (!oled_send_cmd(set_contrast, ARRAY_SIZE(set_contrast))) {
             print("set_brightness cmd failed\n");
             return oled_brightness;
@@ -838,6 +1071,7 @@ bool oled_scroll_right(void) {
     // This prevents scrolling of bad data from starting the scroll too early after init
     if (!oled_dirty && !oled_scrolling) {
         uint8_t display_scroll_right[] = {I2C_CMD, SCROLL_RIGHT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
+        oled_flush_wait();
         if (!oled_send_cmd(display_scroll_right, ARRAY_SIZE(display_scroll_right))) {
             print("oled_scroll_right cmd failed\n");
             return oled_scrolling;
@@ -856,6 +1090,7 @@ bool oled_scroll_left(void) {
     // This prevents scrolling of bad data from starting the scroll too early after init
     if (!oled_dirty && !oled_scrolling) {
         uint8_t display_scroll_left[] = {I2C_CMD, SCROLL_LEFT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
+        oled_flush_wait();
         if (!oled_send_cmd(display_scroll_left, ARRAY_SIZE(display_scroll_left))) {
             print("oled_scroll_left cmd failed\n");
             return oled_scrolling;
@@ -872,12 +1107,17 @@ bool oled_scroll_off(void) {
 
     if (oled_scrolling) {
         static const uint8_t PROGMEM display_scroll_off[] = {I2C_CMD, DEACTIVATE_SCROLL};
+        oled_flush_wait();
         if (!oled_send_cmd_P(display_scroll_off, ARRAY_SIZE(display_scroll_off))) {
             print("oled_scroll_off cmd failed\n");
             return oled_scrolling;
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#if defined(OLED_DIFF_RENDER)
+        // Scrolling moves the panel's contents around, so the next render needs to rewrite all of it
+        oled_shadow_valid = false;
+#endif
     }
     return !oled_scrolling;
 }
@@ -893,6 +1133,7 @@ bool oled_invert(bool invert) {
 
     if (invert && !oled_inverted) {
         static const uint8_t PROGMEM display_inverted[] = {I2C_CMD, INVERT_DISPLAY};
+        oled_flush_wait();
         if (!oled_send_cmd_P(display_inverted, ARRAY_SIZE(display_inverted))) {
             print("oled_invert cmd failed\n");
             return oled_inverted;
@@ -900,6 +1141,7 @@ bool oled_invert(bool invert) {
         oled_inverted = true;
     } else if (!invert && oled_inverted) {
         static const uint8_t PROGMEM display_normal[] = {I2C_CMD, NORMAL_DISPLAY};
+        oled_flush_wait();
         if (!oled_send_cmd_P(display_normal, ARRAY_SIZE(display_normal))) {
             print("oled_invert cmd failed\n");
             return oled_inverted;
@@ -968,6 +1210,37 @@ void oled_task(void) {
 #endif
 }
 
+#ifdef TICKLESS_IDLE_ENABLE
+uint32_t oled_idle_delay(uint32_t delay_ms) {
+    if (!oled_initialized || !oled_active) {
+        return delay_ms;
+    }
+    if (oled_dirty) {
+        return 0;
+    }
+
+#    if OLED_TIMEOUT > 0
+    delay_ms = tickless_idle_until(delay_ms, oled_timeout);
+#    endif
+#    if OLED_SCROLL_TIMEOUT > 0
+    if (!oled_scrolling) {
+        delay_ms = tickless_idle_until(delay_ms, oled_scroll_timeout);
+    }
+#    endif
+
+#    if OLED_UPDATE_INTERVAL > 0
+    uint16_t elapsed = timer_elapsed(oled_update_timeout);
+    if (elapsed >= OLED_UPDATE_INTERVAL) {
+        return 0;
+    }
+    return MIN(delay_ms, (uint32_t)(OLED_UPDATE_INTERVAL - elapsed));
+#    else
+    // oled_task_kb() is expected to run every scan, so a lit display keeps the keyboard awake
+    return 0;
+#    endif
+}
+#endif
+
 __attribute__((weak)) bool oled_task_kb(void) {
     return oled_task_user();
 }
@@ -321,6 +321,33 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+// Sending in the background needs the changes batched up, which the diffing renderer does
+#if defined(OLED_ASYNC_FLUSH) && !defined(OLED_DIFF_RENDER)
+#    define OLED_DIFF_RENDER
+#endif
+
+// Unchanged runs of bytes longer than this split an update in two, as addressing the
+// second part costs less than resending them
+#if !defined(OLED_DIFF_MAX_GAP)
+#    define OLED_DIFF_MAX_GAP 6
+#endif
+
+// Room for the changes sent in one go in the background, each taking 3 bytes on top of its data
+#if !defined(OLED_ASYNC_FLUSH_BUFFER_SIZE)
+#    define OLED_ASYNC_FLUSH_BUFFER_SIZE (OLED_MATRIX_SIZE + 96)
+#endif
+
+#if defined(OLED_ASYNC_FLUSH)
+// A change never spans more than one page, so a full-width one has to fit or the display never updates
+_Static_assert(OLED_ASYNC_FLUSH_BUFFER_SIZE >= 3 + OLED_DISPLAY_WIDTH, "OLED_ASYNC_FLUSH_BUFFER_SIZE must hold at least one full-width change, 3 + OLED_DISPLAY_WIDTH bytes");
+#endif
+
+// Stack for the background sending thread, which has to hold a full-width change for the I2C transport on top of
+// the driver and RTOS frames
+#if !defined(OLED_ASYNC_FLUSH_STACK_SIZE)
+#    define OLED_ASYNC_FLUSH_STACK_SIZE (OLED_DISPLAY_WIDTH + 512)
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
@@ -450,6 +477,12 @@ void oled_task(void);
 bool oled_task_kb(void);
 bool oled_task_user(void);
 
+#ifdef TICKLESS_IDLE_ENABLE
+// Shortens a tickless idle sleep so that it ends in time for the next render, update or timeout
+// Returns zero while the display is lit without an OLED_UPDATE_INTERVAL, as oled_task_kb runs every scan
+uint32_t oled_idle_delay(uint32_t delay_ms);
+#endif
+
 // Set the specific 8 lines rows of the screen to scroll.
 // 0 is the default for start, and 7 for end, which is the entire
 // height of the screen.  For 128x32 screens, rows 4-7 are not used.
@@ -489,3 +522,16 @@ uint8_t oled_max_chars(void);
 
 // Returns the maximum number of lines that will fit on the oled
 uint8_t oled_max_lines(void);
+
+#if defined(OLED_ASYNC_FLUSH)
+// Sends the changes batched up by the last render, returning false if any failed to send
+// Called by oled_flush_async(), usually from a background thread
+bool oled_flush_batch(void);
+
+// Starts calling oled_flush_batch() in the background, weak function overridable by the platform
+// The default calls it straight away, before returning
+void oled_flush_async(void);
+
+// Returns true while the batch is still being sent, weak function overridable by the platform
+bool oled_flush_async_busy(void);
+#endif
@@ -5,6 +5,33 @@
 
 #    include "spi_master.h"
 #    include "qp_comms_spi.h"
+#    include "qp_draw.h"
+
+#    if QUANTUM_PAINTER_SPI_ASYNC && !defined(PROTOCOL_CHIBIOS)
+#        error "QUANTUM_PAINTER_SPI_ASYNC is only supported on ChibiOS"
+#    endif
+
+// Largest amount of data sent in one SPI transaction
+#    define QP_COMMS_SPI_MAX_MSG_LENGTH 1024
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Background transfers
+//
+// Pixel data staged in the global pixdata buffer is sent using DMA, and left to go out while the next block is prepared
+// in the other half of the buffer. Only one transfer is in flight at a time, and stopping comms waits for it to finish
+// before releasing the bus, so other devices sharing it never see the display still selected.
+//
+
+// Waits for the background transfer to finish, so the bus can be used again
+static void qp_comms_spi_sync(void) {
+#    if QUANTUM_PAINTER_SPI_ASYNC
+    spi_transmit_wait();
+#    endif
+}
+
+void qp_comms_spi_wait(painter_device_t device) {
+    qp_comms_spi_sync();
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
@@ -33,10 +60,19 @@ bool qp_comms_spi_start(painter_device_t device) {
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
     uint32_t       bytes_remaining = byte_count;
     const uint8_t *p               = (const uint8_t *)data;
-    const uint32_t max_msg_length  = 1024;
+
+    qp_comms_spi_sync();
+
+#    if QUANTUM_PAINTER_SPI_ASYNC
+    // Pixel data in the global buffer isn't touched until this transfer has finished, so it can go out in the background
+    if (byte_count <= QP_COMMS_SPI_MAX_MSG_LENGTH && qp_internal_pixdata_buffer_contains(data)) {
+        spi_transmit_async(p, byte_count);
+        return byte_count;
+    }
+#    endif
 
     while (bytes_remaining > 0) {
-        uint32_t bytes_this_loop = QP_MIN(bytes_remaining, max_msg_length);
+        uint32_t bytes_this_loop = QP_MIN(bytes_remaining, QP_COMMS_SPI_MAX_MSG_LENGTH);
         spi_transmit(p, bytes_this_loop);
         p += bytes_this_loop;
         bytes_remaining -= bytes_this_loop;
@@ -48,6 +84,7 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
 void qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
+    qp_comms_spi_sync();
     spi_stop();
     gpio_write_pin_high(comms_config->chip_select_pin);
 }
@@ -57,6 +94,7 @@ const painter_comms_vtable_t spi_comms_vtable = {
     .comms_start = qp_comms_spi_start,
     .comms_send  = qp_comms_spi_send_data,
     .comms_stop  = qp_comms_spi_stop,
+    .comms_wait  = qp_comms_spi_wait,
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -93,6 +131,7 @@ bool qp_comms_spi_dc_reset_init(painter_device_t device) {
 uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    qp_comms_spi_sync();
     gpio_write_pin_high(comms_config->dc_pin);
     return qp_comms_spi_send_data(device, data, byte_count);
 }
@@ -100,6 +139,7 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    qp_comms_spi_sync();
     gpio_write_pin_low(comms_config->dc_pin);
     spi_write(cmd);
 }
@@ -135,6 +175,7 @@ const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
             .comms_start = qp_comms_spi_start,
             .comms_send  = qp_comms_spi_dc_reset_send_data,
             .comms_stop  = qp_comms_spi_stop,
+            .comms_wait  = qp_comms_spi_wait,
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
@@ -23,6 +23,7 @@ bool     qp_comms_spi_init(painter_device_t device);
 bool     qp_comms_spi_start(painter_device_t device);
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void* data, uint32_t byte_count);
 void     qp_comms_spi_stop(painter_device_t device);
+void     qp_comms_spi_wait(painter_device_t device);
 
 extern const painter_comms_vtable_t spi_comms_vtable;
 
@@ -21,6 +21,23 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifdef SURFACE_DIRTY_TILES
+#    ifndef SURFACE_DIRTY_TILE_SIZE
+/**
+ * @def The width and height in pixels of each tile used to track the dirty areas of a surface. Smaller tiles track
+ *      scattered changes more closely, at the cost of more viewport transfers when drawing to the display.
+ */
+#        define SURFACE_DIRTY_TILE_SIZE 16
+#    endif
+#    ifndef SURFACE_DIRTY_TILE_ROWS
+/**
+ * @def The number of rows of tiles tracked per surface. Each row holds up to 32 tiles; pixels beyond the last row or
+ *      column are tracked by the tile at the edge.
+ */
+#        define SURFACE_DIRTY_TILE_ROWS 24
+#    endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -29,7 +29,74 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
+#ifdef SURFACE_DIRTY_TILES
+// Number of tiles in each row bitmap
+#    define SURFACE_DIRTY_TILE_COLUMNS 32
+
+static inline uint16_t tile_column(uint16_t x) {
+    // Anything past the last tile is tracked by the last tile
+    return QP_MIN(x / SURFACE_DIRTY_TILE_SIZE, SURFACE_DIRTY_TILE_COLUMNS - 1);
+}
+
+static inline uint16_t tile_row(uint16_t y) {
+    return QP_MIN(y / SURFACE_DIRTY_TILE_SIZE, SURFACE_DIRTY_TILE_ROWS - 1);
+}
+
+static void qp_surface_mark_all_tiles_dirty(surface_painter_device_t *surface) {
+    uint16_t last_column = tile_column(surface->base.panel_width - 1);
+    uint16_t last_row    = tile_row(surface->base.panel_height - 1);
+    uint32_t row_mask    = UINT32_MAX >> (SURFACE_DIRTY_TILE_COLUMNS - 1 - last_column);
+    for (uint16_t row = 0; row < SURFACE_DIRTY_TILE_ROWS; ++row) {
+        surface->dirty.tiles[row] = row <= last_row ? row_mask : 0;
+    }
+}
+
+bool qp_surface_next_dirty_rect(surface_painter_device_t *surface, uint32_t *tiles, uint16_t *l, uint16_t *t, uint16_t *r, uint16_t *b) {
+    for (uint16_t row = 0; row < SURFACE_DIRTY_TILE_ROWS; ++row) {
+        uint32_t bits = tiles[row];
+        if (!bits) {
+            continue;
+        }
+
+        // Take the first run of dirty tiles in this row...
+        uint32_t run          = bits ^ (bits & (bits + (bits & -bits)));
+        uint16_t first_column = __builtin_ctzl(run);
+        uint16_t last_column  = sizeof(unsigned long) * 8 - 1 - __builtin_clzl(run);
+
+        // ...and extend it down over the rows where the same tiles are dirty, so it goes out as a single transfer
+        uint16_t last_row = row;
+        while (last_row + 1 < SURFACE_DIRTY_TILE_ROWS && (tiles[last_row + 1] & run) == run) {
+            ++last_row;
+        }
+        for (uint16_t i = row; i <= last_row; ++i) {
+            tiles[i] &= ~run;
+        }
+
+        // Convert to pixels, with the edge tiles stretching to the edge of the surface
+        uint16_t w = surface->base.panel_width;
+        uint16_t h = surface->base.panel_height;
+        *l         = first_column * SURFACE_DIRTY_TILE_SIZE;
+        *t         = row * SURFACE_DIRTY_TILE_SIZE;
+        *r         = last_column == SURFACE_DIRTY_TILE_COLUMNS - 1 ? w - 1 : QP_MIN((last_column + 1) * SURFACE_DIRTY_TILE_SIZE - 1, w - 1);
+        *b         = last_row == SURFACE_DIRTY_TILE_ROWS - 1 ? h - 1 : QP_MIN((last_row + 1) * SURFACE_DIRTY_TILE_SIZE - 1, h - 1);
+
+        // Don't send more than the dirty region, so small changes within a tile stay small
+        *l = QP_MAX(*l, surface->dirty.l);
+        *t = QP_MAX(*t, surface->dirty.t);
+        *r = QP_MIN(*r, surface->dirty.r);
+        *b = QP_MIN(*b, surface->dirty.b);
+        return true;
+    }
+    return false;
+}
+#endif // SURFACE_DIRTY_TILES
+
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
+#ifdef SURFACE_DIRTY_TILES
+    // Maintain dirty tiles
+    dirty->tiles[tile_row(y)] |= (uint32_t)1 << tile_column(x);
+#endif
+
     // Maintain dirty region
     if (dirty->l > x) {
         dirty->l        = x;
@@ -62,6 +129,9 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface->dirty.r        = surface->base.panel_width - 1;
     surface->dirty.b        = surface->base.panel_height - 1;
     surface->dirty.is_dirty = true;
+#ifdef SURFACE_DIRTY_TILES
+    qp_surface_mark_all_tiles_dirty(surface);
+#endif
 
     return true;
 }
@@ -83,6 +153,9 @@ bool qp_surface_flush(painter_device_t device) {
     surface->dirty.l = surface->dirty.t = UINT16_MAX;
     surface->dirty.r = surface->dirty.b = 0;
     surface->dirty.is_dirty             = false;
+#ifdef SURFACE_DIRTY_TILES
+    memset(surface->dirty.tiles, 0, sizeof(surface->dirty.tiles));
+#endif
     return true;
 }
 
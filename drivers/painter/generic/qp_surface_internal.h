@@ -22,6 +22,10 @@ typedef struct surface_dirty_data_t {
     uint16_t t;
     uint16_t r;
     uint16_t b;
+#    ifdef SURFACE_DIRTY_TILES
+    // One bit per dirty tile, a word per row of tiles
+    uint32_t tiles[SURFACE_DIRTY_TILE_ROWS];
+#    endif
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -89,6 +93,9 @@ bool qp_surface_flush(painter_device_t device);
 bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
+#    ifdef SURFACE_DIRTY_TILES
+bool qp_surface_next_dirty_rect(surface_painter_device_t *surface, uint32_t *tiles, uint16_t *l, uint16_t *t, uint16_t *r, uint16_t *b);
+#    endif
 
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
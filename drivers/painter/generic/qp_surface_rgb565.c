@@ -68,14 +68,9 @@ static bool qp_surface_append_pixels_rgb565(painter_device_t device, uint8_t *ta
     return true;
 }
 
-static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+static bool rgb565_target_pixdata_transfer_rect(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
     surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
 
-    uint16_t l = entire_surface ? 0 : surface_handle->dirty.l;
-    uint16_t t = entire_surface ? 0 : surface_handle->dirty.t;
-    uint16_t r = entire_surface ? (surface_handle->base.panel_width - 1) : surface_handle->dirty.r;
-    uint16_t b = entire_surface ? (surface_handle->base.panel_height - 1) : surface_handle->dirty.b;
-
     // Set the target drawing area
     bool ok = qp_viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
     if (!ok) {
@@ -101,6 +96,9 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
                     qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
                     return false;
                 }
+                // Carry on filling the other half of the buffer while this one goes out, if double-buffered
+                qp_internal_pixdata_buffer_swap();
+                target_buffer = (uint16_t *)qp_internal_global_pixdata_buffer;
                 // Reset the counter
                 pixel_counter = 0;
             }
@@ -119,6 +117,30 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
     return true;
 }
 
+static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+
+    if (entire_surface) {
+        return rgb565_target_pixdata_transfer_rect(surface_driver, target_driver, x, y, 0, 0, surface_handle->base.panel_width - 1, surface_handle->base.panel_height - 1);
+    }
+
+#    ifdef SURFACE_DIRTY_TILES
+    // Send each group of dirty tiles separately, rather than everything in between
+    uint32_t tiles[SURFACE_DIRTY_TILE_ROWS];
+    memcpy(tiles, surface_handle->dirty.tiles, sizeof(tiles));
+
+    uint16_t l, t, r, b;
+    while (qp_surface_next_dirty_rect(surface_handle, tiles, &l, &t, &r, &b)) {
+        if (!rgb565_target_pixdata_transfer_rect(surface_driver, target_driver, x, y, l, t, r, b)) {
+            return false;
+        }
+    }
+    return true;
+#    else
+    return rgb565_target_pixdata_transfer_rect(surface_driver, target_driver, x, y, surface_handle->dirty.l, surface_handle->dirty.t, surface_handle->dirty.r, surface_handle->dirty.b);
+#    endif
+}
+
 static bool qp_surface_append_pixdata_rgb565(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
     target_buffer[pixdata_offset] = pixdata_byte;
     return true;
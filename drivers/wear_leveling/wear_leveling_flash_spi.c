@@ -41,6 +41,23 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+// Each bank needs to start on a block boundary, so that erasing one leaves the other alone
+_Static_assert((WEAR_LEVELING_BANK_SIZE) % (EXTERNAL_FLASH_BLOCK_SIZE) == 0, "Wear-leveling bank size must be a multiple of EXTERNAL_FLASH_BLOCK_SIZE");
+
+bool backing_store_erase_bank(uint8_t bank, uint32_t *offset) {
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    flash_status_t status = flash_erase_block((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + bank * (WEAR_LEVELING_BANK_SIZE) + *offset);
+    *offset += (EXTERNAL_FLASH_BLOCK_SIZE);
+
+    bs_dprintf("Backing store bank %d block erase took %ldms to complete\n", (int)bank, ((long)(timer_read32() - start)));
+    return status == FLASH_STATUS_SUCCESS;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
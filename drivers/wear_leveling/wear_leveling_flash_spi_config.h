@@ -8,9 +8,13 @@
 #    include "flash_spi.h"
 #endif
 
-// Use 1 block -- check the config for the SPI flash to determine how big it is
+// Use 1 block, or 2 for dual-bank -- check the config for the SPI flash to determine how big it is
 #ifndef WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT
-#    define WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT 1
+#    ifdef WEAR_LEVELING_DUAL_BANK
+#        define WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT 2
+#    else
+#        define WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT 1
+#    endif
 #endif // WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT
 
 // Start at the first block of the external flash
@@ -28,7 +32,11 @@
 #    define WEAR_LEVELING_BACKING_SIZE ((EXTERNAL_FLASH_BLOCK_SIZE) * (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT))
 #endif // WEAR_LEVELING_BACKING_SIZE
 
-// Use half of the backing size for logical EEPROM
+// Use half of the backing size for logical EEPROM, or a quarter for dual-bank
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
-#    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    ifdef WEAR_LEVELING_DUAL_BANK
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 4)
+#    else
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
 #endif // WEAR_LEVELING_LOGICAL_SIZE
@@ -38,6 +38,7 @@ subcommands = [
     'qmk.cli.chibios.confmigrate',
     'qmk.cli.clean',
     'qmk.cli.compile',
+    'qmk.cli.decode_task_profile',
     'qmk.cli.docs',
     'qmk.cli.doctor',
     'qmk.cli.find',
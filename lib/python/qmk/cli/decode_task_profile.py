@@ -0,0 +1,58 @@
+"""Decode a task profiler dump from a keyboard.
+"""
+import json
+
+from argcomplete.completers import FilesCompleter
+from milc import cli
+
+import qmk.path
+from qmk.task_profiler import decode_dump, parse_console_log, percentile, ticks_to_us
+
+
+def _format_ticks(profile, ticks):
+    us = ticks_to_us(profile, ticks)
+    if us is None:
+        return str(ticks)
+
+    return f'{us:.1f}'
+
+
+@cli.argument('-c', '--console', arg_only=True, action='store_true', help='Input is a console log containing task_profiler: lines rather than a binary dump')
+@cli.argument('-j', '--json', arg_only=True, action='store_true', help='Output the decoded profile as JSON')
+@cli.argument('-a', '--all', arg_only=True, action='store_true', help='Also show tasks without samples')
+@cli.argument('filename', type=qmk.path.normpath, arg_only=True, completer=FilesCompleter(), help='Binary dump or console log')
+@cli.subcommand('Decodes a task profiler dump into a latency table.')
+def decode_task_profile(cli):
+    """Decode a task profiler dump.
+
+    The dump is either the raw bytes read over raw HID, or a console log captured with `qmk console` while the keyboard printed its profile.
+    """
+    if not cli.args.filename.exists():
+        cli.log.error('File not found: %s', cli.args.filename)
+        return False
+
+    try:
+        if cli.args.console:
+            data = parse_console_log(cli.args.filename.read_text(encoding='utf-8', errors='replace'))
+        else:
+            data = cli.args.filename.read_bytes()
+        profile = decode_dump(data)
+    except ValueError as e:
+        cli.log.error('%s', e)
+        return False
+
+    if cli.args.json:
+        print(json.dumps(profile, indent=4))
+        return True
+
+    unit = 'us' if profile['timestamp_frequency'] else 'ticks'
+    cli.echo('{fg_cyan}%-22s %10s %10s %10s %10s', 'task', 'samples', f'p50 {unit}', f'p99 {unit}', f'max {unit}')
+    for slot in profile['slots']:
+        if not slot['samples'] and not cli.args.all:
+            continue
+
+        p50 = _format_ticks(profile, percentile(profile, slot, 0.5))
+        p99 = _format_ticks(profile, percentile(profile, slot, 0.99))
+        cli.echo('%-22s %10d %10s %10s %10s', slot['name'], slot['samples'], p50, p99, _format_ticks(profile, slot['max']))
+
+    return True
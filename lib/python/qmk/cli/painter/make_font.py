@@ -33,6 +33,7 @@ def painter_make_font_image(cli):
 @cli.argument('-u', '--unicode-glyphs', default='', help='Also generate the specified unicode glyphs.')
 @cli.argument('-f', '--format', required=True, help='Output format, valid types: %s' % (', '.join(valid_formats.keys())))
 @cli.argument('-r', '--no-rle', arg_only=True, action='store_true', help='Disable the use of RLE to minimise converted image size.')
+@cli.argument('-l', '--no-lz', arg_only=True, action='store_true', help='Disable the use of LZ compression to minimise converted image size.')
 @cli.argument('-w', '--raw', arg_only=True, action='store_true', help='Writes out the QFF file as raw data instead of c/h combo.')
 @cli.subcommand('Converts an input font image to something QMK firmware understands')
 def painter_convert_font_image(cli):
@@ -53,7 +54,7 @@ def painter_convert_font_image(cli):
 
     # Render out the data
     out_data = BytesIO()
-    font.save_to_qff(format, (False if cli.args.no_rle else True), out_data)
+    font.save_to_qff(format, (False if cli.args.no_rle else True), out_data, use_lz=(False if cli.args.no_lz else True))
     out_bytes = out_data.getvalue()
 
     if cli.args.raw:
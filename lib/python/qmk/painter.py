@@ -328,3 +328,68 @@ def compress_bytes_qmk_rle(bytearray):
                 temp = []
                 repeat = False
     return output
+
+
+# LZ back-references reach at most this many bytes into the previous output, see qp_draw.h
+QMK_LZ_WINDOW_SIZE = 256
+QMK_LZ_MIN_MATCH = 3
+QMK_LZ_MAX_MATCH = 127 + QMK_LZ_MIN_MATCH
+QMK_LZ_MAX_LITERALS = 128
+QMK_LZ_MAX_CANDIDATES = 64
+
+
+def compress_bytes_qmk_lz(bytearray):
+    output = []
+    literals = []
+    # Positions of each 3-byte sequence seen so far, most recent last
+    chains = {}
+
+    def flush_literals():
+        if len(literals) > 0:
+            output.append(len(literals) - 1)
+            output.extend(literals)
+            literals.clear()
+
+    def remember(pos):
+        if pos + QMK_LZ_MIN_MATCH <= len(bytearray):
+            chain = chains.setdefault(tuple(bytearray[pos:pos + QMK_LZ_MIN_MATCH]), [])
+            chain.append(pos)
+            if len(chain) > QMK_LZ_MAX_CANDIDATES:
+                del chain[0]
+
+    n = 0
+    while n < len(bytearray):
+        # Find the longest match within the window, preferring the closest one
+        best_length = 0
+        best_distance = 0
+        limit = min(QMK_LZ_MAX_MATCH, len(bytearray) - n)
+        if limit >= QMK_LZ_MIN_MATCH:
+            for candidate in reversed(chains.get(tuple(bytearray[n:n + QMK_LZ_MIN_MATCH]), [])):
+                distance = n - candidate
+                if distance > QMK_LZ_WINDOW_SIZE:
+                    break
+                length = QMK_LZ_MIN_MATCH
+                while length < limit and bytearray[candidate + length] == bytearray[n + length]:
+                    length += 1
+                if length > best_length:
+                    best_length = length
+                    best_distance = distance
+                    if length == limit:
+                        break
+
+        if best_length >= QMK_LZ_MIN_MATCH:
+            flush_literals()
+            output.append(128 + best_length - QMK_LZ_MIN_MATCH)
+            output.append(best_distance - 1)
+            for pos in range(n, n + best_length):
+                remember(pos)
+            n += best_length
+        else:
+            literals.append(bytearray[n])
+            if len(literals) == QMK_LZ_MAX_LITERALS:
+                flush_literals()
+            remember(n)
+            n += 1
+
+    flush_literals()
+    return output
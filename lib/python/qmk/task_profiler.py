@@ -0,0 +1,130 @@
+"""Functions for decoding task profiler dumps, see quantum/task_profiler.h.
+"""
+import re
+import struct
+
+MAGIC = b'TP'
+HEADER = struct.Struct('<2sBBBBI')
+CONSOLE_LINE = re.compile(r'task_profiler:([0-9A-Fa-f]{4}):([0-9A-Fa-f]*)')
+
+# Must match the order of task_profiler_slot_t
+SLOT_NAMES = [
+    'main_loop',
+    'key_latency',
+    'matrix_task',
+    'quantum_task',
+    'split_watchdog_task',
+    'rgblight_task',
+    'led_matrix_task',
+    'rgb_matrix_task',
+    'backlight_task',
+    'encoder_task',
+    'pointing_device_task',
+    'oled_task',
+    'st7565_task',
+    'mousekey_task',
+    'ps2_mouse_task',
+    'midi_task',
+    'joystick_task',
+    'bluetooth_task',
+    'haptic_task',
+    'led_task',
+    'os_detection_task',
+    'qp_internal_task',
+    'deferred_exec_task',
+    'housekeeping_task',
+]
+
+
+def parse_console_log(text):
+    """Reassembles a binary dump from `task_profiler:` lines of console output.
+
+    Only the last complete dump in the log is returned.
+    """
+    dump = bytearray()
+    last = None
+
+    for line in text.splitlines():
+        if 'task_profiler:end' in line:
+            last = bytes(dump)
+            dump = bytearray()
+            continue
+
+        match = CONSOLE_LINE.search(line)
+        if match:
+            offset = int(match.group(1), 16)
+            if offset == 0:
+                dump = bytearray()
+            if offset == len(dump):
+                dump += bytes.fromhex(match.group(2))
+
+    if last is None:
+        raise ValueError('No complete task profiler dump found in console log')
+
+    return last
+
+
+def decode_dump(data):
+    """Decodes a binary task profiler dump into a dictionary.
+    """
+    if len(data) < HEADER.size:
+        raise ValueError('Task profiler dump is truncated')
+
+    magic, version, slot_count, bucket_count, bucket_shift, frequency = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        raise ValueError('Not a task profiler dump')
+    if version != 1:
+        raise ValueError(f'Unsupported task profiler dump version {version}')
+
+    slot = struct.Struct(f'<II{bucket_count}H')
+    if len(data) < HEADER.size + slot_count * slot.size:
+        raise ValueError('Task profiler dump is truncated')
+
+    slots = []
+    for index in range(slot_count):
+        samples, maximum, *buckets = slot.unpack_from(data, HEADER.size + index * slot.size)
+        slots.append({
+            'name': SLOT_NAMES[index] if index < len(SLOT_NAMES) else f'slot_{index}',
+            'samples': samples,
+            'max': maximum,
+            'buckets': buckets,
+        })
+
+    return {
+        'version': version,
+        'bucket_shift': bucket_shift,
+        'timestamp_frequency': frequency,
+        'slots': slots,
+    }
+
+
+def bucket_upper_bound(profile, bucket):
+    """Returns the exclusive upper bound of a histogram bucket, in ticks.
+    """
+    if bucket == len(profile['slots'][0]['buckets']) - 1:
+        return None
+
+    return 1 << (profile['bucket_shift'] + bucket)
+
+
+def ticks_to_us(profile, ticks):
+    """Converts timestamp ticks to microseconds, or returns None when the frequency is unknown.
+    """
+    if not profile['timestamp_frequency']:
+        return None
+
+    return ticks * 1000000 / profile['timestamp_frequency']
+
+
+def percentile(profile, slot, fraction):
+    """Returns the upper bound, in ticks, of the bucket containing the given percentile.
+    """
+    target = slot['samples'] * fraction
+    seen = 0
+    for bucket, count in enumerate(slot['buckets']):
+        seen += count
+        if count and seen >= target:
+            bound = bucket_upper_bound(profile, bucket)
+            return slot['max'] if bound is None else min(bound, slot['max'])
+
+    return slot['max']
@@ -0,0 +1,46 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+
+#include "oled_driver.h"
+
+#ifdef OLED_ASYNC_FLUSH
+
+static binary_semaphore_t oled_flush_request;
+static volatile bool      oled_flush_busy    = false;
+static bool               oled_flush_started = false;
+
+/**
+ * @brief This thread sends the batched OLED changes, leaving the main loop free
+ * to carry on scanning while the transport waits on the bus.
+ */
+static THD_WORKING_AREA(waOledFlushThread, OLED_ASYNC_FLUSH_STACK_SIZE);
+static THD_FUNCTION(OledFlushThread, arg) {
+    (void)arg;
+    chRegSetThreadName("oled_flush");
+
+    while (true) {
+        chBSemWait(&oled_flush_request);
+        oled_flush_batch();
+        oled_flush_busy = false;
+    }
+}
+
+void oled_flush_async(void) {
+    if (!oled_flush_started) {
+        chBSemObjectInit(&oled_flush_request, true);
+        /* Higher priority than the main loop, so the transfer starts straight away and the main loop only runs while it waits. */
+        chThdCreateStatic(waOledFlushThread, sizeof(waOledFlushThread), NORMALPRIO + 1, OledFlushThread, NULL);
+        oled_flush_started = true;
+    }
+
+    oled_flush_busy = true;
+    chBSemSignal(&oled_flush_request);
+}
+
+bool oled_flush_async_busy(void) {
+    return oled_flush_busy;
+}
+
+#endif
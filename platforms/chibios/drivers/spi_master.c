@@ -310,6 +310,34 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+/* Starts sending the data using DMA, and returns straight away. The data must stay unchanged until the transfer has
+ * finished, and nothing else may use the bus until then -- see spi_transmit_wait(). */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+bool spi_transmit_busy(void) {
+    osalSysLock();
+    bool busy = SPI_DRIVER.state == SPI_ACTIVE;
+    osalSysUnlock();
+    return busy;
+}
+
+void spi_transmit_wait(void) {
+#if SPI_USE_WAIT
+    // Sleeps until the DMA completion interrupt wakes the thread, rather than spinning
+    osalSysLock();
+    if (SPI_DRIVER.state == SPI_ACTIVE) {
+        _spi_wait_s(&SPI_DRIVER);
+    }
+    osalSysUnlock();
+#else
+    while (spi_transmit_busy()) {
+    }
+#endif
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
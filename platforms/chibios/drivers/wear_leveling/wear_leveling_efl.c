@@ -120,6 +120,46 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#if defined(WEAR_LEVELING_DUAL_BANK)
+// Each bank needs to start on a sector boundary, so that erasing one leaves the other alone
+_Static_assert((WEAR_LEVELING_BANK_SIZE) % (WEAR_LEVELING_EFL_SECTOR_SIZE) == 0, "Wear-leveling bank size must be a multiple of WEAR_LEVELING_EFL_SECTOR_SIZE");
+
+bool backing_store_erase_bank(uint8_t bank, uint32_t *offset) {
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    // Find the sector starting at the offset into the bank, and erase just that one
+    const flash_offset_t target = base_offset + (bank * (WEAR_LEVELING_BANK_SIZE)) + *offset;
+    for (int i = 0; i < sector_count; ++i) {
+        if (flashGetSectorOffset(flash, first_sector + i) != target) {
+            continue;
+        }
+
+        // Kick off the sector erase
+        bool          ret    = true;
+        flash_error_t status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        // Wait for the erase to complete
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        *offset += flashGetSectorSize(flash, first_sector + i);
+        bs_dprintf("Backing store bank %d sector erase took %ldms to complete\n", (int)bank, ((long)(timer_read32() - start)));
+        return ret;
+    }
+
+    // The sectors are not the size WEAR_LEVELING_EFL_SECTOR_SIZE claims
+    bs_dprintf("Backing store bank %d has no sector at offset %ld\n", (int)bank, (long)*offset);
+    return false;
+}
+#endif // defined(WEAR_LEVELING_DUAL_BANK)
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -43,12 +43,25 @@
 #    endif
 #endif
 
+// Dual-bank needs to know the sector size at build time, so that each bank can be checked to start on a sector boundary
+#if defined(WEAR_LEVELING_DUAL_BANK) && !defined(WEAR_LEVELING_EFL_SECTOR_SIZE)
+#    if defined(STM32_FLASH_SECTOR_SIZE) // from some family's stm32_registry.h file
+#        define WEAR_LEVELING_EFL_SECTOR_SIZE (STM32_FLASH_SECTOR_SIZE)
+#    else
+#        error "Could not automatically determine WEAR_LEVELING_EFL_SECTOR_SIZE, which WEAR_LEVELING_DUAL_BANK needs -- define it as the size of the sectors used for wear-leveling"
+#    endif
+#endif
+
 // 2kB backing space allocated
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE 2048
 #endif // WEAR_LEVELING_BACKING_SIZE
 
-// 1kB logical EEPROM
+// 1kB logical EEPROM, or half that for dual-bank
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
-#    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    ifdef WEAR_LEVELING_DUAL_BANK
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 4)
+#    else
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
 #endif // WEAR_LEVELING_LOGICAL_SIZE
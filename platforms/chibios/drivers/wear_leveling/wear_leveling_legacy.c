@@ -7,6 +7,10 @@
 #include "wear_leveling_internal.h"
 #include "legacy_flash_ops.h"
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+#    error The legacy wear-leveling driver does not support WEAR_LEVELING_DUAL_BANK, use the embedded_flash driver instead.
+#endif
+
 bool backing_store_init(void) {
     bs_dprintf("Init\n");
     return true;
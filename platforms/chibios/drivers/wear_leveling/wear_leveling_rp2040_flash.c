@@ -187,6 +187,25 @@ bool backing_store_erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+// Each bank needs to start on a sector boundary, so that erasing one leaves the other alone
+_Static_assert((WEAR_LEVELING_BANK_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Bank size must be a multiple of FLASH_SECTOR_SIZE");
+
+bool backing_store_erase_bank(uint8_t bank, uint32_t *offset) {
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + bank * (WEAR_LEVELING_BANK_SIZE) + *offset, (FLASH_SECTOR_SIZE));
+    restore_interrupts(interrupts);
+    *offset += (FLASH_SECTOR_SIZE);
+
+    bs_dprintf("Backing store bank %d sector erase took %ldms to complete\n", (int)bank, ((long)(timer_read32() - start)));
+    return true;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -16,9 +16,13 @@
 #    define WEAR_LEVELING_BACKING_SIZE 8192
 #endif // WEAR_LEVELING_BACKING_SIZE
 
-// 32kB logical EEPROM
+// 32kB logical EEPROM, or half that for dual-bank
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
-#    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    ifdef WEAR_LEVELING_DUAL_BANK
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 4)
+#    else
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
 #endif // WEAR_LEVELING_LOGICAL_SIZE
 
 // Define how much flash space we have (defaults to lib/pico-sdk/src/boards/include/boards/***)
@@ -0,0 +1,39 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+
+#include "key_event_queue.h"
+
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+
+#    ifndef KEY_EVENT_QUEUE_SCAN_INTERVAL_US
+#        define KEY_EVENT_QUEUE_SCAN_INTERVAL_US 500
+#    endif
+
+#    ifndef KEY_EVENT_QUEUE_SCAN_THREAD_PRIORITY
+#        define KEY_EVENT_QUEUE_SCAN_THREAD_PRIORITY (NORMALPRIO + 8)
+#    endif
+
+/**
+ * @brief This thread scans the matrix at a fixed rate, queueing timestamped
+ * events for the main loop, so a slow action never delays the next scan.
+ */
+static THD_WORKING_AREA(waKeyEventScanThread, 512);
+static THD_FUNCTION(KeyEventScanThread, arg) {
+    (void)arg;
+    chRegSetThreadName("matrix_scan");
+
+    systime_t previous = chVTGetSystemTime();
+    while (true) {
+        key_event_queue_scan();
+        // Sleeps until the next scan is due, or not at all if the scan overran it
+        previous = chThdSleepUntilWindowed(previous, chTimeAddX(previous, TIME_US2I(KEY_EVENT_QUEUE_SCAN_INTERVAL_US)));
+    }
+}
+
+void key_event_queue_scan_thread_init(void) {
+    chThdCreateStatic(waKeyEventScanThread, sizeof(waKeyEventScanThread), KEY_EVENT_QUEUE_SCAN_THREAD_PRIORITY, KeyEventScanThread, NULL);
+}
+
+#endif
@@ -0,0 +1,52 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+
+#include "tickless_idle.h"
+
+#if !PAL_USE_CALLBACKS
+#    error "Tickless idle requires PAL_USE_CALLBACKS to be enabled in halconf.h"
+#endif
+
+static thread_reference_t idle_thread = NULL;
+static volatile bool      woken       = false;
+
+void tickless_idle_wake_from_isr(void) {
+    osalSysLockFromISR();
+    woken = true;
+    osalThreadResumeI(&idle_thread, MSG_OK);
+    osalSysUnlockFromISR();
+}
+
+static void tickless_idle_pin_cb(void *arg) {
+    (void)arg;
+    tickless_idle_wake_from_isr();
+}
+
+bool tickless_idle_pins_conflict(pin_t a, pin_t b) {
+    // Line events are shared between pins on some MCUs -- on STM32 each EXTI line serves the same pad number on every port
+    return a != b && palGetLineEventRef(a) == palGetLineEventRef(b);
+}
+
+void tickless_idle_wake_on_pin(pin_t pin, bool enable) {
+    if (enable) {
+        palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallback(pin, tickless_idle_pin_cb, NULL);
+    } else {
+        palDisableLineEvent(pin);
+    }
+}
+
+bool tickless_idle_sleep(uint32_t timeout_ms) {
+    // The main thread is suspended, leaving the idle thread to WFI until either the timeout, a pin change or USB wakes it
+    osalSysLock();
+    if (!woken) {
+        osalThreadSuspendTimeoutS(&idle_thread, TIME_MS2I(timeout_ms));
+    }
+    bool was_woken = woken;
+    woken          = false;
+    osalSysUnlock();
+    return was_woken;
+}
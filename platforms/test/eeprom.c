@@ -15,17 +15,36 @@
  */
 
 #include "eeprom.h"
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
 
-static uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint8_t  buffer[TOTAL_EEPROM_BYTE_COUNT];
+static uint32_t write_count = 0;
+
+/* The number of bytes written to the buffer, as opposed to held back by a write-behind cache. */
+uint32_t eeprom_test_write_count(void) {
+    return write_count;
+}
 
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uintptr_t offset = (uintptr_t)addr;
-    return buffer[offset];
+    uint8_t   value  = buffer[offset];
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_apply(&value, addr, 1);
+#endif
+    return value;
 }
 
 void eeprom_write_byte(uint8_t *addr, uint8_t value) {
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    if (eeprom_write_behind_defer(&value, addr, 1)) {
+        return;
+    }
+#endif
     uintptr_t offset = (uintptr_t)addr;
     buffer[offset]   = value;
+    write_count++;
 }
 
 uint16_t eeprom_read_word(const uint16_t *addr) {
@@ -0,0 +1,42 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+static uint32_t pending_wake  = UINT32_MAX;
+static uint32_t sleep_count   = 0;
+static uint32_t last_sleep_ms = 0;
+
+/* Schedules a simulated pin change, the given number of milliseconds into the next sleep. */
+void tickless_idle_simulate_wake(uint32_t after_ms) {
+    pending_wake = after_ms;
+}
+
+void tickless_idle_wake_from_isr(void) {
+    pending_wake = 0;
+}
+
+uint32_t tickless_idle_sleep_count(void) {
+    return sleep_count;
+}
+
+uint32_t tickless_idle_last_sleep(void) {
+    return last_sleep_ms;
+}
+
+bool tickless_idle_sleep(uint32_t timeout_ms) {
+    sleep_count++;
+    last_sleep_ms = timeout_ms;
+
+    // Time passes on the simulated clock instead
+    if (pending_wake < timeout_ms) {
+        advance_time(pending_wake);
+        pending_wake = UINT32_MAX;
+        return true;
+    }
+    advance_time(timeout_ms);
+    return false;
+}
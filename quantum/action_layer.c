@@ -39,6 +39,9 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_state = state;
     default_layer_debug();
     ac_dprintf("\n");
+#if defined(RESOLVED_LAYERS_CACHE) && !defined(NO_ACTION_LAYER)
+    update_resolved_layers_cache();
+#endif
 #if defined(STRICT_LAYER_RELEASE)
     clear_keyboard_but_mods(); // To avoid stuck keys
 #elif defined(SEMI_STRICT_LAYER_RELEASE)
@@ -119,6 +122,9 @@ void layer_state_set(layer_state_t state) {
     layer_state = state;
     layer_debug();
     ac_dprintf("\n");
+#    ifdef RESOLVED_LAYERS_CACHE
+    update_resolved_layers_cache();
+#    endif
 #    if defined(STRICT_LAYER_RELEASE)
     clear_keyboard_but_mods(); // To avoid stuck keys
 #    elif defined(SEMI_STRICT_LAYER_RELEASE)
@@ -316,16 +322,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer switch scan layers
  *
- * Gets the layer based on key info
+ * Finds the topmost non-transparent layer for the key within the supplied layer mask
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_scan_layers(keypos_t key, layer_state_t layers) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +342,86 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if defined(RESOLVED_LAYERS_CACHE) && !defined(NO_ACTION_LAYER)
+/** \brief resolved layers cache
+ *
+ * Topmost non-transparent layer of every matrix position, valid for resolved_layers_cache_state
+ */
+static uint8_t       resolved_layers_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t resolved_layers_cache_state = 0;
+static bool          resolved_layers_cache_valid = false;
+
+/** \brief refresh resolved layers cache
+ *
+ * Brings the cache up to date with the supplied layer mask. Only positions whose
+ * resolved layer can be affected by the changed layers are scanned again.
+ */
+static void refresh_resolved_layers_cache(layer_state_t layers) {
+    const layer_state_t changed = layers ^ resolved_layers_cache_state;
+    if (resolved_layers_cache_valid && !changed) {
+        return;
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            // Layers below the resolved one are shadowed by it, changes there don't matter
+            if (resolved_layers_cache_valid && !(changed >> resolved_layers_cache[row][col])) {
+                continue;
+            }
+            resolved_layers_cache[row][col] = layer_switch_scan_layers((keypos_t){.row = row, .col = col}, layers);
+        }
+    }
+
+    resolved_layers_cache_state = layers;
+    resolved_layers_cache_valid = true;
+}
+
+/** \brief update resolved layers cache
+ *
+ * Updates the cache after a layer state change, the initial build is deferred to the first lookup
+ */
+void update_resolved_layers_cache(void) {
+    if (resolved_layers_cache_valid) {
+        refresh_resolved_layers_cache(layer_state | default_layer_state);
+    }
+}
+
+/** \brief update resolved layers cache key
+ *
+ * Resolves a single position again, e.g. after its keycode was changed on any layer
+ */
+void update_resolved_layers_cache_key(keypos_t key) {
+    if (resolved_layers_cache_valid && key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        resolved_layers_cache[key.row][key.col] = layer_switch_scan_layers(key, resolved_layers_cache_state);
+    }
+}
+
+/** \brief invalidate resolved layers cache
+ *
+ * Forces a full rebuild on the next lookup, needed whenever the keymap itself changes
+ */
+void invalidate_resolved_layers_cache(void) {
+    resolved_layers_cache_valid = false;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef RESOLVED_LAYERS_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        refresh_resolved_layers_cache(layers);
+        return resolved_layers_cache[key.row][key.col];
+    }
+#    endif
+    return layer_switch_scan_layers(key, layers);
 #else
     return get_highest_layer(default_layer_state);
 #endif
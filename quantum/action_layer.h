@@ -163,6 +163,13 @@ uint8_t read_source_layers_cache(keypos_t key);
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
+/* resolved layers cache */
+#if defined(RESOLVED_LAYERS_CACHE) && !defined(NO_ACTION_LAYER)
+void update_resolved_layers_cache(void);
+void update_resolved_layers_cache_key(keypos_t key);
+void invalidate_resolved_layers_cache(void);
+#endif
+
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
@@ -6,6 +6,7 @@
 #include "action_tapping.h"
 #include "keycode.h"
 #include "timer.h"
+#include "util.h"
 
 #ifndef NO_ACTION_TAPPING
 
@@ -112,6 +113,36 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+#    ifdef TICKLESS_IDLE_ENABLE
+/** \brief Action Tapping Idle Delay
+ *
+ * Shortens an idle sleep so that it ends when the pending tapping key resolves.
+ */
+uint32_t action_tapping_idle_delay(uint32_t delay_ms) {
+    if (waiting_buffer_head != waiting_buffer_tail) {
+        return 0;
+    }
+    if (IS_NOEVENT(tapping_key.event)) {
+        return delay_ms;
+    }
+
+    uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+    if (elapsed >= term) {
+        return 0;
+    }
+    return MIN(delay_ms, (uint32_t)(term - elapsed));
+}
+#    endif
+
+/** \brief Action Tapping Waiting Count
+ *
+ * Number of events held back in the waiting buffer until the tapping key resolves.
+ */
+uint8_t action_tapping_waiting_count(void) {
+    return (waiting_buffer_head + WAITING_BUFFER_SIZE - waiting_buffer_tail) % WAITING_BUFFER_SIZE;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
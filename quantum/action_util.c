@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_layer.h"
 #include "timer.h"
 #include "keycode_config.h"
+#include "util.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -253,6 +254,38 @@ bool is_oneshot_enabled(void) {
     return keymap_config.oneshot_enable;
 }
 
+#    if defined(TICKLESS_IDLE_ENABLE) && (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+static uint32_t oneshot_idle_until(uint32_t delay_ms, uint16_t start) {
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), start);
+    if (elapsed >= ONESHOT_TIMEOUT) {
+        return 0;
+    }
+    return MIN(delay_ms, (uint32_t)(ONESHOT_TIMEOUT - elapsed));
+}
+
+/** \brief Oneshot Idle Delay
+ *
+ * Shortens an idle sleep so that it ends when the oneshot mods, layer or swap hands time out.
+ */
+uint32_t oneshot_idle_delay(uint32_t delay_ms) {
+    if (!keymap_config.oneshot_enable) {
+        return delay_ms;
+    }
+    if (oneshot_mods) {
+        delay_ms = oneshot_idle_until(delay_ms, oneshot_time);
+    }
+    if ((get_oneshot_layer_state() & ONESHOT_OTHER_KEY_PRESSED) && !(get_oneshot_layer_state() & ONESHOT_TOGGLED)) {
+        delay_ms = oneshot_idle_until(delay_ms, oneshot_layer_time);
+    }
+#        ifdef SWAP_HANDS_ENABLE
+    if (swap_hands_oneshot == SHO_ACTIVE) {
+        delay_ms = oneshot_idle_until(delay_ms, oneshot_swaphands_time);
+    }
+#        endif
+    return delay_ms;
+}
+#    endif
+
 #endif
 
 static uint8_t get_mods_for_report(void) {
@@ -40,8 +40,28 @@ void caps_word_task(void) {
 void caps_word_reset_idle_timer(void) {
     idle_timer = timer_read() + CAPS_WORD_IDLE_TIMEOUT;
 }
+
+#    ifdef TICKLESS_IDLE_ENABLE
+uint32_t caps_word_idle_delay(uint32_t delay_ms) {
+    if (!caps_word_active) {
+        return delay_ms;
+    }
+    uint16_t now = timer_read();
+    if (timer_expired(now, idle_timer)) {
+        return 0;
+    }
+    uint16_t remaining = TIMER_DIFF_16(idle_timer, now);
+    return remaining < delay_ms ? remaining : delay_ms;
+}
+#    endif // TICKLESS_IDLE_ENABLE
 #else
 void caps_word_task(void) {}
+
+#    ifdef TICKLESS_IDLE_ENABLE
+uint32_t caps_word_idle_delay(uint32_t delay_ms) {
+    return delay_ms;
+}
+#    endif // TICKLESS_IDLE_ENABLE
 #endif // CAPS_WORD_IDLE_TIMEOUT > 0
 
 void caps_word_on(void) {
@@ -28,6 +28,11 @@ void caps_word_task(void);
 void caps_word_reset_idle_timer(void);
 #endif
 
+#ifdef TICKLESS_IDLE_ENABLE
+/** @brief Shortens a tickless idle sleep so that it ends at the Caps Word idle timeout. */
+uint32_t caps_word_idle_delay(uint32_t delay_ms);
+#endif
+
 /** @brief Activates Caps Word. */
 void caps_word_on(void);
 
@@ -109,6 +109,38 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+// Component order is v, p, q, t, indexed by the hue region
+static const uint8_t hsv_region_map[7][3] PROGMEM = {
+    {0, 3, 1}, {2, 0, 1}, {1, 0, 3}, {1, 2, 0}, {3, 1, 0}, {0, 1, 2}, {0, 3, 1},
+};
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t h = hsv[i].h;
+        uint8_t s = hsv[i].s;
+        uint8_t v = hsv[i].v;
+#ifdef USE_CIE1931_CURVE
+        v = pgm_read_byte(&CIE1931_CURVE[v]);
+#endif
+
+        // Same math as hsv_to_rgb_impl(), but h * 6 / 255 is done with shifts, and
+        // the region switch is replaced by picking the components from a table
+        uint16_t x         = h * 6;
+        uint8_t  region    = (x + 1 + (x >> 8)) >> 8;
+        uint8_t  remainder = (h * 2 - region * 85) * 3;
+        uint8_t  values[4];
+
+        values[0] = v;
+        values[1] = s ? (v * (255 - s)) >> 8 : v;
+        values[2] = s ? (v * (255 - ((s * remainder) >> 8))) >> 8 : v;
+        values[3] = s ? (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8 : v;
+
+        rgb[i].r = values[pgm_read_byte(&hsv_region_map[region][0])];
+        rgb[i].g = values[pgm_read_byte(&hsv_region_map[region][1])];
+        rgb[i].b = values[pgm_read_byte(&hsv_region_map[region][2])];
+    }
+}
+
 #ifdef RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led) {
     // Determine lowest value in all three colors, put that into
@@ -111,6 +111,9 @@ typedef struct PACKED HSV {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+
+/* Converts count colors at once, giving the same results as hsv_to_rgb() */
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
 #ifdef RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led);
 #endif
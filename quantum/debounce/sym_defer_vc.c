@@ -0,0 +1,171 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Symmetric per-key algorithm using vertical counters. Behaves exactly like
+sym_defer_pk: when no state changes have occured on a key for DEBOUNCE
+milliseconds, its state is pushed.
+
+Rather than one counter per key, the counters are stored as bit planes: for
+each row, plane n holds bit n of the counter of every key in that row. A whole
+row of counters is then started, counted down and checked for expiry with a
+handful of bitwise operations per counter bit, however many columns there are.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_COUNTER_BITS 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_COUNTER_BITS 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_COUNTER_BITS 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_COUNTER_BITS 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_COUNTER_BITS 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_COUNTER_BITS 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_COUNTER_BITS 7
+#    else
+#        define DEBOUNCE_COUNTER_BITS 8
+#    endif
+
+// [row][bit] bit planes of the milliseconds left until each key is debounced
+static matrix_row_t counter_planes[MATRIX_ROWS][DEBOUNCE_COUNTER_BITS];
+// [row] keys with a counter running
+static matrix_row_t counting[MATRIX_ROWS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+void debounce_init(uint8_t num_rows) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        counting[row] = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counter_planes[row][bit] = 0;
+        }
+    }
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        if (!counting[row]) {
+            continue;
+        }
+
+        // Subtract elapsed_time from every counter in the row at once, one bit plane at a time, rippling the borrow
+        // through the planes. A counter has expired if the subtraction went below zero or left it at zero.
+        matrix_row_t *planes    = counter_planes[row];
+        matrix_row_t  borrow    = 0;
+        matrix_row_t  remaining = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            matrix_row_t plane = planes[bit];
+            if (elapsed_time & (1 << bit)) {
+                planes[bit] = ~(plane ^ borrow);
+                borrow      = ~plane | borrow;
+            } else {
+                planes[bit] = plane ^ borrow;
+                borrow      = ~plane & borrow;
+            }
+            remaining |= planes[bit];
+        }
+        // Any bits of elapsed_time above the counter width can only borrow further
+        if (elapsed_time >> DEBOUNCE_COUNTER_BITS) {
+            borrow = ~(matrix_row_t)0;
+        }
+
+        matrix_row_t expired = counting[row] & (borrow | ~remaining);
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+            counting[row] &= ~expired;
+        }
+
+        // Keys that aren't counting wrapped around, so clear them again
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            planes[bit] &= counting[row];
+        }
+
+        if (counting[row]) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta    = raw[row] ^ cooked[row];
+        matrix_row_t starting = delta & ~counting[row];
+
+        // Keys back at their debounced state stop counting, and keys newly changed start at DEBOUNCE
+        matrix_row_t *planes = counter_planes[row];
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            planes[bit] &= delta & ~starting;
+            if (DEBOUNCE & (1 << bit)) {
+                planes[bit] |= starting;
+            }
+        }
+        counting[row] = delta;
+
+        if (delta) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -52,3 +52,14 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+# Behaves exactly like sym_defer_pk, so runs the same tests
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp
+
+debounce_sym_defer_vc_wide_DEFS := -DMATRIX_ROWS=20 -DMATRIX_COLS=32 -DDEBOUNCE=200
+debounce_sym_defer_vc_wide_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_vc_wide_tests.cpp
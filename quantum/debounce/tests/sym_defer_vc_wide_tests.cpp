@@ -0,0 +1,60 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+// Built with a 20x32 matrix and DEBOUNCE of 200, so that the counters span every bit plane and whole 32-bit rows
+
+TEST_F(DebounceTest, OneKeyShortLastColumn) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{19, 31, DOWN}}, {}},
+
+        {200, {}, {{19, 31, DOWN}}},
+        {201, {{19, 31, UP}}, {}},
+
+        {401, {}, {{19, 31, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, OneKeyBouncing) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{3, 17, DOWN}}, {}},
+        {100, {{3, 17, UP}}, {}},
+        {150, {{3, 17, DOWN}}, {}},
+        {350, {}, {{3, 17, DOWN}}}, /* 200ms after DOWN at time 150 */
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, WholeRowStaggered) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{5, 0, DOWN}, {5, 15, DOWN}}, {}},
+        {7, {{5, 16, DOWN}, {5, 31, DOWN}}, {}},
+
+        {200, {}, {{5, 0, DOWN}, {5, 15, DOWN}}},
+        {207, {}, {{5, 16, DOWN}, {5, 31, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, OneKeyDelayedScan) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {}},
+
+        /* Processing is late, by less than the debounce time */
+        {150, {}, {}},
+        {200, {}, {{0, 1, DOWN}}},
+        /* Processing is late, by more than the largest counter */
+        {201, {{0, 1, UP}}, {}},
+        {600, {}, {{0, 1, UP}}},
+    });
+    time_jumps_ = true;
+    runEvents();
+}
@@ -12,31 +12,128 @@
 //------------------------------------
 // Helpers
 //
+// Each table doubles as a binary min-heap ordered by trigger time. The heap is a permutation of the table's slots: the first
+// heap_count positions hold the queued executors, the remaining positions hold free slots (and any executor whose callback is
+// currently running). Positions and slots are stored XOR'ed with their own index, so a zeroed table is the identity
+// permutation and needs no initialisation.
+//
+// Tokens encode the slot they refer to, so lookups don't need to search the table.
+//
 
-static deferred_token current_token = 0;
+static uint8_t token_generation = 0;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
-    }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+static inline bool table_is_valid(deferred_executor_t *table, size_t table_count) {
+    return table && table_count > 0 && table_count <= UINT8_MAX;
+}
+
+static inline uint8_t heap_count(deferred_executor_t *table) {
+    return table[0].heap_count;
+}
+
+static inline uint8_t heap_position(deferred_executor_t *table, uint8_t slot) {
+    return table[slot].heap_index ^ slot;
+}
+
+static inline uint8_t heap_entry(deferred_executor_t *table, uint8_t position) {
+    return table[position].heap_slot ^ position;
+}
+
+static inline void heap_place(deferred_executor_t *table, uint8_t position, uint8_t slot) {
+    table[position].heap_slot = slot ^ position;
+    table[slot].heap_index    = position ^ slot;
+}
+
+static inline bool triggers_before(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    return ((int32_t)TIMER_DIFF_32(table[a].trigger_time, table[b].trigger_time)) < 0;
+}
+
+static void heap_sift_up(deferred_executor_t *table, uint8_t position) {
+    uint8_t slot = heap_entry(table, position);
+    while (position > 0) {
+        uint8_t parent      = (position - 1) / 2;
+        uint8_t parent_slot = heap_entry(table, parent);
+        if (!triggers_before(table, slot, parent_slot)) {
+            break;
         }
+        heap_place(table, position, parent_slot);
+        position = parent;
     }
-    return true;
+    heap_place(table, position, slot);
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void heap_sift_down(deferred_executor_t *table, uint8_t position) {
+    uint8_t slot  = heap_entry(table, position);
+    uint8_t count = heap_count(table);
+    while (true) {
+        uint16_t child = position * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && triggers_before(table, heap_entry(table, child + 1), heap_entry(table, child))) {
+            ++child;
         }
+        uint8_t child_slot = heap_entry(table, child);
+        if (!triggers_before(table, child_slot, slot)) {
+            break;
+        }
+        heap_place(table, position, child_slot);
+        position = child;
+    }
+    heap_place(table, position, slot);
+}
+
+static inline bool heap_contains(deferred_executor_t *table, uint8_t slot) {
+    return heap_position(table, slot) < heap_count(table);
+}
+
+static void heap_swap(deferred_executor_t *table, uint8_t position_a, uint8_t position_b) {
+    uint8_t slot_a = heap_entry(table, position_a);
+    uint8_t slot_b = heap_entry(table, position_b);
+    heap_place(table, position_a, slot_b);
+    heap_place(table, position_b, slot_a);
+}
+
+static void heap_update(deferred_executor_t *table, uint8_t slot) {
+    heap_sift_up(table, heap_position(table, slot));
+    heap_sift_down(table, heap_position(table, slot));
+}
+
+static void heap_push(deferred_executor_t *table, uint8_t slot) {
+    uint8_t position = table[0].heap_count++;
+    heap_swap(table, heap_position(table, slot), position);
+    heap_sift_up(table, position);
+}
+
+static void heap_remove(deferred_executor_t *table, uint8_t slot) {
+    uint8_t position = heap_position(table, slot);
+    uint8_t last     = --table[0].heap_count;
+    if (position != last) {
+        // Move the last entry into the gap, and restore the ordering around it
+        uint8_t moved = heap_entry(table, last);
+        heap_swap(table, position, last);
+        heap_update(table, moved);
+    }
+}
+
+static inline deferred_executor_t *find_entry(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return NULL;
     }
-    return current_token;
+    uint8_t slot = (token - 1) % table_count;
+    return table[slot].token == token ? &table[slot] : NULL;
+}
+
+static inline deferred_token allocate_token(size_t table_count, uint8_t slot) {
+    // Cycle through the token values mapping to this slot, so stale tokens are unlikely to match a new executor
+    uint8_t generations = UINT8_MAX / table_count;
+    return 1 + slot + table_count * (token_generation++ % generations);
+}
+
+static inline void clear_entry(deferred_executor_t *entry) {
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
 }
 
 //------------------------------------
@@ -45,26 +142,22 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table_is_valid(table, table_count) || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
+    // Find an unused slot and claim it -- everything past the heap is free, bar any executor currently running
+    for (uint16_t position = heap_count(table); position < table_count; ++position) {
+        uint8_t              slot  = heap_entry(table, position);
+        deferred_executor_t *entry = &table[slot];
         if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
             // Set up the executor table entry
-            entry->token        = current_token;
+            entry->token        = allocate_token(table_count, slot);
             entry->trigger_time = timer_read32() + delay_ms;
             entry->callback     = callback;
             entry->cb_arg       = cb_arg;
-            return current_token;
+            heap_push(table, slot);
+            return entry->token;
         }
     }
 
@@ -74,88 +167,118 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table_is_valid(table, table_count) || delay_ms == 0) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay -- if the callback is currently running, it gets requeued once it returns
+    entry->trigger_time = timer_read32() + delay_ms;
+    uint8_t slot        = entry - table;
+    if (heap_contains(table, slot)) {
+        heap_update(table, slot);
+    }
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
     // Ignore request if the table/token are not valid
-    if (!table || table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+    if (!table_is_valid(table, table_count)) {
         return false;
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    uint8_t slot = entry - table;
+    if (heap_contains(table, slot)) {
+        heap_remove(table, slot);
+    }
+    clear_entry(entry);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+    if (!table_is_valid(table, table_count)) {
+        return;
+    }
+
     uint32_t now = timer_read32();
 
     // Throttle only once per millisecond
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
+        // Run through the executors in trigger order. Like the table scan this replaces, each executor runs at most once
+        // per pass -- one that is still due after repeating is held out of the heap until the pass is over, so a
+        // repeating executor that has fallen behind catches up one run per pass rather than starving everything else.
+        uint8_t held = 0;
+        while (heap_count(table) > 0) {
+            uint8_t              slot       = heap_entry(table, 0);
+            deferred_executor_t *entry      = &table[slot];
             deferred_token       curr_token = entry->token;
 
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+            // Check if we're supposed to execute this entry -- if not, nothing later in the heap is either
+            if (((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                break;
+            }
 
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
+            // Take it out of the heap while the callback runs, so it can freely defer, extend or cancel
+            heap_remove(table, slot);
 
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
+            // Invoke the callback and work work out if we should be requeued
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
+            if (entry->token != curr_token) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                entry->trigger_time += delay_ms;
+                if (((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                    heap_push(table, slot);
                 } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+                    ++held;
                 }
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                clear_entry(entry);
+            }
+        }
+
+        // Requeue the held executors -- with no callback running, they are the only live entries outside the heap
+        for (uint16_t slot = 0; held > 0 && slot < table_count; ++slot) {
+            if (table[slot].token != INVALID_DEFERRED_TOKEN && !heap_contains(table, slot)) {
+                heap_push(table, slot);
+                --held;
             }
         }
     }
 }
 
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table_is_valid(table, table_count) || heap_count(table) == 0) {
+        return false;
+    }
+    *trigger_time = table[heap_entry(table, 0)].trigger_time;
+    return true;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -175,3 +298,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_next_trigger(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_trigger(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
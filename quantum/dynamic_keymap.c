@@ -17,10 +17,13 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "timer.h"
+#include "util.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -36,6 +39,14 @@
 #    define NUM_ENCODERS 0
 #endif
 
+// Recorded dynamic macros are saved at the end of the macro EEPROM
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+#    include "process_dynamic_macro.h"
+#    define DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE (DYNAMIC_MACRO_EEPROM_SIZE)
+#else
+#    define DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE 0
+#endif
+
 #ifndef DYNAMIC_KEYMAP_LAYER_COUNT
 #    define DYNAMIC_KEYMAP_LAYER_COUNT 4
 #endif
@@ -89,18 +100,109 @@
 // The keyboard should override DYNAMIC_KEYMAP_LAYER_COUNT to reduce it,
 // or DYNAMIC_KEYMAP_EEPROM_MAX_ADDR to increase it, *only if* the microcontroller has
 // more than the default.
-_Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) >= 100, "Dynamic keymaps are configured to use more EEPROM than is available.");
+_Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) - (DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE) >= 100, "Dynamic keymaps are configured to use more EEPROM than is available.");
 
 // Dynamic macros are stored after the keymaps and use what is available
-// up to and including DYNAMIC_KEYMAP_EEPROM_MAX_ADDR.
+// up to and including DYNAMIC_KEYMAP_EEPROM_MAX_ADDR, less any space
+// for recorded macros.
 #ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE
-#    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
+#    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1 - DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE)
 #endif
 
+// Recorded macros are stored after the dynamic macros
+#define DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_ADDR (DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE)
+_Static_assert((DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_ADDR) + (DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE) <= (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) + 1, "Recorded dynamic macros do not fit in the available EEPROM.");
+
 #ifndef DYNAMIC_KEYMAP_MACRO_DELAY
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#ifdef ENCODER_MAP_ENABLE
+#    define DYNAMIC_KEYMAP_ENCODER_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2)
+#else
+#    define DYNAMIC_KEYMAP_ENCODER_SIZE 0
+#endif
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Time without further edits before the mirror is written back to EEPROM
+#    ifndef DYNAMIC_KEYMAP_RAM_MIRROR_WRITE_DELAY
+#        define DYNAMIC_KEYMAP_RAM_MIRROR_WRITE_DELAY 1000
+#    endif
+#    define DYNAMIC_KEYMAP_RAM_MIRROR_SIZE (DYNAMIC_KEYMAP_KEYMAP_SIZE + DYNAMIC_KEYMAP_ENCODER_SIZE)
+#    pragma message "Dynamic keymap RAM mirror uses " STR(DYNAMIC_KEYMAP_RAM_MIRROR_SIZE) " bytes of RAM"
+
+// Same big-endian layout as EEPROM, keymaps first, followed by encoders
+static uint8_t  dynamic_keymap_mirror[DYNAMIC_KEYMAP_RAM_MIRROR_SIZE];
+static bool     dynamic_keymap_mirror_loaded = false;
+static uint16_t dynamic_keymap_mirror_dirty_start;
+static uint16_t dynamic_keymap_mirror_dirty_end = 0;
+static uint16_t dynamic_keymap_mirror_last_write;
+
+static void *dynamic_keymap_mirror_to_eeprom_address(uint16_t offset) {
+    if (offset < DYNAMIC_KEYMAP_KEYMAP_SIZE) {
+        return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset;
+    }
+    return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (offset - DYNAMIC_KEYMAP_KEYMAP_SIZE);
+}
+
+// Grows the pending range so that overlapping and adjacent edits result in a single write
+static void dynamic_keymap_mirror_update_byte(uint16_t offset, uint8_t value) {
+    if (dynamic_keymap_mirror[offset] == value) {
+        return;
+    }
+    dynamic_keymap_mirror[offset] = value;
+    if (dynamic_keymap_mirror_dirty_end == 0) {
+        dynamic_keymap_mirror_dirty_start = offset;
+        dynamic_keymap_mirror_dirty_end   = offset + 1;
+    } else {
+        dynamic_keymap_mirror_dirty_start = MIN(dynamic_keymap_mirror_dirty_start, offset);
+        dynamic_keymap_mirror_dirty_end   = MAX(dynamic_keymap_mirror_dirty_end, offset + 1);
+    }
+    dynamic_keymap_mirror_last_write = timer_read();
+}
+
+static void dynamic_keymap_mirror_write_range(uint16_t start, uint16_t end) {
+    if (start < DYNAMIC_KEYMAP_KEYMAP_SIZE) {
+        uint16_t keymap_end = MIN(end, DYNAMIC_KEYMAP_KEYMAP_SIZE);
+        eeprom_update_block(&dynamic_keymap_mirror[start], dynamic_keymap_mirror_to_eeprom_address(start), keymap_end - start);
+        start = keymap_end;
+    }
+    // The encoder map is not guaranteed to directly follow the keymap in EEPROM
+    if (start < end) {
+        eeprom_update_block(&dynamic_keymap_mirror[start], dynamic_keymap_mirror_to_eeprom_address(start), end - start);
+    }
+}
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    eeprom_read_block(dynamic_keymap_mirror, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_KEYMAP_SIZE);
+#    ifdef ENCODER_MAP_ENABLE
+    eeprom_read_block(&dynamic_keymap_mirror[DYNAMIC_KEYMAP_KEYMAP_SIZE], (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, DYNAMIC_KEYMAP_ENCODER_SIZE);
+#    endif
+    dynamic_keymap_mirror_dirty_end = 0;
+    dynamic_keymap_mirror_loaded    = true;
+#endif
+}
+
+void dynamic_keymap_flush(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (dynamic_keymap_mirror_dirty_end != 0) {
+        dynamic_keymap_mirror_write_range(dynamic_keymap_mirror_dirty_start, dynamic_keymap_mirror_dirty_end);
+        dynamic_keymap_mirror_dirty_end = 0;
+    }
+#endif
+}
+
+void dynamic_keymap_task(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (dynamic_keymap_mirror_dirty_end != 0 && timer_elapsed(dynamic_keymap_mirror_last_write) >= DYNAMIC_KEYMAP_RAM_MIRROR_WRITE_DELAY) {
+        dynamic_keymap_flush();
+    }
+#endif
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -112,6 +214,12 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (dynamic_keymap_mirror_loaded) {
+        uint16_t offset = (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+        return (dynamic_keymap_mirror[offset] << 8) | dynamic_keymap_mirror[offset + 1];
+    }
+#endif
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
@@ -122,9 +230,21 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
-    // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (dynamic_keymap_mirror_loaded) {
+        uint16_t offset = (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+        dynamic_keymap_mirror_update_byte(offset, (uint8_t)(keycode >> 8));
+        dynamic_keymap_mirror_update_byte(offset + 1, (uint8_t)(keycode & 0xFF));
+    } else
+#endif
+    {
+        // Big endian, so we can read/write EEPROM directly from host if we want
+        eeprom_update_byte(address, (uint8_t)(keycode >> 8));
+        eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    }
+#if defined(RESOLVED_LAYERS_CACHE) && !defined(NO_ACTION_LAYER)
+    update_resolved_layers_cache_key((keypos_t){.row = row, .col = column});
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -135,6 +255,12 @@ void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (dynamic_keymap_mirror_loaded) {
+        uint16_t offset = DYNAMIC_KEYMAP_KEYMAP_SIZE + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2) + (clockwise ? 0 : 2);
+        return (dynamic_keymap_mirror[offset] << 8) | dynamic_keymap_mirror[offset + 1];
+    }
+#    endif
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
     keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
@@ -144,6 +270,14 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (dynamic_keymap_mirror_loaded) {
+        uint16_t offset = DYNAMIC_KEYMAP_KEYMAP_SIZE + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2) + (clockwise ? 0 : 2);
+        dynamic_keymap_mirror_update_byte(offset, (uint8_t)(keycode >> 8));
+        dynamic_keymap_mirror_update_byte(offset + 1, (uint8_t)(keycode & 0xFF));
+        return;
+    }
+#    endif
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
@@ -165,15 +299,29 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // The EEPROM may have been erased underneath the mirror (e.g. by eeconfig_init_quantum()),
+    // so compare the whole mirror against it rather than only the bytes that changed in RAM
+    if (dynamic_keymap_mirror_loaded) {
+        dynamic_keymap_mirror_dirty_start = 0;
+        dynamic_keymap_mirror_dirty_end   = DYNAMIC_KEYMAP_RAM_MIRROR_SIZE;
+    }
+#endif
+    // A reset is followed by other EEPROM bookkeeping (e.g. the VIA magic), so don't defer it
+    dynamic_keymap_flush();
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_KEYMAP_SIZE;
+    void *   source                     = ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset;
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+            *target = dynamic_keymap_mirror_loaded ? dynamic_keymap_mirror[offset + i] : eeprom_read_byte(source);
+#else
             *target = eeprom_read_byte(source);
+#endif
         } else {
             *target = 0x00;
         }
@@ -183,16 +331,26 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_KEYMAP_SIZE;
+    void *   target                     = ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset;
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+            if (dynamic_keymap_mirror_loaded) {
+                dynamic_keymap_mirror_update_byte(offset + i, *source);
+            } else
+#endif
+            {
+                eeprom_update_byte(target, *source);
+            }
         }
         source++;
         target++;
     }
+#if defined(RESOLVED_LAYERS_CACHE) && !defined(NO_ACTION_LAYER)
+    invalidate_resolved_layers_cache();
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,7 +378,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset;
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -234,7 +392,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset;
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -252,8 +410,46 @@ void dynamic_keymap_macro_reset(void) {
         eeprom_update_byte(p, 0);
         ++p;
     }
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+    p   = (void *)(DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_ADDR);
+    end = ((void *)DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_ADDR) + DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE;
+    while (p != end) {
+        eeprom_update_byte(p, 0);
+        ++p;
+    }
+    // Drop the recorded macros from RAM as well
+    dynamic_macro_init();
+#endif
 }
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+void dynamic_keymap_recorded_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    void *   source = ((void *)DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_ADDR) + offset;
+    uint8_t *target = data;
+    for (uint16_t i = 0; i < size; i++) {
+        if (offset + i < DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE) {
+            *target = eeprom_read_byte(source);
+        } else {
+            *target = 0x00;
+        }
+        source++;
+        target++;
+    }
+}
+
+void dynamic_keymap_recorded_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    void *   target = ((void *)DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_ADDR) + offset;
+    uint8_t *source = data;
+    for (uint16_t i = 0; i < size; i++) {
+        if (offset + i < DYNAMIC_KEYMAP_RECORDED_MACRO_EEPROM_SIZE) {
+            eeprom_update_byte(target, *source);
+        }
+        source++;
+        target++;
+    }
+}
+#endif
+
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
@@ -284,6 +480,10 @@ void dynamic_keymap_macro_send(uint8_t id) {
         ++p;
     }
 
+#ifdef SEND_STRING_ASYNC
+    // Typed out straight from EEPROM, a character at a time
+    send_string_with_delay_eeprom((const char *)p, DYNAMIC_KEYMAP_MACRO_DELAY);
+#else
     // Send the macro string by making a temporary string.
     char data[8] = {0};
     // We already checked there was a null at the end of
@@ -337,4 +537,5 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
+#endif
 }
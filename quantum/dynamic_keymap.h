@@ -18,6 +18,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+void     dynamic_keymap_init(void);
+void     dynamic_keymap_task(void);
+void     dynamic_keymap_flush(void);
 uint8_t  dynamic_keymap_get_layer_count(void);
 void *   dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column);
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
@@ -68,3 +71,8 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+// These get/set the recorded dynamic macros saved with DYNAMIC_MACRO_EEPROM_STORAGE,
+// which are stored after the dynamic keymap macro buffer.
+void dynamic_keymap_recorded_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
+void dynamic_keymap_recorded_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
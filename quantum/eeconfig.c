@@ -13,6 +13,10 @@
 #    include "haptic.h"
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+#    include "dynamic_keymap.h"
+#endif
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -83,6 +87,11 @@ void eeconfig_init_quantum(void) {
     eeconfig_init_via();
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE) && !defined(VIA_ENABLE)
+    // Clear the recorded dynamic macros, in EEPROM and in RAM -- VIA already does so above
+    dynamic_keymap_macro_reset();
+#endif
+
     eeconfig_init_kb();
 }
 
@@ -0,0 +1,61 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_event_queue.h"
+
+/*
+ * A single producer, single consumer ring buffer. The matrix scan only ever writes the head and action processing only
+ * ever writes the tail, so the two can run in different threads, or the scan in an interrupt, without locking. The
+ * release and acquire ordering makes sure an event is written before the head moves past it, and read before the tail
+ * does.
+ */
+static keyevent_t       queue[KEY_EVENT_QUEUE_SIZE];
+static volatile uint8_t queue_head = 0;
+static volatile uint8_t queue_tail = 0;
+static uint32_t         overflows  = 0;
+static uint8_t          high_water = 0;
+
+static inline uint8_t next_index(uint8_t index) {
+    return (uint8_t)((index + 1) % KEY_EVENT_QUEUE_SIZE);
+}
+
+bool key_event_queue_push(keyevent_t event) {
+    uint8_t head = queue_head;
+    uint8_t next = next_index(head);
+    if (next == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) {
+        overflows++;
+        return false;
+    }
+
+    queue[head] = event;
+    __atomic_store_n(&queue_head, next, __ATOMIC_RELEASE);
+
+    uint8_t count = key_event_queue_count();
+    if (count > high_water) {
+        high_water = count;
+    }
+    return true;
+}
+
+bool key_event_queue_pop(keyevent_t *event) {
+    uint8_t tail = queue_tail;
+    if (tail == __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    *event = queue[tail];
+    __atomic_store_n(&queue_tail, next_index(tail), __ATOMIC_RELEASE);
+    return true;
+}
+
+uint8_t key_event_queue_count(void) {
+    return (uint8_t)((queue_head + KEY_EVENT_QUEUE_SIZE - queue_tail) % KEY_EVENT_QUEUE_SIZE);
+}
+
+uint32_t key_event_queue_overflows(void) {
+    return overflows;
+}
+
+uint8_t key_event_queue_high_water(void) {
+    return high_water;
+}
@@ -0,0 +1,73 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+/**
+ * @def The number of slots in the queue between matrix scanning and action processing. One slot is always kept free,
+ * so this holds one less event.
+ */
+#ifndef KEY_EVENT_QUEUE_SIZE
+#    define KEY_EVENT_QUEUE_SIZE 32
+#endif
+
+#if KEY_EVENT_QUEUE_SIZE < 2 || KEY_EVENT_QUEUE_SIZE > 256
+#    error "KEY_EVENT_QUEUE_SIZE must be between 2 and 256"
+#endif
+
+/**
+ * Adds an event to the queue. Only the matrix scan may push events.
+ *
+ * @return false if the queue is full, in which case the event is not added and the overflow counter is incremented
+ */
+bool key_event_queue_push(keyevent_t event);
+
+/**
+ * Takes the oldest event from the queue. Only action processing may pop events.
+ *
+ * @param event[out] the event, if there was one
+ * @return false if the queue is empty
+ */
+bool key_event_queue_pop(keyevent_t *event);
+
+/**
+ * The number of events waiting to be processed.
+ */
+uint8_t key_event_queue_count(void);
+
+/**
+ * The number of events that could not be queued because the queue was full. The matrix scan retries these on the next
+ * scan, so they are delayed rather than lost, unless the key changes back in the meantime.
+ */
+uint32_t key_event_queue_overflows(void);
+
+/**
+ * The most events that have been waiting in the queue at once.
+ */
+uint8_t key_event_queue_high_water(void);
+
+/**
+ * Scans the matrix, and queues an event, stamped with the time of the scan, for each key that changed.
+ *
+ * @return true if the matrix changed
+ */
+bool key_event_queue_scan(void);
+
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+#    ifndef PROTOCOL_CHIBIOS
+#        error "KEY_EVENT_QUEUE_SCAN_THREAD is only supported on ChibiOS"
+#    endif
+#    if defined(SPLIT_KEYBOARD) || defined(TICKLESS_IDLE_ENABLE)
+#        error "KEY_EVENT_QUEUE_SCAN_THREAD is not supported on split keyboards or with tickless idle"
+#    endif
+
+/**
+ * Starts scanning the matrix from a separate, higher priority thread, leaving the main loop to process the queued
+ * events. Provided by the platform.
+ */
+void key_event_queue_scan_thread_init(void);
+#endif
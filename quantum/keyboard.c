@@ -32,6 +32,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "task_profiler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -83,6 +84,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+#    include "send_string.h"
+#endif
+#ifdef KEY_EVENT_QUEUE_ENABLE
+#    include "key_event_queue.h"
+#endif
 #ifdef POINTING_DEVICE_ENABLE
 #    include "pointing_device.h"
 #endif
@@ -104,12 +111,24 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DUAL_BANK)
+#    include "wear_leveling.h"
+#endif
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -408,9 +427,15 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_init();
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
 #endif
@@ -435,6 +460,9 @@ void keyboard_init(void) {
 #if defined(UNICODE_COMMON_ENABLE)
     unicode_input_mode_init();
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_init();
+#endif
 #if defined(CRC_ENABLE)
     crc_init();
 #endif
@@ -489,6 +517,9 @@ void keyboard_init(void) {
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
+#ifdef KEY_EVENT_QUEUE_SCAN_THREAD
+    key_event_queue_scan_thread_init();
+#endif
 
     keyboard_post_init_kb(); /* Always keep this last */
 }
@@ -520,6 +551,88 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#ifdef KEY_EVENT_QUEUE_ENABLE
+static matrix_row_t matrix_previous[MATRIX_ROWS];
+
+bool key_event_queue_scan(void) {
+    if (!matrix_can_read()) {
+        return false;
+    }
+
+    matrix_scan();
+    bool matrix_changed = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
+        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
+    }
+
+    matrix_scan_perf_task();
+
+    if (!matrix_changed) {
+        return false;
+    }
+
+    // Every change found in this scan gets the same timestamp, however long it is until they are processed
+    const uint16_t scan_time = timer_read();
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t       current_row = matrix_get_row(row);
+        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+
+        if (!row_changes || has_ghost_in_row(row, current_row)) {
+            continue;
+        }
+
+        matrix_row_t col_mask = 1;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
+            if (row_changes & col_mask) {
+                keyevent_t event = MAKE_KEYEVENT(row, col, current_row & col_mask);
+                event.time       = scan_time;
+                if (!key_event_queue_push(event)) {
+                    // Leave the change unseen, so that the next scan picks it up again
+                    current_row ^= col_mask;
+                }
+            }
+        }
+
+        matrix_previous[row] = current_row;
+    }
+
+    return matrix_changed;
+}
+
+/**
+ * @brief This task processes the key presses queued by the matrix scan, scanning
+ * the matrix first unless that is done elsewhere.
+ *
+ * @return true Matrix did change
+ * @return false Matrix didn't change
+ */
+static bool matrix_task(void) {
+#    ifndef KEY_EVENT_QUEUE_SCAN_THREAD
+    key_event_queue_scan();
+#    endif
+
+    const bool process_keypress = should_process_keypress();
+    bool       matrix_changed   = false;
+    keyevent_t event;
+    while (key_event_queue_pop(&event)) {
+        if (process_keypress) {
+            action_exec(event);
+        }
+
+        switch_events(event.key.row, event.key.col, event.pressed);
+        matrix_changed = true;
+    }
+
+    if (!matrix_changed) {
+        generate_tick_event();
+    } else if (debug_config.matrix) {
+        matrix_print();
+    }
+
+    return matrix_changed;
+}
+#else
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -581,6 +694,7 @@ static bool matrix_task(void) {
 
     return matrix_changed;
 }
+#endif
 
 /** \brief Tasks previously located in matrix_scan_quantum
  *
@@ -655,55 +769,70 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
+
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+    send_string_task();
+#endif
+
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+
+    bool matrix_changed;
+    TASK_PROFILE(TASK_PROFILER_MATRIX_TASK, matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    TASK_PROFILE(TASK_PROFILER_QUANTUM_TASK, quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+    TASK_PROFILE(TASK_PROFILER_SPLIT_WATCHDOG_TASK, split_watchdog_task());
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    TASK_PROFILE(TASK_PROFILER_RGBLIGHT_TASK, rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    TASK_PROFILE(TASK_PROFILER_LED_MATRIX_TASK, led_matrix_task());
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    TASK_PROFILE(TASK_PROFILER_RGB_MATRIX_TASK, rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    TASK_PROFILE(TASK_PROFILER_BACKLIGHT_TASK, backlight_task());
 #    endif
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_task()) {
+    bool encoder_changed;
+    TASK_PROFILE(TASK_PROFILER_ENCODER_TASK, encoder_changed = encoder_task());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed;
+    TASK_PROFILE(TASK_PROFILER_POINTING_DEVICE_TASK, pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    TASK_PROFILE(TASK_PROFILER_OLED_TASK, oled_task());
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -711,7 +840,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
-    st7565_task();
+    TASK_PROFILE(TASK_PROFILER_ST7565_TASK, st7565_task());
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -720,32 +849,48 @@ void keyboard_task(void) {
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
+    TASK_PROFILE(TASK_PROFILER_MOUSEKEY_TASK, mousekey_task());
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
+    TASK_PROFILE(TASK_PROFILER_PS2_MOUSE_TASK, ps2_mouse_task());
 #endif
 
 #ifdef MIDI_ENABLE
-    midi_task();
+    TASK_PROFILE(TASK_PROFILER_MIDI_TASK, midi_task());
 #endif
 
 #ifdef JOYSTICK_ENABLE
-    joystick_task();
+    TASK_PROFILE(TASK_PROFILER_JOYSTICK_TASK, joystick_task());
 #endif
 
 #ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+    TASK_PROFILE(TASK_PROFILER_BLUETOOTH_TASK, bluetooth_task());
 #endif
 
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    TASK_PROFILE(TASK_PROFILER_HAPTIC_TASK, haptic_task());
 #endif
 
-    led_task();
+    TASK_PROFILE(TASK_PROFILER_LED_TASK, led_task());
 
 #ifdef OS_DETECTION_ENABLE
-    os_detection_task();
+    TASK_PROFILE(TASK_PROFILER_OS_DETECTION_TASK, os_detection_task());
+#endif
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_task();
+#endif
+
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DUAL_BANK)
+    wear_leveling_task();
+#endif
+
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_task();
 #endif
 }
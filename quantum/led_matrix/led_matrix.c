@@ -24,6 +24,9 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -315,9 +318,7 @@ static void led_task_flush(uint8_t effect) {
     led_task_state = SYNCING;
 }
 
-void led_matrix_task(void) {
-    led_task_timers();
-
+static uint8_t led_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -326,7 +327,13 @@ void led_matrix_task(void) {
 #endif // LED_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+    return suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+}
+
+void led_matrix_task(void) {
+    led_task_timers();
+
+    uint8_t effect = led_task_effect();
 
     switch (led_task_state) {
         case STARTING:
@@ -350,6 +357,29 @@ void led_matrix_task(void) {
     }
 }
 
+#ifdef TICKLESS_IDLE_ENABLE
+uint32_t led_matrix_idle_delay(uint32_t delay_ms) {
+    // finish the frame in progress first
+    if (led_task_state != SYNCING) {
+        return 0;
+    }
+
+    uint8_t effect = led_task_effect();
+#    if LED_MATRIX_TIMEOUT > 0
+    // wake up to turn the LEDs off
+    if (effect) {
+        delay_ms = tickless_idle_until(delay_ms, last_input_activity_time() + LED_MATRIX_TIMEOUT + 1);
+    }
+#    endif // LED_MATRIX_TIMEOUT > 0
+
+    // LED_MATRIX_NONE only needs flushing once
+    if (effect == LED_MATRIX_NONE && led_last_effect == LED_MATRIX_NONE && led_last_enable == led_matrix_eeconfig.enable) {
+        return delay_ms;
+    }
+    return tickless_idle_until(delay_ms, g_led_timer + LED_MATRIX_LED_FLUSH_LIMIT);
+}
+#endif // TICKLESS_IDLE_ENABLE
+
 void led_matrix_indicators(void) {
     led_matrix_indicators_kb();
 }
@@ -128,6 +128,9 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void led_matrix_task(void);
 
+// Shortens an idle sleep so that it ends when the next frame is due
+uint32_t led_matrix_idle_delay(uint32_t delay_ms);
+
 // This runs after another backlight effect and replaces
 // values already set
 void led_matrix_indicators(void);
@@ -22,6 +22,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "debounce.h"
 #include "atomic_util.h"
 
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -347,3 +351,91 @@ uint8_t matrix_scan(void) {
 #endif
     return (uint8_t)changed;
 }
+
+#if defined(TICKLESS_IDLE_ENABLE) && (defined(DIRECT_PINS) || (defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)))
+#    if defined(DIRECT_PINS)
+#        define MATRIX_IDLE_INPUT_COUNT (ROWS_PER_HAND * MATRIX_COLS)
+#    elif (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_IDLE_INPUT_COUNT (MATRIX_COLS)
+#    elif (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_IDLE_INPUT_COUNT (ROWS_PER_HAND)
+#    endif
+
+/* Returns the input pin that a key press changes while idle, by index. */
+static pin_t matrix_idle_input(uint16_t index) {
+#    if defined(DIRECT_PINS)
+    return direct_pins[index / MATRIX_COLS][index % MATRIX_COLS];
+#    elif (DIODE_DIRECTION == COL2ROW)
+    return col_pins[index];
+#    elif (DIODE_DIRECTION == ROW2COL)
+    return row_pins[index];
+#    endif
+}
+
+/* Checks that every input pin can raise its own pin change, as some MCUs share them between pins. */
+static bool matrix_idle_supported(void) {
+    static int8_t supported = -1;
+    if (supported < 0) {
+        supported = 1;
+        for (uint16_t i = 0; i < MATRIX_IDLE_INPUT_COUNT && supported; i++) {
+            for (uint16_t j = i + 1; j < MATRIX_IDLE_INPUT_COUNT; j++) {
+                pin_t a = matrix_idle_input(i), b = matrix_idle_input(j);
+                if (a != NO_PIN && b != NO_PIN && tickless_idle_pins_conflict(a, b)) {
+                    // Falls back to polling, rather than missing presses on one of the pins
+                    supported = 0;
+                    break;
+                }
+            }
+        }
+    }
+    return supported;
+}
+
+/* Arms or disarms every input pin, returning whether any of them reads as pressed. */
+static bool matrix_idle_inputs(bool enable) {
+    bool pressed = false;
+    for (uint16_t i = 0; i < MATRIX_IDLE_INPUT_COUNT; i++) {
+        pin_t pin = matrix_idle_input(i);
+        if (pin != NO_PIN) {
+            tickless_idle_wake_on_pin(pin, enable);
+            pressed |= readMatrixPin(pin) == 0;
+        }
+    }
+    return pressed;
+}
+
+bool matrix_idle_arm(void) {
+    if (!matrix_idle_supported()) {
+        return false;
+    }
+
+    // Select every row (or col) at once, so any key press changes an input
+#    if !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+#    elif !defined(DIRECT_PINS) && (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    matrix_output_select_delay();
+#    endif
+
+    // Inputs are armed before they are checked, so a press in between still wakes the keyboard
+    if (matrix_idle_inputs(true)) {
+        matrix_idle_disarm();
+        return false;
+    }
+    return true;
+}
+
+void matrix_idle_disarm(void) {
+    matrix_idle_inputs(false);
+#    if !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW)
+    unselect_rows();
+#    elif !defined(DIRECT_PINS) && (DIODE_DIRECTION == ROW2COL)
+    unselect_cols();
+#    endif
+}
+#endif // TICKLESS_IDLE_ENABLE
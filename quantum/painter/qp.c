@@ -130,6 +130,22 @@ bool qp_flush(painter_device_t device) {
     return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_wait
+
+bool qp_wait(painter_device_t device) {
+    qp_dprintf("qp_wait: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_wait: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    qp_comms_wait(device);
+    qp_dprintf("qp_wait: ok\n");
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_get_*
 
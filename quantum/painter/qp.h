@@ -88,6 +88,14 @@
 #    define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_SPI_ASYNC
+/**
+ * @def This controls whether pixel data is sent to SPI displays in the background, using DMA on ChibiOS. The pixel
+ *      data buffer is doubled up, so that the next block can be prepared while the previous one is being sent.
+ */
+#    define QUANTUM_PAINTER_SPI_ASYNC FALSE
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
@@ -175,6 +183,18 @@ bool qp_clear(painter_device_t device);
  */
 bool qp_flush(painter_device_t device);
 
+/**
+ * Waits for any pixel data still being sent to the display in the background to finish.
+ *
+ * @note Only has an effect when QUANTUM_PAINTER_SPI_ASYNC is enabled. Drawing operations already wait for their own
+ *       transfers before returning, so this isn't needed before using other devices on the display's SPI bus.
+ *
+ * @param device[in] the handle of the device to control
+ * @return true if the device is valid
+ * @return false if the device is invalid
+ */
+bool qp_wait(painter_device_t device);
+
 /**
  * Retrieves the width of the display.
  *
@@ -46,6 +46,18 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+void qp_comms_wait(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_wait: fail (validation_ok == false)\n");
+        return;
+    }
+
+    if (driver->comms_vtable->comms_wait) {
+        driver->comms_vtable->comms_wait(device);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
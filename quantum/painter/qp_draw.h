@@ -10,7 +10,18 @@
 // Quantum Painter utility functions
 
 // Global variable used for native pixel data streaming.
+#if QUANTUM_PAINTER_SPI_ASYNC
+extern uint8_t *qp_internal_global_pixdata_buffer;
+#else
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
+// Switches the global pixdata buffer over to its other half once a full buffer has been sent, so that the next block can
+// be prepared while the previous one is still being transmitted. No-op unless double-buffered.
+void qp_internal_pixdata_buffer_swap(void);
+
+// Check if the supplied data lives in the global pixdata buffer
+bool qp_internal_pixdata_buffer_contains(const void* data);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -63,6 +74,10 @@ enum qp_internal_rle_mode_t {
     NON_REPEATING_RUN,
 };
 
+// LZ back-references reach at most this many bytes into the previous output, and copy at least QP_LZ_MIN_MATCH bytes
+#define QP_LZ_WINDOW_SIZE 256
+#define QP_LZ_MIN_MATCH 3
+
 typedef struct qp_internal_byte_input_state_t {
     painter_device_t device;
     qp_stream_t*     src_stream;
@@ -73,6 +88,12 @@ typedef struct qp_internal_byte_input_state_t {
             enum qp_internal_rle_mode_t mode;
             uint8_t                     remain; // number of bytes remaining in the current mode
         } rle;
+        // LZ-specific
+        struct {
+            enum qp_internal_rle_mode_t mode;   // REPEATING_RUN while copying a back-reference, NON_REPEATING_RUN while copying literals
+            uint8_t                     remain; // number of bytes remaining in the current mode
+            uint8_t                     offset; // distance back into the window of the current back-reference, minus one
+        } lz;
     };
 } qp_internal_byte_input_state_t;
 
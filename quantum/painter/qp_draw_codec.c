@@ -126,6 +126,55 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
+// The most recent LZ output, shared by all decodes as only one asset is ever being drawn at a time
+_Static_assert(QP_LZ_WINDOW_SIZE == 256, "LZ window position relies on uint8_t wraparound");
+static uint8_t qp_internal_lz_window[QP_LZ_WINDOW_SIZE];
+static uint8_t qp_internal_lz_window_pos;
+
+static inline int16_t qp_drawimage_byte_lz_decoder(void* cb_arg) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
+
+    // Work out if we're parsing a marker byte, and what follows it
+    if (state->lz.mode == MARKER_BYTE) {
+        int16_t marker = qp_stream_get(state->src_stream);
+        if (marker == STREAM_EOF) {
+            return STREAM_EOF;
+        }
+        if (marker >= 128) {
+            int16_t offset = qp_stream_get(state->src_stream);
+            if (offset == STREAM_EOF) {
+                return STREAM_EOF;
+            }
+            state->lz.mode   = REPEATING_RUN; // back-reference
+            state->lz.remain = (marker - 128) + QP_LZ_MIN_MATCH;
+            state->lz.offset = offset;
+        } else {
+            state->lz.mode   = NON_REPEATING_RUN; // literals
+            state->lz.remain = marker + 1;
+        }
+    }
+
+    // Work out which byte we're returning
+    if (state->lz.mode == NON_REPEATING_RUN) {
+        state->curr = qp_stream_get(state->src_stream);
+        if (state->curr == STREAM_EOF) {
+            return STREAM_EOF;
+        }
+    } else {
+        state->curr = qp_internal_lz_window[(uint8_t)(qp_internal_lz_window_pos - state->lz.offset - 1)];
+    }
+
+    // Remember it for later back-references
+    qp_internal_lz_window[qp_internal_lz_window_pos++] = state->curr;
+
+    // Swap back to querying the marker byte once this run is done
+    if (--state->lz.remain == 0) {
+        state->lz.mode = MARKER_BYTE;
+    }
+
+    return state->curr;
+}
+
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
     qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
     painter_driver_t*                 driver = (painter_driver_t*)state->device;
@@ -139,6 +188,7 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
             return false;
         }
+        qp_internal_pixdata_buffer_swap();
         state->pixel_write_pos = 0;
     }
 
@@ -159,6 +209,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
         if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
+        qp_internal_pixdata_buffer_swap();
         state->byte_write_pos = 0;
     }
 
@@ -171,6 +222,9 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
 
     bool ret = false;
 
+    // The buffer may still be on its way to the display from an earlier draw
+    qp_comms_wait(device);
+
     // Non-native pixel format
     if (bpp <= 8) {
         // Set up the output state
@@ -212,6 +266,10 @@ qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte
             input_state->rle.mode   = MARKER_BYTE;
             input_state->rle.remain = 0;
             return qp_drawimage_byte_rle_decoder;
+        case IMAGE_COMPRESSED_LZ:
+            input_state->lz.mode   = MARKER_BYTE;
+            input_state->lz.remain = 0;
+            return qp_drawimage_byte_lz_decoder;
         default:
             return NULL;
     }
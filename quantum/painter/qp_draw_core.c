@@ -20,7 +20,13 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //
 
 // Buffer used for transmitting native pixel data to the downstream device.
+#if QUANTUM_PAINTER_SPI_ASYNC
+// Doubled up, so that one half can be filled while the other is being sent in the background.
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t                                       *qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -41,6 +47,22 @@ uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+void qp_internal_pixdata_buffer_swap(void) {
+#if QUANTUM_PAINTER_SPI_ASYNC
+    // Only one transfer is in flight at a time, so the other half finished sending before this one started
+    qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0]) ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+#endif
+}
+
+bool qp_internal_pixdata_buffer_contains(const void *data) {
+    const uint8_t *p = (const uint8_t *)data;
+#if QUANTUM_PAINTER_SPI_ASYNC
+    return p >= &qp_internal_pixdata_buffers[0][0] && p < &qp_internal_pixdata_buffers[0][0] + sizeof(qp_internal_pixdata_buffers);
+#else
+    return p >= qp_internal_global_pixdata_buffer && p < qp_internal_global_pixdata_buffer + QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE;
+#endif
+}
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -53,6 +75,9 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     uint32_t          pixels_in_pixdata = qp_internal_num_pixels_in_buffer(device);
     num_pixels                          = QP_MIN(pixels_in_pixdata, num_pixels);
 
+    // The buffer may still be on its way to the display
+    qp_comms_wait(device);
+
     // Convert the color to native pixel format
     qp_pixel_t color = {.hsv888 = {.h = hue, .s = sat, .v = val}};
     driver->driver_vtable->palette_convert(device, 1, &color);
@@ -394,3 +394,10 @@ void qp_internal_animation_tick(void) {
     static uint32_t last_anim_exec = 0;
     deferred_exec_advanced_task(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, &last_anim_exec);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter Core API: qp_internal_animation_next_trigger
+
+bool qp_internal_animation_next_trigger(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_trigger(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, trigger_time);
+}
@@ -352,8 +352,9 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
+    // Reset the input state's RLE/LZ mode -- the stream should already be correctly positioned by qp_iterate_code_points()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
+    state->input_state->lz.mode  = MARKER_BYTE; // ignored if not using LZ
 
     // Reset the output state
     state->output_state->pixel_write_pos = 0;
@@ -3,6 +3,10 @@
 
 #include "qp_internal.h"
 
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Core API: device registration
 
@@ -20,7 +24,7 @@ enum {
                      + (SH1106_NUM_DEVICES)  // SH1106
 };
 
-static painter_device_t qp_devices[QP_NUM_DEVICES] = {NULL};
+static painter_device_t qp_devices[QP_NUM_DEVICES];
 
 bool qp_internal_register_device(painter_device_t driver) {
     for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
@@ -66,10 +70,11 @@ static void qp_internal_display_timeout_task(void) {
 
 _Static_assert((QUANTUM_PAINTER_TASK_THROTTLE) > 0 && (QUANTUM_PAINTER_TASK_THROTTLE) < 1000, "QUANTUM_PAINTER_TASK_THROTTLE must be between 1 and 999");
 
+static uint32_t last_tick = 0;
+
 void qp_internal_task(void) {
     // Perform throttling of the internal processing of Quantum Painter
-    static uint32_t last_tick = 0;
-    uint32_t        now       = timer_read32();
+    uint32_t now = timer_read32();
     if (TIMER_DIFF_32(now, last_tick) < (QUANTUM_PAINTER_TASK_THROTTLE)) {
         return;
     }
@@ -80,7 +85,6 @@ void qp_internal_task(void) {
 #endif // (QUANTUM_PAINTER_DISPLAY_TIMEOUT) > 0
 
     // Handle animations
-    void qp_internal_animation_tick(void);
     qp_internal_animation_tick();
 
 #ifdef QUANTUM_PAINTER_LVGL_INTEGRATION_ENABLE
@@ -103,3 +107,29 @@ void qp_internal_task(void) {
     debug_enable = old_debug_state;
 #endif // defined(QUANTUM_PAINTER_DEBUG_ENABLE_FLUSH_TASK_OUTPUT)
 }
+
+#ifdef TICKLESS_IDLE_ENABLE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter Core API: qp_internal_idle_delay
+
+uint32_t qp_internal_idle_delay(uint32_t delay_ms) {
+#    ifdef QUANTUM_PAINTER_LVGL_INTEGRATION_ENABLE
+    // LVGL keeps its own timers, so it gets ticked at the usual rate
+    return tickless_idle_until(delay_ms, last_tick + (QUANTUM_PAINTER_TASK_THROTTLE));
+#    else
+#        if (QUANTUM_PAINTER_DISPLAY_TIMEOUT) > 0
+    if (last_input_activity_elapsed() < (QUANTUM_PAINTER_DISPLAY_TIMEOUT)) {
+        delay_ms = tickless_idle_until(delay_ms, last_input_activity_time() + (QUANTUM_PAINTER_DISPLAY_TIMEOUT));
+    }
+#        endif // (QUANTUM_PAINTER_DISPLAY_TIMEOUT) > 0
+
+    // Animation frames only get rendered once the task throttle allows it
+    uint32_t trigger_time;
+    if (qp_internal_animation_next_trigger(&trigger_time)) {
+        uint32_t next_tick = last_tick + (QUANTUM_PAINTER_TASK_THROTTLE);
+        delay_ms           = tickless_idle_until(delay_ms, timer_expired32(trigger_time, next_tick) ? trigger_time : next_tick);
+    }
+    return delay_ms;
+#    endif // QUANTUM_PAINTER_LVGL_INTEGRATION_ENABLE
+}
+#endif // TICKLESS_IDLE_ENABLE
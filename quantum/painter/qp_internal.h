@@ -31,3 +31,12 @@
 
 #include <qp_internal_formats.h>
 #include <qp_internal_driver.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Animations
+
+// Renders any animation frames that are due
+void qp_internal_animation_tick(void);
+
+// Gets the time the next animation frame is due, returning false if no animations are running
+bool qp_internal_animation_next_trigger(uint32_t *trigger_time);
@@ -218,6 +218,98 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+/**
+ * @brief clamps int32_t to int8_t
+ *
+ * @param[in] int32_t value
+ * @return int8_t clamped value
+ */
+static inline int8_t pointing_device_hv_clamp(int32_t value) {
+    if (value < INT8_MIN) {
+        return INT8_MIN;
+    } else if (value > INT8_MAX) {
+        return INT8_MAX;
+    } else {
+        return value;
+    }
+}
+
+/**
+ * @brief clamps int32_t to mouse_xy_report_t
+ *
+ * @param[in] int32_t value
+ * @return mouse_xy_report_t clamped value
+ */
+static inline mouse_xy_report_t pointing_device_xy_clamp(int32_t value) {
+    if (value < XY_REPORT_MIN) {
+        return XY_REPORT_MIN;
+    } else if (value > XY_REPORT_MAX) {
+        return XY_REPORT_MAX;
+    } else {
+        return value;
+    }
+}
+
+#ifdef POINTING_DEVICE_SOF_SYNC
+static volatile uint8_t pointing_device_sof_count = 0;
+static uint8_t          last_report_sof           = 0;
+static uint8_t          last_seen_sof             = 0;
+static uint32_t         last_seen_sof_time        = 0;
+static int32_t          accumulated_x = 0, accumulated_y = 0, accumulated_h = 0, accumulated_v = 0;
+
+/**
+ * @brief Counts USB frames, so that reports go out once per polling interval
+ *
+ * Called from the USB start-of-frame interrupt.
+ */
+void pointing_device_sof(void) {
+    pointing_device_sof_count++;
+}
+
+/**
+ * @brief Moves the motion in the mouse report into the accumulator, leaving the buttons
+ */
+static void pointing_device_accumulate(void) {
+    accumulated_x += local_mouse_report.x;
+    accumulated_y += local_mouse_report.y;
+    accumulated_h += local_mouse_report.h;
+    accumulated_v += local_mouse_report.v;
+    local_mouse_report.x = local_mouse_report.y = local_mouse_report.h = local_mouse_report.v = 0;
+}
+
+/**
+ * @brief Moves as much of the accumulated motion as fits into the mouse report, carrying the rest over to the next report
+ */
+static void pointing_device_take_accumulated(void) {
+    local_mouse_report.x = pointing_device_xy_clamp(accumulated_x);
+    local_mouse_report.y = pointing_device_xy_clamp(accumulated_y);
+    local_mouse_report.h = pointing_device_hv_clamp(accumulated_h);
+    local_mouse_report.v = pointing_device_hv_clamp(accumulated_v);
+    accumulated_x -= local_mouse_report.x;
+    accumulated_y -= local_mouse_report.y;
+    accumulated_h -= local_mouse_report.h;
+    accumulated_v -= local_mouse_report.v;
+}
+
+/**
+ * @brief Checks whether the host has polled for a report since the last one was sent
+ *
+ * Falls back to sending straight away when USB frames stop arriving, e.g. while suspended or when connected over another transport.
+ *
+ * @return true if a report may be sent
+ */
+static bool pointing_device_report_due(void) {
+    uint8_t sof_count = pointing_device_sof_count;
+    if (sof_count != last_seen_sof) {
+        last_seen_sof      = sof_count;
+        last_seen_sof_time = timer_read32();
+    } else if (timer_elapsed32(last_seen_sof_time) >= POINTING_DEVICE_SOF_TIMEOUT) {
+        return true;
+    }
+    return (uint8_t)(sof_count - last_report_sof) >= POINTING_DEVICE_SOF_INTERVAL;
+}
+#endif
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
@@ -238,7 +330,12 @@ __attribute__((weak)) bool pointing_device_task(void) {
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
         return false;
     }
+#    ifdef POINTING_DEVICE_SOF_SYNC
+    // Sample on a fixed grid, so late task runs don't push every later sample back -- unless it has fallen a whole period behind
+    last_exec = timer_elapsed32(last_exec) < 2 * POINTING_DEVICE_TASK_THROTTLE_MS ? last_exec + POINTING_DEVICE_TASK_THROTTLE_MS : timer_read32();
+#    else
     last_exec = timer_read32();
+#    endif
 #endif
 
     // Gather report info
@@ -297,9 +394,24 @@ __attribute__((weak)) bool pointing_device_task(void) {
     local_mouse_report.buttons     = local_mouse_report.buttons | mousekey_report.buttons;
 #endif
 
+#ifdef POINTING_DEVICE_SOF_SYNC
+    // Hold the motion back until the host next polls, so each report carries everything sampled since the last one
+    pointing_device_accumulate();
+    if (!pointing_device_report_due()) {
+        return false;
+    }
+    pointing_device_take_accumulated();
+#endif
+
     const bool send_report     = pointing_device_send() || pointing_device_force_send;
     pointing_device_force_send = false;
 
+#ifdef POINTING_DEVICE_SOF_SYNC
+    if (send_report) {
+        last_report_sof = last_seen_sof;
+    }
+#endif
+
     return send_report;
 }
 
@@ -376,37 +488,6 @@ void pointing_device_set_cpi_on_side(bool left, uint16_t cpi) {
     }
 }
 
-/**
- * @brief clamps int16_t to int8_t
- *
- * @param[in] int16_t value
- * @return int8_t clamped value
- */
-static inline int8_t pointing_device_hv_clamp(int16_t value) {
-    if (value < INT8_MIN) {
-        return INT8_MIN;
-    } else if (value > INT8_MAX) {
-        return INT8_MAX;
-    } else {
-        return value;
-    }
-}
-
-/**
- * @brief clamps int16_t to int8_t
- *
- * @param[in] clamp_range_t value
- * @return mouse_xy_report_t clamped value
- */
-static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
-    if (value < XY_REPORT_MIN) {
-        return XY_REPORT_MIN;
-    } else if (value > XY_REPORT_MAX) {
-        return XY_REPORT_MAX;
-    } else {
-        return value;
-    }
-}
 /**
  * @brief combines 2 mouse reports and returns 2
  *
@@ -102,6 +102,22 @@ typedef int32_t clamp_range_t;
 typedef int16_t clamp_range_t;
 #endif
 
+#ifdef POINTING_DEVICE_SOF_SYNC
+// Number of USB frames between reports, matching the mouse endpoint's polling interval
+#    ifndef POINTING_DEVICE_SOF_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define POINTING_DEVICE_SOF_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define POINTING_DEVICE_SOF_INTERVAL 1
+#        endif
+#    endif
+// Milliseconds without a USB frame before reports go out unsynchronised, e.g. while suspended
+#    ifndef POINTING_DEVICE_SOF_TIMEOUT
+#        define POINTING_DEVICE_SOF_TIMEOUT 5
+#    endif
+void pointing_device_sof(void);
+#endif
+
 void           pointing_device_init(void);
 bool           pointing_device_task(void);
 bool           pointing_device_send(void);
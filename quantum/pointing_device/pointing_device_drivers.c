@@ -26,6 +26,16 @@
 #define CONSTRAIN_HID(amt) ((amt) < INT8_MIN ? INT8_MIN : ((amt) > INT8_MAX ? INT8_MAX : (amt)))
 #define CONSTRAIN_HID_XY(amt) ((amt) < XY_REPORT_MIN ? XY_REPORT_MIN : ((amt) > XY_REPORT_MAX ? XY_REPORT_MAX : (amt)))
 
+#ifdef POINTING_DEVICE_SOF_SYNC
+// Clamps a sensor delta to what fits in a report, carrying the rest over to the next sample instead of dropping it
+static inline mouse_xy_report_t constrain_hid_xy_carry(int16_t amt, int32_t *carry) {
+    int32_t           total   = *carry + amt;
+    mouse_xy_report_t clamped = CONSTRAIN_HID_XY(total);
+    *carry                    = total - clamped;
+    return clamped;
+}
+#endif
+
 // get_report functions should probably be moved to their respective drivers.
 
 #if defined(POINTING_DEVICE_DRIVER_adns5050)
@@ -77,8 +87,14 @@ const pointing_device_driver_t pointing_device_driver = {
 report_mouse_t adns9800_get_report_driver(report_mouse_t mouse_report) {
     report_adns9800_t sensor_report = adns9800_get_report();
 
+#    ifdef POINTING_DEVICE_SOF_SYNC
+    static int32_t carry_x = 0, carry_y = 0;
+    mouse_report.x = constrain_hid_xy_carry(sensor_report.x, &carry_x);
+    mouse_report.y = constrain_hid_xy_carry(sensor_report.y, &carry_y);
+#    else
     mouse_report.x = CONSTRAIN_HID_XY(sensor_report.x);
     mouse_report.y = CONSTRAIN_HID_XY(sensor_report.y);
+#    endif
 
     return mouse_report;
 }
@@ -460,6 +476,10 @@ static uint16_t pmw33xx_get_cpi_wrapper(void) {
     return pmw33xx_get_cpi(0);
 }
 
+#    ifdef POINTING_DEVICE_SOF_SYNC
+static int32_t pmw33xx_carry_x = 0, pmw33xx_carry_y = 0;
+#    endif
+
 report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
     pmw33xx_report_t report    = pmw33xx_read_burst(0);
     static bool      in_motion = false;
@@ -470,6 +490,11 @@ report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
 
     if (!report.motion.b.is_motion) {
         in_motion = false;
+#    ifdef POINTING_DEVICE_SOF_SYNC
+        // Finish off any motion carried over from the last samples
+        mouse_report.x = constrain_hid_xy_carry(0, &pmw33xx_carry_x);
+        mouse_report.y = constrain_hid_xy_carry(0, &pmw33xx_carry_y);
+#    endif
         return mouse_report;
     }
 
@@ -478,8 +503,13 @@ report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
         pd_dprintf("PWM3360 (0): starting motion\n");
     }
 
+#    ifdef POINTING_DEVICE_SOF_SYNC
+    mouse_report.x = constrain_hid_xy_carry(report.delta_x, &pmw33xx_carry_x);
+    mouse_report.y = constrain_hid_xy_carry(report.delta_y, &pmw33xx_carry_y);
+#    else
     mouse_report.x = CONSTRAIN_HID_XY(report.delta_x);
     mouse_report.y = CONSTRAIN_HID_XY(report.delta_y);
+#    endif
     return mouse_report;
 }
 
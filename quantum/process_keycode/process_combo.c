@@ -16,6 +16,9 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#ifdef COMBO_KEYCODE_INDEX
+#    include <stdlib.h>
+#endif
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -92,6 +95,24 @@ static uint8_t        combo_buffer_write = 0;
 static uint8_t        combo_buffer_read  = 0;
 static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
+/* Set whenever a combo's state may have changed, so clear_combos() can skip
+ * walking every combo after key events that didn't touch any of them. */
+static bool combo_state_dirty = false;
+
+#ifdef COMBO_KEYCODE_INDEX
+/* Sorted (keycode, combo index) pairs, so a key event only visits the combos
+ * that actually contain its keycode. Built on first use from key_combos. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+static combo_index_entry_t *combo_index       = NULL;
+static uint16_t             combo_index_size  = 0;
+static uint16_t             combo_index_count = 0;
+static bool                 combo_index_built = false;
+static bool                 combo_index_valid = false;
+#endif
+
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
 #ifndef EXTRA_SHORT_COMBOS
@@ -194,6 +215,10 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+    if (!combo_state_dirty) {
+        return;
+    }
+    combo_state_dirty = false;
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -288,6 +313,7 @@ void drop_combo_from_buffer(uint16_t combo_index) {
         if (qcombo->combo_index == combo_index) {
             combo_t *combo = combo_get(combo_index);
             DISABLE_COMBO(combo);
+            combo_state_dirty = true;
 
             if (i == combo_buffer_read) {
                 INCREMENT_MOD(combo_buffer_read);
@@ -305,6 +331,7 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
     if (COMBO_DISABLED(combo)) {
         return;
     }
+    combo_state_dirty = true;
 
     // state to check against so we find the last key of the combo from the buffer
 #if defined(EXTRA_EXTRA_LONG_COMBOS)
@@ -423,6 +450,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     if (-1 == (int16_t)key_index) {
         return false;
     }
+    combo_state_dirty = true;
 
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
@@ -534,9 +562,74 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+#ifdef COMBO_KEYCODE_INDEX
+static int combo_index_entry_compare(const void *a, const void *b) {
+    const combo_index_entry_t *entry_a = a;
+    const combo_index_entry_t *entry_b = b;
+    if (entry_a->keycode != entry_b->keycode) {
+        return entry_a->keycode < entry_b->keycode ? -1 : 1;
+    }
+    return (int)entry_a->combo_index - (int)entry_b->combo_index;
+}
+
+static void combo_index_build(void) {
+    uint16_t count = combo_count();
+    uint16_t size  = 0;
+
+    for (uint16_t idx = 0; idx < count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        while (pgm_read_word(keys++) != COMBO_END) {
+            size++;
+        }
+    }
+
+    free(combo_index);
+    combo_index       = size ? (combo_index_entry_t *)malloc(size * sizeof(combo_index_entry_t)) : NULL;
+    combo_index_size  = 0;
+    combo_index_count = count;
+    combo_index_built = true;
+    // Out of memory, process_combo() falls back to checking every combo
+    combo_index_valid = combo_index || size == 0;
+    if (!combo_index) {
+        return;
+    }
+
+    for (uint16_t idx = 0; idx < count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        while ((key = pgm_read_word(keys++)) != COMBO_END) {
+            combo_index[combo_index_size++] = (combo_index_entry_t){.keycode = key, .combo_index = idx};
+        }
+    }
+    qsort(combo_index, combo_index_size, sizeof(combo_index_entry_t), combo_index_entry_compare);
+
+    // A combo listing the same key twice must still only be processed once per event
+    uint16_t unique = 0;
+    for (uint16_t i = 0; i < combo_index_size; ++i) {
+        if (unique == 0 || combo_index[i].keycode != combo_index[unique - 1].keycode || combo_index[i].combo_index != combo_index[unique - 1].combo_index) {
+            combo_index[unique++] = combo_index[i];
+        }
+    }
+    combo_index_size = unique;
+}
+
+/* Returns the position of the first index entry for keycode, or combo_index_size if there is none. */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +657,22 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEYCODE_INDEX
+    if (!combo_index_built || combo_index_count != combo_count()) {
+        combo_index_build();
+    }
+    if (combo_index_valid) {
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_size && combo_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_index[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -625,6 +730,22 @@ void combo_task(void) {
 #endif
 }
 
+#ifdef TICKLESS_IDLE_ENABLE
+/** \brief Shortens an idle sleep so that it ends when the buffered combo keys time out. */
+uint32_t combo_idle_delay(uint32_t delay_ms) {
+#    ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        uint16_t elapsed = timer_elapsed(timer);
+        if (elapsed > longest_term) {
+            return 0;
+        }
+        return MIN(delay_ms, (uint32_t)(longest_term - elapsed) + 1);
+    }
+#    endif
+    return delay_ms;
+}
+#endif
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
@@ -21,12 +21,22 @@
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
 #include "wait.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    ifndef DYNAMIC_KEYMAP_ENABLE
+#        error "DYNAMIC_MACRO_EEPROM_STORAGE requires DYNAMIC_KEYMAP_ENABLE"
+#    endif
+#    include "dynamic_keymap.h"
+#endif
+
+_Static_assert(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_BUFFER_SIZE must be less than 65536");
+
 // default feedback method
 void dynamic_macro_led_blink(void) {
 #ifdef BACKLIGHT_ENABLE
@@ -65,50 +75,324 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
 #define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
 #define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
 
+/* Recorded events are encoded in a few bytes each, rather than stored
+ * as whole keyrecord_t's:
+ *
+ *   varint   (key << 2) | (extended << 1) | pressed
+ *   uint8_t  flags:   only when extended -- the event type, and whether
+ *                     the tap state and keycode follow
+ *   uint8_t  tap:     only when flagged -- (count << 4) | interrupted
+ *   varint   keycode: only when flagged
+ *   varint   time:    milliseconds since the previous event
+ *
+ * The key is row * MATRIX_COLS + col for key events, which are only
+ * extended when they carry a tap state or keycode, and (row << 8) | col
+ * for any other type of event. A varint holds 7 bits per byte, least
+ * significant first, with the top bit set on all but the last byte.
+ *
+ * Bytes are written and read one at a time in the macro's direction,
+ * so macro 2 is stored back to front, and reads back the same as
+ * macro 1.
+ */
+#define DYNAMIC_MACRO_EXTENDED 0x02
+#define DYNAMIC_MACRO_FLAG_TYPE 0x07
+#define DYNAMIC_MACRO_FLAG_TAP 0x08
+#define DYNAMIC_MACRO_FLAG_KEYCODE 0x10
+
+/* Three bytes for each varint, plus the flags and tap state. */
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 11
+
+static uint8_t dynamic_macro_put_varint(uint8_t *data, uint32_t value) {
+    uint8_t length = 0;
+    while (value >= 0x80) {
+        data[length++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    data[length++] = value;
+    return length;
+}
+
+/**
+ * Encode a single event.
+ *
+ * @param data[out]  At least DYNAMIC_MACRO_MAX_EVENT_SIZE bytes to encode to.
+ * @param record[in] The event to encode.
+ * @param time[in]   Milliseconds since the previous event.
+ *
+ * @return The number of bytes used.
+ */
+static uint8_t dynamic_macro_encode_event(uint8_t *data, keyrecord_t *record, uint16_t time) {
+    keyevent_t *event = &record->event;
+    uint32_t    key   = event->type == KEY_EVENT ? (uint32_t)event->key.row * MATRIX_COLS + event->key.col : ((uint32_t)event->key.row << 8) | event->key.col;
+    uint8_t     flags = event->type;
+#ifndef NO_ACTION_TAPPING
+    if (record->tap.count || record->tap.interrupted) {
+        flags |= DYNAMIC_MACRO_FLAG_TAP;
+    }
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode) {
+        flags |= DYNAMIC_MACRO_FLAG_KEYCODE;
+    }
+#endif
+
+    bool    extended = flags != KEY_EVENT;
+    uint8_t length   = dynamic_macro_put_varint(data, (key << 2) | (extended ? DYNAMIC_MACRO_EXTENDED : 0) | event->pressed);
+    if (extended) {
+        data[length++] = flags;
+#ifndef NO_ACTION_TAPPING
+        if (flags & DYNAMIC_MACRO_FLAG_TAP) {
+            data[length++] = (record->tap.count << 4) | record->tap.interrupted;
+        }
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        if (flags & DYNAMIC_MACRO_FLAG_KEYCODE) {
+            length += dynamic_macro_put_varint(&data[length], record->keycode);
+        }
+#endif
+    }
+    length += dynamic_macro_put_varint(&data[length], time);
+    return length;
+}
+
+static bool dynamic_macro_get_byte(uint8_t **macro_pointer, uint8_t *macro_end, int8_t direction, uint8_t *value) {
+    if (*macro_pointer == macro_end) {
+        return false;
+    }
+    *value = **macro_pointer;
+    *macro_pointer += direction;
+    return true;
+}
+
+static bool dynamic_macro_get_varint(uint8_t **macro_pointer, uint8_t *macro_end, int8_t direction, uint32_t *value) {
+    *value = 0;
+    for (uint8_t shift = 0; shift < 21; shift += 7) {
+        uint8_t byte;
+        if (!dynamic_macro_get_byte(macro_pointer, macro_end, direction, &byte)) {
+            return false;
+        }
+        *value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Decode the next event of a macro.
+ *
+ * @param macro_pointer[in,out] The next event, advanced past it.
+ * @param macro_end[in]         The element after the last macro buffer element.
+ * @param direction[in]         Either +1 or -1, which way to iterate the buffer.
+ * @param record[out]           The event, timestamped now.
+ * @param time[out]             Milliseconds between the event and the previous one when recorded.
+ *
+ * @return false at the end of the macro, or if the event is invalid.
+ */
+static bool dynamic_macro_decode_event(uint8_t **macro_pointer, uint8_t *macro_end, int8_t direction, keyrecord_t *record, uint16_t *time) {
+    uint32_t key;
+    uint32_t value;
+    uint8_t  flags = KEY_EVENT;
+    if (!dynamic_macro_get_varint(macro_pointer, macro_end, direction, &key)) {
+        return false;
+    }
+    if ((key & DYNAMIC_MACRO_EXTENDED) && !dynamic_macro_get_byte(macro_pointer, macro_end, direction, &flags)) {
+        return false;
+    }
+
+    keyevent_type_t type = flags & DYNAMIC_MACRO_FLAG_TYPE;
+    if (type == TICK_EVENT || type > DIP_SWITCH_OFF_EVENT) {
+        return false;
+    }
+    *record = (keyrecord_t){.event = {.pressed = key & 1, .time = timer_read(), .type = type}};
+    key >>= 2;
+    if (type == KEY_EVENT) {
+        if (key >= MATRIX_ROWS * MATRIX_COLS) {
+            return false;
+        }
+        record->event.key = MAKE_KEYPOS(key / MATRIX_COLS, key % MATRIX_COLS);
+    } else {
+        record->event.key = MAKE_KEYPOS(key >> 8, key & 0xFF);
+    }
+
+    if (flags & DYNAMIC_MACRO_FLAG_TAP) {
+        uint8_t tap;
+        if (!dynamic_macro_get_byte(macro_pointer, macro_end, direction, &tap)) {
+            return false;
+        }
+#ifndef NO_ACTION_TAPPING
+        record->tap.count       = tap >> 4;
+        record->tap.interrupted = tap & 1;
+#endif
+    }
+    if (flags & DYNAMIC_MACRO_FLAG_KEYCODE) {
+        if (!dynamic_macro_get_varint(macro_pointer, macro_end, direction, &value)) {
+            return false;
+        }
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode = value;
+#endif
+    }
+
+    if (!dynamic_macro_get_varint(macro_pointer, macro_end, direction, &value)) {
+        return false;
+    }
+    *time = value;
+    return true;
+}
+
+/* Time of the last event recorded, and the buffer position after the
+ * last key-up event recorded, which is where the macro ends once
+ * trailing key-down events are trimmed. Once an event doesn't fit, no
+ * more are recorded, so that none are recorded out of order.
+ */
+static uint16_t macro_last_time;
+static uint8_t *macro_last_release;
+static bool     macro_full;
+
+/* Macros being played back. A macro played by another one is played to
+ * completion before the rest of the other one, and a macro can't play
+ * itself, so there are never more than two. Playing a macro again while
+ * it's playing replays it once it's done instead.
+ */
+typedef struct {
+    uint8_t      *begin;
+    uint8_t      *pointer; /* The next event to play. */
+    uint8_t      *end;
+    int8_t        direction;
+    uint8_t       replays; /* Times to play it again once it's done. */
+    uint16_t      delay;   /* Milliseconds to wait before the next event. */
+    layer_state_t saved_layer_state;
+} dynamic_macro_playback_t;
+
+static dynamic_macro_playback_t playback[2];
+static uint8_t                  playback_depth = 0;
+static uint16_t                 playback_timer;
+
+/* Whether the event being processed was played back, rather than
+ * pressed, so that a macro playing itself can be told apart from the
+ * user playing it again.
+ */
+static bool playback_event = false;
+
 /**
  * Start recording of the dynamic macro.
  *
  * @param[out] macro_pointer The new macro buffer iterator.
  * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(uint8_t **macro_pointer, uint8_t *macro_buffer, int8_t direction) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_user(direction);
 
+    /* Any macro still playing would end up recorded, or overwritten. */
+    playback_depth = 0;
+
     clear_keyboard();
     layer_clear();
-    *macro_pointer = macro_buffer;
+    *macro_pointer     = macro_buffer;
+    macro_last_release = macro_buffer;
+    macro_full         = false;
 }
 
 /**
- * Play the dynamic macro.
+ * Play the dynamic macro. The events are played back one at a time by
+ * dynamic_macro_task().
  *
  * @param macro_buffer[in] The beginning of the macro buffer being played.
  * @param macro_end[in]    The element after the last macro buffer element.
  * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+void dynamic_macro_play(uint8_t *macro_buffer, uint8_t *macro_end, int8_t direction) {
+    for (uint8_t i = 0; i < playback_depth; i++) {
+        if (playback[i].direction == direction) {
+            if (playback_event) {
+                dprintf("dynamic macro: slot %d is already playing\n", DYNAMIC_MACRO_CURRENT_SLOT());
+            } else if (playback[i].replays < UINT8_MAX) {
+                dprintf("dynamic macro: slot %d replay queued\n", DYNAMIC_MACRO_CURRENT_SLOT());
+                playback[i].replays++;
+            }
+            return;
+        }
+    }
+
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-    layer_state_t saved_layer_state = layer_state;
+    playback[playback_depth++] = (dynamic_macro_playback_t){
+        .begin             = macro_buffer,
+        .pointer           = macro_buffer,
+        .end               = macro_end,
+        .direction         = direction,
+        .replays           = 0,
+        .delay             = 0,
+        .saved_layer_state = layer_state,
+    };
 
     clear_keyboard();
     layer_clear();
+    playback_timer = timer_read();
+}
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
-    }
+static void dynamic_macro_play_end(void) {
+    dynamic_macro_playback_t *current = &playback[playback_depth - 1];
 
     clear_keyboard();
 
-    layer_state_set(saved_layer_state);
+    if (current->replays > 0) {
+        /* Play it again from the start, as if it was played anew. */
+        current->replays--;
+        current->pointer = current->begin;
+        current->delay   = 0;
+        layer_clear();
+        playback_timer = timer_read();
+    } else {
+        playback_depth--;
+        layer_state_set(current->saved_layer_state);
+    }
+
+    dynamic_macro_play_user(current->direction);
+}
+
+bool dynamic_macro_is_playing(void) {
+    return playback_depth > 0;
+}
+
+/**
+ * Play the next event of the macro being played back, once it's due.
+ */
+void dynamic_macro_task(void) {
+    if (playback_depth == 0) {
+        return;
+    }
+
+    dynamic_macro_playback_t *current = &playback[playback_depth - 1];
+    uint8_t                  *pointer = current->pointer;
+    keyrecord_t               record;
+    uint16_t                  time;
+    if (!dynamic_macro_decode_event(&pointer, current->end, current->direction, &record, &time)) {
+        dynamic_macro_play_end();
+        return;
+    }
+
+#ifdef DYNAMIC_MACRO_REALTIME
+    uint16_t delay = time;
+#else
+    uint16_t delay = current->delay;
+#endif
+    if (timer_elapsed(playback_timer) < delay) {
+        return;
+    }
 
-    dynamic_macro_play_user(direction);
+    current->pointer = pointer;
+#ifdef DYNAMIC_MACRO_DELAY
+    current->delay = DYNAMIC_MACRO_DELAY;
+#endif
+    playback_timer = timer_read();
+    playback_event = true;
+    process_record(&record);
+    playback_event = false;
 }
 
 /**
@@ -120,43 +404,62 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
  * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(uint8_t *macro_buffer, uint8_t **macro_pointer, uint8_t *macro2_end, int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
     if (!record->event.pressed && *macro_pointer == macro_buffer) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
+    uint8_t event[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint8_t length = dynamic_macro_encode_event(event, record, *macro_pointer == macro_buffer ? 0 : TIMER_DIFF_16(record->event.time, macro_last_time));
+
     /* The other end of the other macro is the last buffer element it
      * is safe to use before overwriting the other macro.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    if (macro_full || DYNAMIC_MACRO_CURRENT_CAPACITY(*macro_pointer, macro2_end) < length) {
+        macro_full = true;
+    } else {
+        for (uint8_t i = 0; i < length; i++) {
+            **macro_pointer = event[i];
+            *macro_pointer += direction;
+        }
+        macro_last_time = record->event.time;
+        if (!record->event.pressed) {
+            macro_last_release = *macro_pointer;
+        }
     }
     dynamic_macro_record_key_user(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
 }
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+static void dynamic_macro_save(int8_t direction);
+#endif
+
 /**
  * End recording of the dynamic macro. Essentially just update the
  * pointer to the end of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(uint8_t *macro_buffer, uint8_t *macro_pointer, int8_t direction, uint8_t **macro_end) {
     dynamic_macro_record_end_user(direction);
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    if (macro_pointer != macro_last_release) {
+        dprintln("dynamic macro: trimming trailing key-down events");
+        macro_pointer = macro_last_release;
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
 
     *macro_end = macro_pointer;
+
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_save(direction);
+#endif
 }
 
 /* Both macros use the same buffer but read/write on different
@@ -183,28 +486,74 @@ void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_poin
  * macros or one long macro and one short macro. Or even one empty
  * and one using the whole buffer.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
 
 /* Pointer to the first buffer element after the first macro.
  * Initially points to the very beginning of the buffer since the
  * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
+static uint8_t *macro_end = macro_buffer;
 
 /* The other end of the macro buffer. Serves as the beginning of
  * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+static uint8_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1;
 
 /* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+static uint8_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1;
 
 /* A persistent pointer to the current macro position (iterator)
  * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+static uint8_t *macro_pointer = NULL;
 
 /* 0   - no macro is being recorded right now
  * 1,2 - either macro 1 or 2 is being recorded */
 static uint8_t macro_id = 0;
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+/**
+ * Save a macro to EEPROM, along with the whole header. Its length is
+ * cleared while it is being written, so that an interrupted save
+ * leaves it empty.
+ */
+static void dynamic_macro_save(int8_t direction) {
+    /* The buffer size, and the lengths of macro 1 and 2. */
+    uint16_t header[3] = {DYNAMIC_MACRO_BUFFER_SIZE, macro_end - macro_buffer, r_macro_buffer - r_macro_end};
+    uint8_t  slot      = direction > 0 ? 1 : 2;
+    uint16_t length    = header[slot];
+
+    /* Macro 2 is stored back to front, so it ends at the end of the buffer. */
+    uint16_t offset = direction > 0 ? 0 : DYNAMIC_MACRO_BUFFER_SIZE - length;
+
+    header[slot] = 0;
+    dynamic_keymap_recorded_macro_set_buffer(0, sizeof(header), (uint8_t *)header);
+    dynamic_keymap_recorded_macro_set_buffer(6 + offset, length, &macro_buffer[offset]);
+    header[slot] = length;
+    dynamic_keymap_recorded_macro_set_buffer(0, sizeof(header), (uint8_t *)header);
+}
+#endif
+
+/**
+ * Load the macros saved to EEPROM, if enabled.
+ */
+void dynamic_macro_init(void) {
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    /* The buffer size, and the lengths of macro 1 and 2. */
+    uint16_t header[3];
+    dynamic_keymap_recorded_macro_get_buffer(0, sizeof(header), (uint8_t *)header);
+    if (header[0] != DYNAMIC_MACRO_BUFFER_SIZE || header[1] + header[2] > DYNAMIC_MACRO_BUFFER_SIZE) {
+        dprintln("dynamic macro: no saved macros");
+        header[0] = DYNAMIC_MACRO_BUFFER_SIZE;
+        header[1] = 0;
+        header[2] = 0;
+        dynamic_keymap_recorded_macro_set_buffer(0, sizeof(header), (uint8_t *)header);
+    }
+
+    dynamic_keymap_recorded_macro_get_buffer(6, header[1], macro_buffer);
+    dynamic_keymap_recorded_macro_get_buffer(6 + DYNAMIC_MACRO_BUFFER_SIZE - header[2], header[2], &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - header[2]]);
+    macro_end   = macro_buffer + header[1];
+    r_macro_end = r_macro_buffer - header[2];
+#endif
+}
+
 /**
  * If a dynamic macro is currently being recorded, stop recording.
  */
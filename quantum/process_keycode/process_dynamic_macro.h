@@ -22,10 +22,11 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
+/* May be overridden with a custom value. Sets the amount of RAM used
+ * for the macros: that of DYNAMIC_MACRO_SIZE key records. Events are
+ * stored encoded, in a few bytes each, so several times as many events
+ * fit. Be aware that each keypress is recorded twice because of the
+ * down-event and up-event. This is not a bug, it's the intended behavior.
  *
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
@@ -35,6 +36,21 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* Size of the buffer holding both encoded macros, in bytes. */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+/* Space taken from the end of the dynamic keymap EEPROM: the buffer
+ * size and the length of each macro, followed by a copy of the buffer.
+ */
+#    define DYNAMIC_MACRO_EEPROM_SIZE (6 + DYNAMIC_MACRO_BUFFER_SIZE)
+#endif
+
+void dynamic_macro_init(void);
+void dynamic_macro_task(void);
+bool dynamic_macro_is_playing(void);
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_record_start_user(int8_t direction);
@@ -23,6 +23,9 @@
 #include "action_util.h"
 #include "quantum.h"
 #include "quantum_keycodes.h"
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+#    include <stdlib.h>
+#endif
 
 #ifndef KEY_OVERRIDE_REPEAT_DELAY
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
@@ -83,6 +86,28 @@ static uint16_t deferred_register = 0;
 // TODO: in future maybe save in EEPROM?
 static bool enabled = true;
 
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+/* (trigger, override index) pairs sorted by trigger, so a key event only visits the overrides it could activate. Overrides
+ * triggered by KC_NO sort first and form their own bucket. Built on first use from key_overrides. */
+typedef struct {
+    uint16_t trigger;
+    uint8_t  trigger_mods;
+    uint16_t override_index;
+} key_override_index_entry_t;
+
+/* A range of index entries sharing a trigger, consumed from next to end. */
+typedef struct {
+    uint16_t next;
+    uint16_t end;
+} key_override_bucket_t;
+
+static key_override_index_entry_t *key_override_index        = NULL;
+static uint16_t                    key_override_index_size   = 0;
+static const key_override_t      **key_override_index_source = NULL;
+static bool                        key_override_index_built  = false;
+static bool                        key_override_index_valid  = false;
+#endif
+
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
@@ -245,147 +270,271 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Tries activating a single key override. Returns true if it activated, in which case `send_key_action` is set to whether the key action for `keycode` should be sent */
+static bool try_activating_single_override(const key_override_t *const override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *send_key_action) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        const bool is_trigger = override->trigger == keycode;
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
+
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    key_override_printf("Activating override\n");
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    clear_active_override(false);
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+#ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
+#endif
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        key_override_printf("Activating override\n");
+    set_suppressed_override_mods(override->suppressed_mods);
+
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
+        }
+    }
 
-        clear_active_override(false);
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
 
-#ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
-#endif
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
+
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    *send_key_action = !trigger_down;
+    return true;
+}
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+static int key_override_index_entry_compare(const void *a, const void *b) {
+    const key_override_index_entry_t *entry_a = a;
+    const key_override_index_entry_t *entry_b = b;
+    if (entry_a->trigger != entry_b->trigger) {
+        return entry_a->trigger < entry_b->trigger ? -1 : 1;
+    }
+    return (int)entry_a->override_index - (int)entry_b->override_index;
+}
+
+static void key_override_index_build(void) {
+    uint16_t count = 0;
+    while (key_overrides != NULL && key_overrides[count] != NULL) {
+        count++;
+    }
+
+    free(key_override_index);
+    key_override_index        = count ? (key_override_index_entry_t *)malloc(count * sizeof(key_override_index_entry_t)) : NULL;
+    key_override_index_size   = 0;
+    key_override_index_source = key_overrides;
+    key_override_index_built  = true;
+    // Out of memory, try_activating_override() falls back to checking every override
+    key_override_index_valid = key_override_index || count == 0;
+    if (!key_override_index) {
+        return;
+    }
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+    for (uint16_t i = 0; i < count; i++) {
+        key_override_index[key_override_index_size++] = (key_override_index_entry_t){
+            .trigger        = key_overrides[i]->trigger,
+            .trigger_mods   = key_overrides[i]->trigger_mods,
+            .override_index = i,
+        };
+    }
+    qsort(key_override_index, key_override_index_size, sizeof(key_override_index_entry_t), key_override_index_entry_compare);
+}
+
+void key_override_index_invalidate(void) {
+    key_override_index_built = false;
+}
+
+/* Adds the index entries for trigger to the buckets to visit, unless they are already there. */
+static void key_override_index_add_bucket(key_override_bucket_t *buckets, uint8_t *bucket_count, uint16_t trigger) {
+    for (uint8_t i = 0; i < *bucket_count; i++) {
+        if (key_override_index[buckets[i].next].trigger == trigger) {
+            return;
+        }
+    }
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+    uint16_t low = 0, high = key_override_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (key_override_index[mid].trigger < trigger) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
+    }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+    uint16_t end = low;
+    while (end < key_override_index_size && key_override_index[end].trigger == trigger) {
+        end++;
+    }
+    if (low < end) {
+        buckets[(*bucket_count)++] = (key_override_bucket_t){.next = low, .end = end};
+    }
+}
+#endif
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
+/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_overrides == NULL) {
+        return true;
+    }
+
+    bool send_key_action = true;
+
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+    if (!key_override_index_built || key_override_index_source != key_overrides) {
+        key_override_index_build();
+    }
+    if (key_override_index_valid) {
+        // An override only activates if its trigger is KC_NO, was just pressed, or is the last key that was pressed down
+        key_override_bucket_t buckets[3];
+        uint8_t               bucket_count = 0;
+        key_override_index_add_bucket(buckets, &bucket_count, KC_NO);
+        if (key_down) {
+            key_override_index_add_bucket(buckets, &bucket_count, keycode);
+        }
+        if (is_mod) {
+            key_override_index_add_bucket(buckets, &bucket_count, last_key_down);
+        }
+
+        // Visit the candidates in the order they are declared, so the first matching override still wins
+        while (true) {
+            key_override_bucket_t *bucket = NULL;
+            for (uint8_t i = 0; i < bucket_count; i++) {
+                if (buckets[i].next < buckets[i].end && (bucket == NULL || key_override_index[buckets[i].next].override_index < key_override_index[bucket->next].override_index)) {
+                    bucket = &buckets[i];
                 }
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
+            if (bucket == NULL) {
+                break;
+            }
+
+            const key_override_index_entry_t *entry = &key_override_index[bucket->next++];
+
+            // Same fast mods check as below, without touching the override itself
+            if (active_mods == 0 && entry->trigger_mods != 0) {
+                continue;
+            }
+
+            if (try_activating_single_override(key_overrides[entry->override_index], keycode, layer, key_down, is_mod, active_mods, &send_key_action)) {
+                *activated = true;
+                return send_key_action;
+            }
         }
 
-        *activated = true;
+        *activated = false;
+        return true;
+    }
+#endif
+
+    for (uint16_t i = 0;; i++) {
+        const key_override_t *const override = key_overrides[i];
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        if (try_activating_single_override(override, keycode, layer, key_down, is_mod, active_mods, &send_key_action)) {
+            *activated = true;
+            return send_key_action;
+        }
     }
 
     *activated = false;
@@ -108,6 +108,11 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
 /** Perform any deferred keys */
 void key_override_task(void);
 
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+/** Rebuilds the trigger index on the next key event. Call after changing the overrides `key_overrides` points to in place. */
+void key_override_index_invalidate(void);
+#endif
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
@@ -188,6 +188,21 @@ void tap_dance_task(void) {
     }
 }
 
+#ifdef TICKLESS_IDLE_ENABLE
+uint32_t tap_dance_idle_delay(uint32_t delay_ms) {
+    if (!active_td) {
+        return delay_ms;
+    }
+    // tap_dance_task() finishes the dance once the tapping term has been exceeded
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    if (elapsed > term) {
+        return 0;
+    }
+    return MIN(delay_ms, (uint32_t)(term - elapsed + 1));
+}
+#endif
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
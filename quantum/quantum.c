@@ -174,6 +174,9 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_flush();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -194,6 +197,9 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -504,6 +510,12 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_flush();
+#endif
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+    eeprom_write_behind_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
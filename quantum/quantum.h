@@ -186,6 +186,10 @@ extern layer_state_t layer_state;
 #    include "dynamic_keymap.h"
 #endif
 
+#ifdef EEPROM_WRITE_BEHIND_ENABLE
+#    include "eeprom_write_behind.h"
+#endif
+
 #ifdef JOYSTICK_ENABLE
 #    include "joystick.h"
 #endif
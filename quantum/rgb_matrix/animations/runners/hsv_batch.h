@@ -0,0 +1,41 @@
+#pragma once
+
+// Collects the colors computed by a runner, so they can be converted to RGB
+// in batches rather than one LED at a time
+
+#ifdef RGB_MATRIX_HSV_BATCH_CONVERSION
+typedef struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_HSV_BATCH_SIZE];
+    HSV     hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+} hsv_batch_t;
+
+static void hsv_batch_flush(hsv_batch_t* batch) {
+    RGB rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t j = 0; j < batch->count; j++) {
+        rgb_matrix_set_color(batch->index[j], rgb[j].r, rgb[j].g, rgb[j].b);
+    }
+    batch->count = 0;
+}
+
+static inline void hsv_batch_add(hsv_batch_t* batch, uint8_t index, HSV hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        hsv_batch_flush(batch);
+    }
+}
+#else
+// Without batched conversion there's nothing to gain from buffering, so each LED is converted and set straight away
+typedef struct {
+    uint8_t count;
+} hsv_batch_t;
+
+static inline void hsv_batch_flush(hsv_batch_t* batch) {}
+
+static inline void hsv_batch_add(hsv_batch_t* batch, uint8_t index, HSV hsv) {
+    RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+    rgb_matrix_set_color(index, rgb.r, rgb.g, rgb.b);
+}
+#endif
@@ -24,6 +24,30 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
+#            ifdef RGB_MATRIX_GEOMETRY_CACHE
+    // The neighbours are sorted by distance, so only the table has to be walked when it covers the whole spread
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (RGB_MATRIX_TYPING_HEATMAP_SPREAD < g_led_geometry[led].reach) {
+        g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+        for (uint8_t n = 0; n < RGB_MATRIX_GEOMETRY_NEIGHBOURS; n++) {
+            led_neighbour_t neighbour = g_led_neighbours[led][n];
+            if (neighbour.index == NO_LED || neighbour.dist > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                break;
+            }
+            uint8_t i_row = g_led_geometry[neighbour.index].row;
+            uint8_t i_col = g_led_geometry[neighbour.index].col;
+            if (i_row == UINT8_MAX) { // skip as target led doesn't have a key position
+                continue;
+            }
+            uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, neighbour.dist);
+            if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+            }
+            g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
+        }
+        return;
+    }
+#            endif
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
             if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
@@ -32,9 +56,9 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
             if (i_row == row && i_col == col) {
                 g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
             } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
+#                define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
                 uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
+#                undef LED_DISTANCE
                 if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
                     uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
                     if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
@@ -23,6 +23,15 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+#    include "action_layer.h"
+#    include "action_util.h"
+#    include "host.h"
+#    include "timer.h"
+#endif
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -39,6 +48,18 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Used by the effect runners. Converts through rgb_matrix_hsv_to_rgb() so keyboard
+// overrides still apply, unless the keyboard opts in to the batched conversion.
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+#ifdef RGB_MATRIX_HSV_BATCH_CONVERSION
+    hsv_to_rgb_batch(hsv, rgb, count);
+#else
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+#endif
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -83,6 +104,27 @@ static uint32_t rgb_timer_buffer;
 static last_hit_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+// colors last written to the driver, and the range changed since the last flush
+static RGB     rgb_frame[RGB_MATRIX_LED_COUNT];
+static uint8_t rgb_dirty_min = 0;
+static uint8_t rgb_dirty_max = RGB_MATRIX_LED_COUNT; // the first frame is always flushed
+
+// everything a static effect and the indicators are expected to depend on
+typedef struct {
+    rgb_config_t  config;
+    layer_state_t layer_state;
+    layer_state_t default_layer_state;
+    led_t         led_state;
+    uint8_t       mods;
+    uint8_t       effect;
+} rgb_static_inputs_t;
+
+static rgb_static_inputs_t rgb_static_inputs;
+static uint32_t            rgb_static_rendered;
+static bool                rgb_static_valid = false;
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
@@ -144,11 +186,22 @@ void rgb_matrix_update_pwm_buffers(void) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        RGB *rgb = &rgb_frame[index];
+        if (rgb->r == red && rgb->g == green && rgb->b == blue) {
+            return;
+        }
+        *rgb = (RGB){.r = red, .g = green, .b = blue};
+        if (index < rgb_dirty_min) rgb_dirty_min = index;
+        if (index >= rgb_dirty_max) rgb_dirty_max = index + 1;
+    }
+#endif // RGB_MATRIX_DIRTY_TRACKING
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)) || defined(RGB_MATRIX_DIRTY_TRACKING)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -258,16 +311,83 @@ static void rgb_task_timers(void) {
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void rgb_task_sync(void) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+__attribute__((weak)) bool rgb_matrix_effect_is_static_kb(uint8_t mode) {
+    return rgb_matrix_effect_is_static_user(mode);
+}
+
+__attribute__((weak)) bool rgb_matrix_effect_is_static_user(uint8_t mode) {
+    return false;
+}
+
+static bool rgb_matrix_effect_is_static(uint8_t effect) {
+    switch (effect) {
+        case RGB_MATRIX_NONE:
+        case RGB_MATRIX_SOLID_COLOR:
+#    ifdef ENABLE_RGB_MATRIX_ALPHAS_MODS
+        case RGB_MATRIX_ALPHAS_MODS:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+        case RGB_MATRIX_GRADIENT_UP_DOWN:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+        case RGB_MATRIX_GRADIENT_LEFT_RIGHT:
+#    endif
+            return true;
+        default:
+            return rgb_matrix_effect_is_static_kb(effect);
+    }
+}
+
+static void rgb_static_inputs_read(rgb_static_inputs_t *inputs, uint8_t effect) {
+    memset(inputs, 0, sizeof(rgb_static_inputs_t));
+    inputs->config              = rgb_matrix_config;
+    inputs->layer_state         = layer_state;
+    inputs->default_layer_state = default_layer_state;
+    inputs->led_state           = host_keyboard_led_state();
+    inputs->mods                = get_mods() | get_oneshot_mods();
+    inputs->effect              = effect;
+}
+
+static bool rgb_static_frame_current(uint8_t effect) {
+    if (!rgb_static_valid || timer_elapsed32(rgb_static_rendered) >= RGB_MATRIX_STATIC_REFRESH_INTERVAL) {
+        return false;
+    }
+    rgb_static_inputs_t inputs;
+    rgb_static_inputs_read(&inputs, effect);
+    return memcmp(&inputs, &rgb_static_inputs, sizeof(rgb_static_inputs_t)) == 0;
+}
+
+void rgb_matrix_invalidate(void) {
+    rgb_static_valid = false;
+}
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
+static void rgb_task_sync(uint8_t effect) {
     eeconfig_flush_rgb_matrix(false);
     // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+        // nothing a static effect depends on has changed, so the frame would be identical
+        if (rgb_static_frame_current(effect)) return;
+#endif // RGB_MATRIX_DIRTY_TRACKING
+        rgb_task_state = STARTING;
+    }
 }
 
-static void rgb_task_start(void) {
+static void rgb_task_start(uint8_t effect) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    // snapshot the inputs before rendering, so changes made mid-frame trigger another one
+    rgb_static_valid = false;
+    if (rgb_matrix_effect_is_static(effect)) {
+        rgb_static_inputs_read(&rgb_static_inputs, effect);
+        rgb_static_rendered = timer_read32();
+    }
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -343,16 +463,28 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    // only flush when something changed, and only the changed range if the driver can
+    if (rgb_dirty_min < rgb_dirty_max) {
+        if (rgb_matrix_driver.flush_range) {
+            rgb_matrix_driver.flush_range(rgb_dirty_min, rgb_dirty_max);
+        } else {
+            rgb_matrix_update_pwm_buffers();
+        }
+        rgb_dirty_min = RGB_MATRIX_LED_COUNT;
+        rgb_dirty_max = 0;
+    }
+    rgb_static_valid = rgb_matrix_effect_is_static(effect);
+#else
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#endif // RGB_MATRIX_DIRTY_TRACKING
 
     // next task
     rgb_task_state = SYNCING;
 }
 
-void rgb_matrix_task(void) {
-    rgb_task_timers();
-
+static uint8_t rgb_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -361,11 +493,17 @@ void rgb_matrix_task(void) {
 #endif // RGB_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+    return suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+}
+
+void rgb_matrix_task(void) {
+    rgb_task_timers();
+
+    uint8_t effect = rgb_task_effect();
 
     switch (rgb_task_state) {
         case STARTING:
-            rgb_task_start();
+            rgb_task_start(effect);
             break;
         case RENDERING:
             rgb_task_render(effect);
@@ -380,11 +518,40 @@ void rgb_matrix_task(void) {
             rgb_task_flush(effect);
             break;
         case SYNCING:
-            rgb_task_sync();
+            rgb_task_sync(effect);
             break;
     }
 }
 
+#ifdef TICKLESS_IDLE_ENABLE
+uint32_t rgb_matrix_idle_delay(uint32_t delay_ms) {
+    // finish the frame in progress first
+    if (rgb_task_state != SYNCING) {
+        return 0;
+    }
+
+    uint8_t effect = rgb_task_effect();
+#    if RGB_MATRIX_TIMEOUT > 0
+    // wake up to turn the LEDs off
+    if (effect) {
+        delay_ms = tickless_idle_until(delay_ms, last_input_activity_time() + RGB_MATRIX_TIMEOUT + 1);
+    }
+#    endif // RGB_MATRIX_TIMEOUT > 0
+
+    // RGB_MATRIX_NONE only needs flushing once
+    if (effect == RGB_MATRIX_NONE && rgb_last_effect == RGB_MATRIX_NONE && rgb_last_enable == rgb_matrix_config.enable) {
+        return delay_ms;
+    }
+#    ifdef RGB_MATRIX_DIRTY_TRACKING
+    // static effects only need to be refreshed periodically, input changes are picked up on wake
+    if (rgb_static_valid && rgb_matrix_effect_is_static(effect)) {
+        return tickless_idle_until(delay_ms, rgb_static_rendered + RGB_MATRIX_STATIC_REFRESH_INTERVAL);
+    }
+#    endif // RGB_MATRIX_DIRTY_TRACKING
+    return tickless_idle_until(delay_ms, g_rgb_timer + RGB_MATRIX_LED_FLUSH_LIMIT);
+}
+#endif // TICKLESS_IDLE_ENABLE
+
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
 }
@@ -448,6 +615,10 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    rgb_matrix_geometry_init();
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
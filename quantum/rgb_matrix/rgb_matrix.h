@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include "rgb_matrix_types.h"
 #include "rgb_matrix_drivers.h"
+#include "rgb_matrix_geometry.h"
 #include "color.h"
 #include "keyboard.h"
 
@@ -90,6 +91,14 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#    define RGB_MATRIX_HSV_BATCH_SIZE 16
+#endif
+
+#ifndef RGB_MATRIX_STATIC_REFRESH_INTERVAL
+#    define RGB_MATRIX_STATIC_REFRESH_INTERVAL 500
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -152,6 +161,9 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
 
+// Shortens an idle sleep so that it ends when the next frame is due
+uint32_t rgb_matrix_idle_delay(uint32_t delay_ms);
+
 // This runs after another backlight effect and replaces
 // colors already set
 void rgb_matrix_indicators(void);
@@ -162,6 +174,17 @@ void rgb_matrix_indicators_advanced(effect_params_t *params);
 bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+// Static effects only depend on the config, and are not re-rendered
+// until something they, or the indicators, could depend on changes
+bool rgb_matrix_effect_is_static_kb(uint8_t mode);
+bool rgb_matrix_effect_is_static_user(uint8_t mode);
+
+// Forces the next frame to be rendered, for indicators that depend on
+// state other than the layers, mods and host LEDs
+void rgb_matrix_invalidate(void);
+#endif
+
 void rgb_matrix_init(void);
 
 void rgb_matrix_reload_from_eeprom(void);
@@ -269,8 +292,9 @@ static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
 
 extern rgb_config_t rgb_matrix_config;
 
-extern uint32_t     g_rgb_timer;
-extern led_config_t g_led_config;
+extern uint32_t          g_rgb_timer;
+extern led_config_t      g_led_config;
+extern const led_point_t k_rgb_matrix_center;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
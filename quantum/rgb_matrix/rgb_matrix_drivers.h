@@ -44,6 +44,8 @@ typedef struct {
     void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
     /* Flush any buffered changes to the hardware. */
     void (*flush)(void);
+    /* Optional: flush only the LEDs in [first, last) to the hardware, used with RGB_MATRIX_DIRTY_TRACKING. */
+    void (*flush_range)(uint8_t first, uint8_t last);
 } rgb_matrix_driver_t;
 
 extern const rgb_matrix_driver_t rgb_matrix_driver;
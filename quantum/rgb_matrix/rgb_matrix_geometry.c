@@ -0,0 +1,71 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include <string.h>
+
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+
+#    include <lib/lib8tion/lib8tion.h>
+
+_Static_assert(RGB_MATRIX_GEOMETRY_NEIGHBOURS > 0 && RGB_MATRIX_GEOMETRY_NEIGHBOURS < UINT8_MAX, "RGB_MATRIX_GEOMETRY_NEIGHBOURS must be between 1 and 254");
+
+led_geometry_t  g_led_geometry[RGB_MATRIX_LED_COUNT];
+led_neighbour_t g_led_neighbours[RGB_MATRIX_LED_COUNT][RGB_MATRIX_GEOMETRY_NEIGHBOURS];
+
+static uint8_t led_distance(led_point_t a, led_point_t b) {
+    int16_t dx = a.x - b.x;
+    int16_t dy = a.y - b.y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
+static void insert_neighbour(led_neighbour_t *neighbours, uint8_t index, uint8_t dist) {
+    uint8_t slot = RGB_MATRIX_GEOMETRY_NEIGHBOURS;
+    while (slot > 0 && (neighbours[slot - 1].index == NO_LED || neighbours[slot - 1].dist > dist)) {
+        slot--;
+    }
+    if (slot == RGB_MATRIX_GEOMETRY_NEIGHBOURS) {
+        return;
+    }
+    memmove(&neighbours[slot + 1], &neighbours[slot], (RGB_MATRIX_GEOMETRY_NEIGHBOURS - slot - 1) * sizeof(led_neighbour_t));
+    neighbours[slot] = (led_neighbour_t){.index = index, .dist = dist};
+}
+
+void rgb_matrix_geometry_init(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        led_geometry_t *geometry = &g_led_geometry[i];
+
+        geometry->dx    = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        geometry->dy    = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        geometry->dist  = sqrt16(geometry->dx * geometry->dx + geometry->dy * geometry->dy);
+        geometry->angle = atan2_8(geometry->dy, geometry->dx);
+        geometry->row   = UINT8_MAX;
+        geometry->col   = UINT8_MAX;
+
+        for (uint8_t n = 0; n < RGB_MATRIX_GEOMETRY_NEIGHBOURS; n++) {
+            g_led_neighbours[i][n].index = NO_LED;
+        }
+        for (uint8_t j = 0; j < RGB_MATRIX_LED_COUNT; j++) {
+            if (j != i) {
+                insert_neighbour(g_led_neighbours[i], j, led_distance(g_led_config.point[i], g_led_config.point[j]));
+            }
+        }
+
+        // LEDs left out of a full table are at least as far as its last entry
+        led_neighbour_t last = g_led_neighbours[i][RGB_MATRIX_GEOMETRY_NEIGHBOURS - 1];
+        geometry->reach      = last.index == NO_LED ? UINT8_MAX : last.dist;
+    }
+
+    // Walk backwards so the first matrix position wins when several drive the same LED
+    for (uint8_t row = MATRIX_ROWS; row-- > 0;) {
+        for (uint8_t col = MATRIX_COLS; col-- > 0;) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led < RGB_MATRIX_LED_COUNT) {
+                g_led_geometry[led].row = row;
+                g_led_geometry[led].col = col;
+            }
+        }
+    }
+}
+
+#endif // RGB_MATRIX_GEOMETRY_CACHE
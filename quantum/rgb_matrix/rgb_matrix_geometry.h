@@ -0,0 +1,40 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "rgb_matrix_types.h"
+
+// Room for every key within the typing heatmap spread, at the usual key pitch of about 15 by 13 units
+#ifndef RGB_MATRIX_GEOMETRY_NEIGHBOURS
+#    ifdef RGB_MATRIX_TYPING_HEATMAP_SPREAD
+#        define RGB_MATRIX_GEOMETRY_NEIGHBOURS (RGB_MATRIX_TYPING_HEATMAP_SPREAD * RGB_MATRIX_TYPING_HEATMAP_SPREAD / 62 + 1)
+#    else
+#        define RGB_MATRIX_GEOMETRY_NEIGHBOURS 26
+#    endif
+#endif
+
+typedef struct {
+    int16_t dx;    // relative to k_rgb_matrix_center
+    int16_t dy;    // relative to k_rgb_matrix_center
+    uint8_t dist;  // distance to k_rgb_matrix_center
+    uint8_t angle; // atan2_8(dy, dx)
+    uint8_t row;   // matrix position driving this LED, or UINT8_MAX if none
+    uint8_t col;
+    uint8_t reach; // every LED closer than this is in g_led_neighbours
+} led_geometry_t;
+
+typedef struct {
+    uint8_t index; // NO_LED for unused entries
+    uint8_t dist;
+} led_neighbour_t;
+
+/* Per LED geometry derived from g_led_config. */
+extern led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+
+/* The closest other LEDs to each LED, sorted by increasing distance. */
+extern led_neighbour_t g_led_neighbours[RGB_MATRIX_LED_COUNT][RGB_MATRIX_GEOMETRY_NEIGHBOURS];
+
+/* Rebuilds the cache, must be called again if g_led_config is changed at runtime. */
+void rgb_matrix_geometry_init(void);
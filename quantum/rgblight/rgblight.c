@@ -1530,6 +1530,35 @@ void rgblight_task(void) {
 #endif
 }
 
+#ifdef TICKLESS_IDLE_ENABLE
+/* Animations, blinking layers and velocikey are all stepped on every task call,
+ * so only static modes allow the keyboard to sleep.
+ */
+uint32_t rgblight_idle_delay(uint32_t delay_ms) {
+#    ifdef RGBLIGHT_USE_TIMER
+    if (rgblight_status.timer_enabled) {
+        return 0;
+    }
+#        ifdef RGBLIGHT_LAYERS
+    if (deferred_set_layer_state) {
+        return 0;
+    }
+#            ifdef RGBLIGHT_LAYER_BLINK
+    if (_blinking_layer_mask != 0) {
+        return 0;
+    }
+#            endif
+#        endif
+#    endif
+#    ifdef VELOCIKEY_ENABLE
+    if (rgblight_velocikey_enabled()) {
+        return 0;
+    }
+#    endif
+    return delay_ms;
+}
+#endif
+
 #ifdef VELOCIKEY_ENABLE
 #    define TYPING_SPEED_MAX_VALUE 200
 
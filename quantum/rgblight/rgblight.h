@@ -395,6 +395,7 @@ void rgblight_show_solid_color(uint8_t r, uint8_t g, uint8_t b);
 
 void preprocess_rgblight(void);
 void rgblight_task(void);
+uint32_t rgblight_idle_delay(uint32_t delay_ms);
 
 #ifdef RGBLIGHT_USE_TIMER
 void rgblight_timer_init(void);
@@ -23,6 +23,11 @@
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#ifdef SEND_STRING_ASYNC
+#    include "timer.h"
+#    include "eeprom.h"
+#    include "util.h"
+#endif
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -30,6 +35,114 @@
 #        define BELL_SOUND TERMINAL_SOUND
 #    endif
 float bell_song[][2] = SONG(BELL_SOUND);
+
+static void play_bell(void) {
+    PLAY_SONG(bell_song);
+}
+#endif
+
+#ifdef SEND_STRING_ASYNC
+#    ifndef SEND_STRING_QUEUE_SIZE
+#        define SEND_STRING_QUEUE_SIZE 64
+#    endif
+#    ifndef SEND_STRING_REPORT_INTERVAL
+#        define SEND_STRING_REPORT_INTERVAL 0
+#    endif
+
+_Static_assert(SEND_STRING_QUEUE_SIZE > 0 && SEND_STRING_QUEUE_SIZE <= UINT8_MAX, "SEND_STRING_QUEUE_SIZE must be between 1 and 255");
+
+typedef enum {
+    SEND_STRING_OP_REGISTER,
+    SEND_STRING_OP_UNREGISTER,
+    SEND_STRING_OP_WAIT,
+    SEND_STRING_OP_CALL,
+    SEND_STRING_OP_STRING,
+} send_string_op_type_t;
+
+typedef enum {
+    SEND_STRING_SOURCE_RAM,
+    SEND_STRING_SOURCE_PROGMEM,
+    SEND_STRING_SOURCE_EEPROM,
+} send_string_source_t;
+
+typedef struct {
+    uint8_t type;
+    union {
+        uint8_t keycode;
+        uint8_t interval;
+    };
+    union {
+        uint16_t wait_ms;
+        uint8_t  source;
+    };
+    union {
+        void (*callback)(void);
+        const char *string;
+    };
+} send_string_op_t;
+
+/* The most operations a single character expands to: Shift and AltGr down (two each, with their waits), the tap (three), its
+ * wait, Shift and AltGr up (two each), then the space tap for a dead key (three) and its wait. */
+#    define SEND_STRING_CHAR_MAX_OPS (2 + 2 + 3 + 1 + 2 + 2 + 3 + 1)
+#    define SEND_STRING_EXPANSION_SIZE (SEND_STRING_CHAR_MAX_OPS + 4)
+
+_Static_assert(SEND_STRING_EXPANSION_SIZE >= SEND_STRING_CHAR_MAX_OPS, "The expansion buffer must fit the operations of the longest character");
+
+/* Operations waiting to run, in order. String operations stay at the front of the queue while the string is typed out, a
+ * character at a time, through the expansion buffer -- large enough for the operations of the longest character. */
+static send_string_op_t queue[SEND_STRING_QUEUE_SIZE];
+static uint8_t          queue_head  = 0;
+static uint8_t          queue_count = 0;
+static send_string_op_t expansion[SEND_STRING_EXPANSION_SIZE];
+static uint8_t          expansion_head  = 0;
+static uint8_t          expansion_count = 0;
+static bool             expanding       = false;
+static uint32_t         wait_start      = 0;
+static uint16_t         wait_duration   = 0;
+
+static bool send_string_next_op(send_string_op_t *op);
+static bool send_string_run_op(const send_string_op_t *op);
+
+static void send_string_wait_for(uint16_t ms) {
+    wait_start    = timer_read32();
+    wait_duration = ms;
+}
+
+static uint16_t send_string_wait_remaining(void) {
+    uint32_t elapsed = timer_elapsed32(wait_start);
+    return elapsed < wait_duration ? wait_duration - elapsed : 0;
+}
+
+static void send_string_enqueue(send_string_op_t op) {
+    if (expanding) {
+        // Out of room, so play out what has been expanded so far -- this blocks, rather than dropping an unregister
+        if (expansion_count == ARRAY_SIZE(expansion)) {
+            while (expansion_head < expansion_count) {
+                uint16_t remaining = send_string_wait_remaining();
+                if (remaining > 0) {
+                    wait_ms(remaining);
+                }
+                send_string_run_op(&expansion[expansion_head++]);
+            }
+            expansion_head = expansion_count = 0;
+        }
+        expansion[expansion_count++] = op;
+        return;
+    }
+
+    // Out of room, so play out what is queued until there is -- this blocks, just like the synchronous API does
+    while (queue_count == SEND_STRING_QUEUE_SIZE) {
+        uint16_t remaining = send_string_wait_remaining();
+        if (remaining > 0) {
+            wait_ms(remaining);
+        }
+        send_string_op_t next;
+        if (send_string_next_op(&next)) {
+            send_string_run_op(&next);
+        }
+    }
+    queue[(queue_head + queue_count++) % SEND_STRING_QUEUE_SIZE] = op;
+}
 #endif
 
 // clang-format off
@@ -146,11 +259,230 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+void send_string_register_code(uint8_t keycode) {
+#ifdef SEND_STRING_ASYNC
+    send_string_enqueue((send_string_op_t){.type = SEND_STRING_OP_REGISTER, .keycode = keycode});
+#else
+    register_code(keycode);
+#endif
+}
+
+void send_string_unregister_code(uint8_t keycode) {
+#ifdef SEND_STRING_ASYNC
+    send_string_enqueue((send_string_op_t){.type = SEND_STRING_OP_UNREGISTER, .keycode = keycode});
+#else
+    unregister_code(keycode);
+#endif
+}
+
+void send_string_tap_code(uint8_t keycode) {
+#ifdef SEND_STRING_ASYNC
+    send_string_tap_code_delay(keycode, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+#else
+    tap_code(keycode);
+#endif
+}
+
+void send_string_tap_code_delay(uint8_t keycode, uint16_t delay) {
+#ifdef SEND_STRING_ASYNC
+    send_string_register_code(keycode);
+    send_string_wait(delay);
+    send_string_unregister_code(keycode);
+#else
+    tap_code_delay(keycode, delay);
+#endif
+}
+
+void send_string_wait(uint16_t ms) {
+#ifdef SEND_STRING_ASYNC
+    if (ms > 0) {
+        send_string_enqueue((send_string_op_t){.type = SEND_STRING_OP_WAIT, .wait_ms = ms});
+    }
+#else
+    wait_ms(ms);
+#endif
+}
+
+void send_string_call(void (*callback)(void)) {
+#ifdef SEND_STRING_ASYNC
+    send_string_enqueue((send_string_op_t){.type = SEND_STRING_OP_CALL, .callback = callback});
+#else
+    callback();
+#endif
+}
+
+#ifdef SEND_STRING_ASYNC
+static char send_string_read(uint8_t source, const char *string) {
+    switch (source) {
+        case SEND_STRING_SOURCE_PROGMEM:
+            return pgm_read_byte(string);
+        case SEND_STRING_SOURCE_EEPROM:
+            return eeprom_read_byte((const uint8_t *)string);
+        default:
+            return *string;
+    }
+}
+
+/* Queues the operations for the character or keycode sequence at the start of string. Returns where the next one starts, or
+ * NULL if that was the end of the string. */
+static const char *send_string_parse(const char *string, uint8_t source, uint8_t interval) {
+    char ascii_code = send_string_read(source, string);
+    if (!ascii_code) {
+        return NULL;
+    }
+
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code = send_string_read(source, ++string);
+
+        if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+            uint8_t keycode = send_string_read(source, ++string);
+            if (!keycode) {
+                return NULL;
+            }
+            if (ascii_code == SS_TAP_CODE) {
+                send_string_tap_code(keycode);
+            } else if (ascii_code == SS_DOWN_CODE) {
+                send_string_register_code(keycode);
+            } else {
+                send_string_unregister_code(keycode);
+            }
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint16_t ms      = 0;
+            uint8_t  keycode = send_string_read(source, ++string);
+
+            while (isdigit(keycode)) {
+                ms *= 10;
+                ms += keycode - '0';
+                keycode = send_string_read(source, ++string);
+            }
+
+            send_string_wait(ms);
+            if (!keycode) {
+                return NULL;
+            }
+        } else if (!ascii_code) {
+            return NULL;
+        }
+
+        send_string_wait(interval);
+    } else {
+        send_char_with_delay(ascii_code, interval);
+    }
+
+    ++string;
+    return send_string_read(source, string) ? string : NULL;
+}
+
+static void send_string_queue_string(const char *string, uint8_t source, uint8_t interval) {
+    if (string) {
+        send_string_enqueue((send_string_op_t){.type = SEND_STRING_OP_STRING, .interval = interval, .source = source, .string = string});
+    }
+}
+
+/* Takes the next operation to run, typing out the next character of a string if that is what is at the front. */
+static bool send_string_next_op(send_string_op_t *op) {
+    while (true) {
+        if (expansion_head < expansion_count) {
+            *op = expansion[expansion_head++];
+            return true;
+        }
+        expansion_head = expansion_count = 0;
+
+        if (queue_count == 0) {
+            return false;
+        }
+
+        send_string_op_t *front     = &queue[queue_head];
+        bool              is_string = front->type == SEND_STRING_OP_STRING;
+        if (is_string) {
+            expanding     = true;
+            front->string = send_string_parse(front->string, front->source, front->interval);
+            expanding     = false;
+            if (front->string) {
+                continue;
+            }
+        } else {
+            *op = *front;
+        }
+
+        // Done with the front of the queue -- for a string, the expansion buffer still holds its last character
+        queue_head = (queue_head + 1) % SEND_STRING_QUEUE_SIZE;
+        queue_count--;
+        if (!is_string) {
+            return true;
+        }
+    }
+}
+
+/* Runs a single operation. Returns true if it sent a report, so the next one has to wait for the next pass. */
+static bool send_string_run_op(const send_string_op_t *op) {
+    switch (op->type) {
+        case SEND_STRING_OP_REGISTER:
+            register_code(op->keycode);
+            break;
+        case SEND_STRING_OP_UNREGISTER:
+            unregister_code(op->keycode);
+            break;
+        case SEND_STRING_OP_WAIT:
+            send_string_wait_for(op->wait_ms);
+            return false;
+        case SEND_STRING_OP_CALL:
+            op->callback();
+            break;
+        default:
+            return false;
+    }
+
+    send_string_wait_for(SEND_STRING_REPORT_INTERVAL);
+    return true;
+}
+
+void send_string_task(void) {
+    send_string_op_t op;
+    while (send_string_wait_remaining() == 0 && send_string_next_op(&op)) {
+        if (send_string_run_op(&op)) {
+            break;
+        }
+    }
+}
+
+bool send_string_is_busy(void) {
+    return queue_count > 0 || expansion_head < expansion_count;
+}
+
+#    ifdef TICKLESS_IDLE_ENABLE
+uint32_t send_string_idle_delay(uint32_t delay_ms) {
+    if (!send_string_is_busy()) {
+        return delay_ms;
+    }
+    return MIN(delay_ms, send_string_wait_remaining());
+}
+#    endif
+
+void send_string_with_delay_P(const char *string, uint8_t interval) {
+    send_string_queue_string(string, SEND_STRING_SOURCE_PROGMEM, interval);
+}
+
+void send_string_P(const char *string) {
+    send_string_with_delay_P(string, 0);
+}
+
+void send_string_with_delay_eeprom(const char *string, uint8_t interval) {
+    send_string_queue_string(string, SEND_STRING_SOURCE_EEPROM, interval);
+}
+#endif
+
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
 
 void send_string_with_delay(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC
+    // The string may not outlive this call, so it is parsed into the queue straight away
+    while (string) {
+        string = send_string_parse(string, SEND_STRING_SOURCE_RAM, interval);
+    }
+#else
     while (1) {
         char ascii_code = *string;
         if (!ascii_code) break;
@@ -190,6 +522,7 @@ void send_string_with_delay(const char *string, uint8_t interval) {
 
         ++string;
     }
+#endif
 }
 
 void send_char(char ascii_code) {
@@ -199,7 +532,7 @@ void send_char(char ascii_code) {
 void send_char_with_delay(char ascii_code, uint8_t interval) {
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
     if (ascii_code == '\a') { // BEL
-        PLAY_SONG(bell_song);
+        send_string_call(play_bell);
         return;
     }
 #endif
@@ -210,31 +543,31 @@ void send_char_with_delay(char ascii_code, uint8_t interval) {
     bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
 
     if (is_shifted) {
-        register_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_register_code(KC_LEFT_SHIFT);
+        send_string_wait(interval);
     }
 
     if (is_altgred) {
-        register_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_register_code(KC_RIGHT_ALT);
+        send_string_wait(interval);
     }
 
-    tap_code_delay(keycode, interval);
-    wait_ms(interval);
+    send_string_tap_code_delay(keycode, interval);
+    send_string_wait(interval);
 
     if (is_altgred) {
-        unregister_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_unregister_code(KC_RIGHT_ALT);
+        send_string_wait(interval);
     }
 
     if (is_shifted) {
-        unregister_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_unregister_code(KC_LEFT_SHIFT);
+        send_string_wait(interval);
     }
 
     if (is_dead) {
-        tap_code(KC_SPACE);
-        wait_ms(interval);
+        send_string_tap_code(KC_SPACE);
+        send_string_wait(interval);
     }
 }
 
@@ -292,7 +625,7 @@ void tap_random_base64(void) {
     }
 }
 
-#if defined(__AVR__)
+#if defined(__AVR__) && !defined(SEND_STRING_ASYNC)
 void send_string_P(const char *string) {
     send_string_with_delay_P(string, 0);
 }
@@ -23,6 +23,7 @@
  * \{
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "progmem.h"
@@ -60,6 +61,8 @@ void send_string(const char *string);
 /**
  * \brief Type out a string of ASCII characters, with a delay between each character.
  *
+ * With `SEND_STRING_ASYNC` defined, the string is queued and typed out from the main loop, so this returns straight away unless the queue fills up.
+ *
  * \param string The string to type out.
  * \param interval The amount of time, in milliseconds, to wait before typing the next character. Note this can be set to 0 to ensure no delay, regardless of what TAP_CODE_DELAY is set to.
  */
@@ -123,11 +126,88 @@ void send_nibble(uint8_t number);
  */
 void tap_random_base64(void);
 
-#if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Press a key, in turn with anything else being typed out.
+ *
+ * With `SEND_STRING_ASYNC` defined, this is queued behind the strings still being typed, otherwise the key is pressed straight away.
+ *
+ * \param keycode The basic keycode to press.
+ */
+void send_string_register_code(uint8_t keycode);
+
+/**
+ * \brief Release a key, in turn with anything else being typed out.
+ *
+ * \param keycode The basic keycode to release.
+ */
+void send_string_unregister_code(uint8_t keycode);
+
+/**
+ * \brief Tap a key, in turn with anything else being typed out.
+ *
+ * \param keycode The basic keycode to tap. If `keycode` is `KC_CAPS_LOCK`, the delay will be `TAP_HOLD_CAPS_DELAY`, otherwise `TAP_CODE_DELAY`.
+ */
+void send_string_tap_code(uint8_t keycode);
+
+/**
+ * \brief Tap a key with a given delay, in turn with anything else being typed out.
+ *
+ * \param keycode The basic keycode to tap.
+ * \param delay The amount of time, in milliseconds, to hold the key down for.
+ */
+void send_string_tap_code_delay(uint8_t keycode, uint16_t delay);
+
+/**
+ * \brief Pause typing.
+ *
+ * With `SEND_STRING_ASYNC` defined, this delays whatever is queued after it without blocking, otherwise it waits straight away.
+ *
+ * \param ms The amount of time, in milliseconds, to wait.
+ */
+void send_string_wait(uint16_t ms);
+
+/**
+ * \brief Run a function, in turn with anything else being typed out.
+ *
+ * \param callback The function to run. It runs to completion, so should not take long.
+ */
+void send_string_call(void (*callback)(void));
+
+#if defined(SEND_STRING_ASYNC) || defined(__DOXYGEN__)
+/**
+ * \brief Type out whatever is queued. Called from the main loop when `SEND_STRING_ASYNC` is defined.
+ *
+ * Sends at most one report per call, and waits at least `SEND_STRING_REPORT_INTERVAL` milliseconds between reports.
+ */
+void send_string_task(void);
+
+/**
+ * \brief Whether anything is still queued to be typed out.
+ */
+bool send_string_is_busy(void);
+
+/**
+ * \brief Type out a string of ASCII characters stored in EEPROM, with a delay between each character.
+ *
+ * The string is read a character at a time as it is typed out, so it may be of any length.
+ *
+ * \param string The EEPROM address of the string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_with_delay_eeprom(const char *string, uint8_t interval);
+
+#    ifdef TICKLESS_IDLE_ENABLE
+uint32_t send_string_idle_delay(uint32_t delay_ms);
+#    endif
+#endif
+
+#if defined(__AVR__) || defined(SEND_STRING_ASYNC) || defined(__DOXYGEN__)
 /**
  * \brief Type out a PROGMEM string of ASCII characters.
  *
- * On ARM devices, this function is simply an alias for send_string_with_delay(string, 0).
+ * On ARM devices, unless `SEND_STRING_ASYNC` is defined, this function is simply an alias for send_string_with_delay(string, 0).
+ *
+ * With `SEND_STRING_ASYNC` defined, the string is read a character at a time as it is typed out, so it must not be modified or freed until it has been. String literals are always safe to use.
  *
  * \param string The string to type out.
  */
@@ -136,7 +216,7 @@ void send_string_P(const char *string);
 /**
  * \brief Type out a PROGMEM string of ASCII characters, with a delay between each character.
  *
- * On ARM devices, this function is simply an alias for send_string_with_delay(string, interval).
+ * On ARM devices, unless `SEND_STRING_ASYNC` is defined, this function is simply an alias for send_string_with_delay(string, interval).
  *
  * \param string The string to type out.
  * \param interval The amount of time, in milliseconds, to wait before typing the next character.
@@ -150,14 +230,14 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
 /**
  * \brief Shortcut macro for send_string_with_delay_P(PSTR(string), 0).
  *
- * On ARM devices, this define evaluates to send_string_with_delay(string, 0).
+ * On ARM devices, unless `SEND_STRING_ASYNC` is defined, this define evaluates to send_string_with_delay(string, 0).
  */
 #define SEND_STRING(string) send_string_with_delay_P(PSTR(string), 0)
 
 /**
  * \brief Shortcut macro for send_string_with_delay_P(PSTR(string), interval).
  *
- * On ARM devices, this define evaluates to send_string_with_delay(string, interval).
+ * On ARM devices, unless `SEND_STRING_ASYNC` is defined, this define evaluates to send_string_with_delay(string, interval).
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
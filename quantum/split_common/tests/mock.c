@@ -0,0 +1,116 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "crc.h"
+#include "transactions.h"
+#include "transport.h"
+#include "mock.h"
+
+/* Loopback serial transport, both halves live in the same process: the
+ * master uses split_shmem directly, the slave's copy is swapped in while its
+ * callback runs. Bytes are counted as the serial protocol would put them on
+ * the wire, id and handshake included. */
+
+loopback_stats_t             loopback_stats;
+int8_t                       loopback_corrupt_id = -1;
+static split_shared_memory_t slave_shmem;
+
+void loopback_reset(void) {
+    memset(&loopback_stats, 0, sizeof(loopback_stats));
+    loopback_corrupt_id = -1;
+    memset(&slave_shmem, 0, sizeof(slave_shmem));
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    loopback_slave_matrix_changed();
+}
+
+void loopback_slave_matrix_changed(void) {
+    // What the slave's matrix handler does after every scan
+    slave_shmem.smatrix.checksum = crc8(slave_shmem.smatrix.matrix, sizeof(slave_shmem.smatrix.matrix));
+}
+
+void *loopback_slave_shmem(void) {
+    return &slave_shmem;
+}
+
+void soft_serial_initiator_init(void) {}
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    static split_shared_memory_t master_shmem;
+    split_transaction_desc_t    *trans = &split_transaction_table[index];
+
+    loopback_stats.transactions++;
+    loopback_stats.bytes += 2 + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+
+    memcpy(&master_shmem, split_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_shmem, &slave_shmem, sizeof(split_shared_memory_t));
+
+    memcpy(split_trans_initiator2target_buffer(trans), ((uint8_t *)&master_shmem) + trans->initiator2target_offset, trans->initiator2target_buffer_size);
+    if (loopback_corrupt_id == index && trans->initiator2target_buffer_size) {
+        loopback_corrupt_id = -1;
+        split_trans_initiator2target_buffer(trans)[0] ^= 0x01;
+    }
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+
+    memcpy(&slave_shmem, split_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_shmem, &master_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_trans_target2initiator_buffer(trans), ((uint8_t *)&slave_shmem) + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    return true;
+}
+
+uint8_t mock_mods         = 0;
+uint8_t mock_weak_mods    = 0;
+uint8_t mock_oneshot_mods = 0;
+uint8_t mock_host_leds    = 0;
+
+uint8_t  mock_wpm                  = 0;
+uint32_t mock_matrix_activity_time = 0;
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 0;
+
+uint8_t get_mods(void) {
+    return mock_mods;
+}
+uint8_t get_weak_mods(void) {
+    return mock_weak_mods;
+}
+uint8_t get_oneshot_mods(void) {
+    return mock_oneshot_mods;
+}
+void set_mods(uint8_t mods) {}
+void set_weak_mods(uint8_t mods) {}
+void set_oneshot_mods(uint8_t mods) {}
+
+uint8_t host_keyboard_leds(void) {
+    return mock_host_leds;
+}
+void set_split_host_keyboard_leds(uint8_t led_state) {}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+uint32_t sync_timer_read32(void) {
+    return timer_read32();
+}
+void sync_timer_update(uint32_t time) {}
+
+uint8_t get_current_wpm(void) {
+    return mock_wpm;
+}
+void set_current_wpm(uint8_t wpm) {}
+
+uint32_t last_matrix_activity_time(void) {
+    return mock_matrix_activity_time;
+}
+uint32_t last_encoder_activity_time(void) {
+    return 0;
+}
+uint32_t last_pointing_device_activity_time(void) {
+    return 0;
+}
+void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timestamp, uint32_t pointing_device_timestamp) {}
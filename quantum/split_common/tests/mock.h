@@ -0,0 +1,29 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct loopback_stats_t {
+    uint32_t transactions;
+    uint32_t bytes;
+} loopback_stats_t;
+
+extern loopback_stats_t loopback_stats;
+
+/* Flips a bit in the first byte of the next initiator to target buffer of this transaction id, -1 to disable. */
+extern int8_t loopback_corrupt_id;
+
+/* Host side stand-ins for the state the transactions sync. */
+extern uint8_t mock_mods;
+extern uint8_t mock_weak_mods;
+extern uint8_t mock_oneshot_mods;
+extern uint8_t mock_host_leds;
+extern uint8_t  mock_wpm;
+extern uint32_t mock_matrix_activity_time;
+
+void  loopback_reset(void);
+void  loopback_slave_matrix_changed(void);
+void *loopback_slave_shmem(void);
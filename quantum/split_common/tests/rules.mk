@@ -0,0 +1,16 @@
+split_transactions_DEFS :=
+split_transactions_INC := $(QUANTUM_PATH)/split_common
+split_transactions_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+
+split_transactions_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/tests/mock.c \
+	$(QUANTUM_PATH)/split_common/tests/transactions_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/transactions.c
+
+split_transactions_batching_DEFS := -DSPLIT_TRANSPORT_BATCHING
+split_transactions_batching_INC := $(split_transactions_INC)
+split_transactions_batching_CONFIG := $(split_transactions_CONFIG)
+split_transactions_batching_SRC := $(split_transactions_SRC)
@@ -0,0 +1,206 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+// The split transport headers are C only
+#define _Static_assert static_assert
+
+extern "C" {
+#include "transactions.h"
+#include "transport.h"
+#include "timer.h"
+#include "mock.h"
+
+void advance_time(uint32_t ms);
+}
+
+#ifndef FORCED_SYNC_THROTTLE_MS
+#    define FORCED_SYNC_THROTTLE_MS 100
+#endif
+
+class SplitTransactions : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[MATRIX_ROWS / 2] = {0};
+    matrix_row_t slave_matrix[MATRIX_ROWS / 2]  = {0};
+
+    void SetUp() override {
+        timer_init();
+        loopback_reset();
+        layer_state         = 0;
+        default_layer_state = 1;
+        mock_mods           = 0;
+        mock_weak_mods      = 0;
+        mock_oneshot_mods   = 0;
+        mock_host_leds      = 0;
+        mock_wpm            = 0;
+
+        mock_matrix_activity_time = 0;
+    }
+
+    static split_shared_memory_t *slave(void) {
+        return (split_shared_memory_t *)loopback_slave_shmem();
+    }
+
+    uint32_t run_cycle(void) {
+        uint32_t before = loopback_stats.transactions;
+        EXPECT_TRUE(transactions_master(master_matrix, slave_matrix));
+        advance_time(1);
+        return loopback_stats.transactions - before;
+    }
+
+    void expect_synced(void) {
+        EXPECT_EQ(slave()->layers.layer_state, layer_state);
+        EXPECT_EQ(slave()->layers.default_layer_state, default_layer_state);
+        EXPECT_EQ(slave()->mods.real_mods, mock_mods);
+        EXPECT_EQ(slave()->mods.weak_mods, mock_weak_mods);
+        EXPECT_EQ(slave()->mods.oneshot_mods, mock_oneshot_mods);
+        EXPECT_EQ(slave()->led_state, mock_host_leds);
+        EXPECT_EQ(slave()->current_wpm, mock_wpm);
+        EXPECT_EQ(slave()->activity_sync.matrix_timestamp, mock_matrix_activity_time);
+        EXPECT_EQ(memcmp(slave()->mmatrix.matrix, master_matrix, sizeof(master_matrix)), 0);
+    }
+};
+
+TEST_F(SplitTransactions, SyncsMasterState) {
+    run_cycle();
+    expect_synced();
+
+    layer_state      = 0x0104;
+    mock_mods        = 0x02;
+    mock_host_leds   = 0x04;
+    master_matrix[1] = 0x81;
+    run_cycle();
+    expect_synced();
+
+    default_layer_state = 2;
+    mock_oneshot_mods   = 0x10;
+    master_matrix[1]    = 0x00;
+    master_matrix[3]    = 0x40;
+    run_cycle();
+    expect_synced();
+}
+
+TEST_F(SplitTransactions, ReadsSlaveMatrix) {
+    slave()->smatrix.matrix[2] = 0x24;
+    loopback_slave_matrix_changed();
+    run_cycle();
+
+    EXPECT_EQ(slave_matrix[2], 0x24);
+}
+
+TEST_F(SplitTransactions, ForcedSyncRepairsSlave) {
+    layer_state = 0x0F;
+    run_cycle();
+    expect_synced();
+
+    // The slave loses its copy of the data, e.g. after a reset
+    memset(slave(), 0, sizeof(split_shared_memory_t));
+    loopback_slave_matrix_changed();
+    layer_state = 0x1F;
+    run_cycle();
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    run_cycle();
+    expect_synced();
+}
+
+#ifdef SPLIT_TRANSPORT_BATCHING
+
+TEST_F(SplitTransactions, SingleFramePerCycle) {
+    run_cycle();
+
+    // Checksum read for the slave matrix, then a single frame for everything else
+    layer_state      = 0x80;
+    mock_mods        = 0x01;
+    mock_host_leds   = 0x01;
+    mock_wpm         = 10;
+    master_matrix[0] = 0x01;
+    EXPECT_EQ(run_cycle(), 2);
+    expect_synced();
+
+    // Nothing changed, nothing to send
+    EXPECT_EQ(run_cycle(), 1);
+
+    // A lone change goes out on its own transaction
+    mock_wpm = 11;
+    EXPECT_EQ(run_cycle(), 2);
+    expect_synced();
+}
+
+TEST_F(SplitTransactions, OnlyChangedBytesAreSent) {
+    layer_state               = 0x0001;
+    mock_matrix_activity_time = 0x12345678;
+    run_cycle();
+
+    // Only the top byte of the layer state and the lowest byte of the activity timestamp change
+    layer_state               = 0x4001;
+    mock_matrix_activity_time = 0x12345699;
+    run_cycle();
+    expect_synced();
+    EXPECT_EQ(slave()->batch_frame.dirty, ((uint32_t)1 << PUT_LAYER_STATE) | ((uint32_t)1 << PUT_ACTIVITY));
+    EXPECT_EQ(slave()->batch_frame.length, 2 * (2 + 1));
+    EXPECT_EQ(slave()->batch_frame.data[0], 1);
+    EXPECT_EQ(slave()->batch_frame.data[1], 1);
+    EXPECT_EQ(slave()->batch_frame.data[2], 0x40);
+    EXPECT_EQ(slave()->batch_frame.data[3], 0);
+    EXPECT_EQ(slave()->batch_frame.data[4], 1);
+    EXPECT_EQ(slave()->batch_frame.data[5], 0x99);
+}
+
+TEST_F(SplitTransactions, SyncTimerIsNotBatched) {
+    run_cycle();
+
+    // The sync timer is due along with the forced sync, but must not wait for the frame
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    layer_state = 0x02;
+    mock_mods   = 0x04;
+    uint32_t now = timer_read32();
+    run_cycle();
+    expect_synced();
+    EXPECT_NE(slave()->batch_frame.dirty, 0);
+    EXPECT_EQ(slave()->batch_frame.dirty & ((uint32_t)1 << PUT_SYNC_TIMER), 0);
+    EXPECT_GT(slave()->sync_timer, now);
+}
+
+TEST_F(SplitTransactions, CorruptFrameIsRejected) {
+    layer_state = 0x01;
+    run_cycle();
+
+    layer_state         = 0x02;
+    mock_wpm            = 20;
+    loopback_corrupt_id = PUT_BATCH_QUARTER;
+    run_cycle();
+    EXPECT_EQ(slave()->layers.layer_state, 0x01);
+
+    // Recovered by the next forced sync
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    run_cycle();
+    expect_synced();
+}
+
+#endif // SPLIT_TRANSPORT_BATCHING
+
+TEST_F(SplitTransactions, BytesPerCycle) {
+    const uint32_t cycles = 1000;
+
+    run_cycle();
+    loopback_stats.transactions = 0;
+    loopback_stats.bytes        = 0;
+
+    // Typing: every key press updates the mirrored matrix and the activity timestamp, modifiers, layers and WPM change now and then
+    for (uint32_t i = 0; i < cycles; i++) {
+        if (i % 5 == 0) {
+            master_matrix[i % (MATRIX_ROWS / 2)] ^= 1 << (i % MATRIX_COLS);
+            mock_matrix_activity_time = timer_read32();
+        }
+        if (i % 25 == 0) mock_mods ^= 0x02;
+        if (i % 50 == 0) mock_wpm++;
+        if (i % 100 == 0) layer_state ^= 0x02;
+        run_cycle();
+    }
+    expect_synced();
+
+    RecordProperty("cycles", (int)cycles);
+    RecordProperty("transactions", (int)loopback_stats.transactions);
+    RecordProperty("bytes", (int)loopback_stats.bytes);
+}
@@ -97,6 +97,12 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#ifdef SPLIT_TRANSPORT_BATCHING
+    PUT_BATCH_QUARTER,
+    PUT_BATCH_HALF,
+    PUT_BATCH_FULL,
+#endif // SPLIT_TRANSPORT_BATCHING
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
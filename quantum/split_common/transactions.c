@@ -84,7 +84,11 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#ifdef SPLIT_TRANSPORT_BATCHING
+#    define transport_write(id, data, length) transport_batch_write(id, data, length)
+#else // SPLIT_TRANSPORT_BATCHING
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#endif // SPLIT_TRANSPORT_BATCHING
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 #define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
 
@@ -144,6 +148,197 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
+////////////////////////////////////////////////////
+// Batching
+
+#ifdef SPLIT_TRANSPORT_BATCHING
+
+#    if defined(__AVR__) && !defined(USE_I2C)
+#        error "SPLIT_TRANSPORT_BATCHING needs slave callbacks to run after the transaction buffer has been received, which the AVR bitbang serial driver does not do"
+#    endif
+
+_Static_assert(SPLIT_TRANSPORT_BATCH_SIZE >= 16 && SPLIT_TRANSPORT_BATCH_SIZE <= 252 && SPLIT_TRANSPORT_BATCH_SIZE % 4 == 0, "SPLIT_TRANSPORT_BATCH_SIZE must be a multiple of 4 between 16 and 252");
+
+// Transaction ids past the width of the dirty mask are never batched
+#    define BATCH_MAX_TRANSACTIONS (sizeof_member(split_batch_frame_t, dirty) * 8)
+_Static_assert(PUT_BATCH_QUARTER <= BATCH_MAX_TRANSACTIONS, "The built-in split transactions no longer fit in the batch frame's dirty mask");
+
+/* Writes from the master handlers are collected into a single frame that is
+ * sent at the end of the cycle. Every entry only carries the span of the
+ * field that changed since it was last sent, [offset][length][data...], in
+ * ascending transaction id order as flagged by the frame's dirty bits. The
+ * frame goes out on the smallest of three fixed size transactions it fits. */
+static split_batch_frame_t batch_frame;
+static bool                batch_full_sync      = true;
+static uint32_t            batch_last_full_sync = 0;
+
+static bool batch_supported(int8_t id) {
+    if (id >= BATCH_MAX_TRANSACTIONS) return false;
+
+#    ifndef DISABLE_SYNC_TIMER
+    // The slave clock is set from this value, it has to arrive as soon as it is read
+    if (id == PUT_SYNC_TIMER) return false;
+#    endif // DISABLE_SYNC_TIMER
+
+#    if defined(SPLIT_WATCHDOG_ENABLE)
+    // The watchdog is only fed once the slave has actually seen the ping
+    if (id == PUT_WATCHDOG) return false;
+#    endif // defined(SPLIT_WATCHDOG_ENABLE)
+
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // RPC sizes change at runtime, keep them on their own transactions
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+    // Only plain writes can be deferred, anything with a callback or response needs its own round trip
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    return trans->initiator2target_buffer_size > 0 && trans->target2initiator_buffer_size == 0 && !trans->slave_callback;
+}
+
+static bool batch_flush(void) {
+    if (!batch_frame.dirty) {
+        return true;
+    }
+
+    bool okay;
+    if (!(batch_frame.dirty & (batch_frame.dirty - 1))) {
+        // A single field is cheaper to send on its own transaction, the shadow copy already holds all of it
+        int8_t id = 0;
+        while (!(batch_frame.dirty & ((uint32_t)1 << id))) {
+            id++;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        okay                            = transport_execute_transaction(id, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, NULL, 0);
+    } else {
+        uint8_t size = offsetof(split_batch_frame_t, data) + batch_frame.length;
+        int8_t  id   = size <= sizeof(split_batch_frame_t) / 4 ? PUT_BATCH_QUARTER : size <= sizeof(split_batch_frame_t) / 2 ? PUT_BATCH_HALF : PUT_BATCH_FULL;
+
+        batch_frame.checksum = crc8(&batch_frame.length, size - offsetof(split_batch_frame_t, length));
+        okay                 = transport_execute_transaction(id, &batch_frame, split_transaction_table[id].initiator2target_buffer_size, NULL, 0);
+    }
+
+    if (okay) {
+        batch_frame.dirty  = 0;
+        batch_frame.length = 0;
+    }
+    return okay;
+}
+
+static bool transport_batch_write(int8_t id, const void *data, uint16_t length) {
+    if (!batch_supported(id)) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+
+    if (!batch_full_sync && timer_elapsed32(batch_last_full_sync) >= FORCED_SYNC_THROTTLE_MS) {
+        batch_full_sync = true;
+    }
+
+    split_transaction_desc_t *trans  = &split_transaction_table[id];
+    uint8_t                  *shadow = split_trans_initiator2target_buffer(trans);
+    const uint8_t            *source = data;
+    uint8_t                   size   = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+
+    // Delta against the last value sent, unchanged data is a forced sync and goes out in full
+    uint8_t start = 0;
+    uint8_t end   = size;
+    if (!batch_full_sync) {
+        while (start < end && source[start] == shadow[start]) {
+            start++;
+        }
+        while (end > start && source[end - 1] == shadow[end - 1]) {
+            end--;
+        }
+        if (start == end) {
+            start = 0;
+            end   = size;
+        }
+    }
+
+    uint8_t entry_length = 2 + end - start;
+    if (entry_length > sizeof(batch_frame.data)) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+
+    // Each id may only appear once per frame, in ascending order
+    if ((batch_frame.dirty >> id) || batch_frame.length + entry_length > sizeof(batch_frame.data)) {
+        if (!batch_flush()) {
+            return false;
+        }
+    }
+
+    uint8_t *entry = &batch_frame.data[batch_frame.length];
+    entry[0]       = start;
+    entry[1]       = end - start;
+    memcpy(&entry[2], &source[start], end - start);
+    batch_frame.length += entry_length;
+    batch_frame.dirty |= (uint32_t)1 << id;
+
+    if (shadow != source) {
+        memcpy(shadow, source, size);
+    }
+    return true;
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool full_sync = batch_full_sync;
+    if (!batch_flush()) {
+        return false;
+    }
+
+    if (full_sync) {
+        batch_full_sync      = false;
+        batch_last_full_sync = timer_read32();
+    }
+    return true;
+}
+
+static void batch_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_batch_frame_t *frame = &split_shmem->batch_frame;
+
+    uint8_t size = offsetof(split_batch_frame_t, data) + frame->length;
+    if (size > initiator2target_buffer_size || crc8(&frame->length, size - offsetof(split_batch_frame_t, length)) != frame->checksum) {
+        return;
+    }
+
+    uint8_t position = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS && id < BATCH_MAX_TRANSACTIONS; id++) {
+        if (!(frame->dirty & ((uint32_t)1 << id))) {
+            continue;
+        }
+        if (position + 2 > frame->length || !batch_supported(id)) {
+            return;
+        }
+
+        split_transaction_desc_t *trans  = &split_transaction_table[id];
+        uint8_t                   offset = frame->data[position];
+        uint8_t                   size   = frame->data[position + 1];
+        if (position + 2 + size > frame->length || offset + size > trans->initiator2target_buffer_size) {
+            return;
+        }
+
+        memcpy(split_trans_initiator2target_buffer(trans) + offset, &frame->data[position + 2], size);
+        position += 2 + size;
+    }
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [PUT_BATCH_QUARTER] = { sizeof(split_batch_frame_t) / 4, offsetof(split_shared_memory_t, batch_frame), 0, 0, batch_handlers_slave }, \
+    [PUT_BATCH_HALF]    = { sizeof(split_batch_frame_t) / 2, offsetof(split_shared_memory_t, batch_frame), 0, 0, batch_handlers_slave }, \
+    [PUT_BATCH_FULL]    = trans_initiator2target_initializer_cb(batch_frame, batch_handlers_slave),
+// clang-format on
+
+#else // SPLIT_TRANSPORT_BATCHING
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_BATCHING
+
+////////////////////////////////////////////////////
+// Sync helpers
+
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
@@ -938,6 +1133,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -968,6 +1164,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_BATCH_MASTER();
     return true;
 }
 
@@ -20,6 +20,7 @@
 #include <stdbool.h>
 
 #include "progmem.h"
+#include "util.h"
 #include "action_layer.h"
 #include "matrix.h"
 
@@ -31,6 +32,10 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifndef SPLIT_TRANSPORT_BATCH_SIZE
+#    define SPLIT_TRANSPORT_BATCH_SIZE 64
+#endif // SPLIT_TRANSPORT_BATCH_SIZE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -146,6 +151,15 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_BATCHING
+typedef struct PACKED _split_batch_frame_t {
+    uint8_t  checksum; // crc8 of everything after it, up to the last used byte of data
+    uint8_t  length;   // used bytes of data
+    uint32_t dirty;    // one bit per transaction id present in the frame
+    uint8_t  data[SPLIT_TRANSPORT_BATCH_SIZE - 6];
+} split_batch_frame_t;
+#endif // SPLIT_TRANSPORT_BATCHING
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -221,6 +235,10 @@ typedef struct _split_shared_memory_t {
     split_slave_activity_sync_t activity_sync;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_BATCHING
+    split_batch_frame_t batch_frame;
+#endif // SPLIT_TRANSPORT_BATCHING
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
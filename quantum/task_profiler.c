@@ -0,0 +1,180 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "task_profiler.h"
+#include "timer.h"
+#include "print.h"
+#ifdef RAW_ENABLE
+#    include "raw_hid.h"
+#endif
+#ifdef PROTOCOL_CHIBIOS
+#    include <hal.h>
+#endif
+
+// Interval in milliseconds at which the dump is printed to the console, 0 to disable
+#ifndef TASK_PROFILER_CONSOLE_INTERVAL
+#    define TASK_PROFILER_CONSOLE_INTERVAL 0
+#endif
+
+#if defined(PROTOCOL_CHIBIOS) && defined(PORT_SUPPORTS_RT) && (PORT_SUPPORTS_RT == TRUE)
+#    ifndef TASK_PROFILER_TIMESTAMP_FREQUENCY
+#        if defined(STM32_HCLK)
+#            define TASK_PROFILER_TIMESTAMP_FREQUENCY STM32_HCLK
+#        else
+#            define TASK_PROFILER_TIMESTAMP_FREQUENCY 0
+#        endif
+#    endif
+
+__attribute__((weak)) uint32_t task_profiler_timestamp(void) {
+    return (uint32_t)chSysGetRealtimeCounterX();
+}
+#else
+// No cycle counter available, fall back to the millisecond timer
+#    ifndef TASK_PROFILER_TIMESTAMP_FREQUENCY
+#        define TASK_PROFILER_TIMESTAMP_FREQUENCY 1000
+#    endif
+
+__attribute__((weak)) uint32_t task_profiler_timestamp(void) {
+    return timer_read32();
+}
+#endif
+
+__attribute__((weak)) uint32_t task_profiler_timestamp_frequency(void) {
+    return TASK_PROFILER_TIMESTAMP_FREQUENCY;
+}
+
+static task_profiler_dump_t profile;
+static bool                 profiler_enabled  = true;
+static bool                 key_event_pending = false;
+static uint32_t             key_event_timestamp;
+
+void task_profiler_reset(void) {
+    memset(profile.slots, 0, sizeof(profile.slots));
+    key_event_pending = false;
+}
+
+void task_profiler_init(void) {
+    profile.magic[0]            = 'T';
+    profile.magic[1]            = 'P';
+    profile.version             = TASK_PROFILER_DUMP_VERSION;
+    profile.slot_count          = TASK_PROFILER_SLOT_COUNT;
+    profile.bucket_count        = TASK_PROFILER_BUCKETS;
+    profile.bucket_shift        = TASK_PROFILER_BUCKET_SHIFT;
+    profile.timestamp_frequency = task_profiler_timestamp_frequency();
+    task_profiler_reset();
+}
+
+void task_profiler_set_enabled(bool enabled) {
+    profiler_enabled = enabled;
+    key_event_pending = false;
+}
+
+bool task_profiler_is_enabled(void) {
+    return profiler_enabled;
+}
+
+void task_profiler_record(task_profiler_slot_t slot, uint32_t duration) {
+    if (!profiler_enabled || slot >= TASK_PROFILER_SLOT_COUNT) {
+        return;
+    }
+
+    task_profiler_histogram_t *histogram = &profile.slots[slot];
+    uint32_t                   scaled    = duration >> TASK_PROFILER_BUCKET_SHIFT;
+    uint8_t                    bucket    = 0;
+    while (scaled && bucket < TASK_PROFILER_BUCKETS - 1) {
+        scaled >>= 1;
+        bucket++;
+    }
+
+    // Saturate rather than wrap, a full bucket still shows where the time goes
+    if (histogram->buckets[bucket] != UINT16_MAX) {
+        histogram->buckets[bucket]++;
+    }
+    if (histogram->samples != UINT32_MAX) {
+        histogram->samples++;
+    }
+    if (duration > histogram->max) {
+        histogram->max = duration;
+    }
+}
+
+void task_profiler_key_event(void) {
+    key_event_timestamp = task_profiler_timestamp();
+    key_event_pending   = true;
+}
+
+void task_profiler_report_sent(void) {
+    if (key_event_pending) {
+        key_event_pending = false;
+        task_profiler_record(TASK_PROFILER_KEY_LATENCY, task_profiler_timestamp() - key_event_timestamp);
+    }
+}
+
+uint16_t task_profiler_dump_size(void) {
+    return sizeof(profile);
+}
+
+uint16_t task_profiler_read_dump(uint16_t offset, uint8_t *data, uint16_t size) {
+    if (offset >= sizeof(profile)) {
+        return 0;
+    }
+    if (size > sizeof(profile) - offset) {
+        size = sizeof(profile) - offset;
+    }
+    memcpy(data, ((const uint8_t *)&profile) + offset, size);
+    return size;
+}
+
+void task_profiler_print(void) {
+    // One line per 16 bytes, prefixed with the offset, so the host can reassemble the dump from console output
+    uint8_t chunk[16];
+    for (uint16_t offset = 0; offset < sizeof(profile); offset += sizeof(chunk)) {
+        uint16_t length = task_profiler_read_dump(offset, chunk, sizeof(chunk));
+        xprintf("task_profiler:%04X:", offset);
+        for (uint16_t i = 0; i < length; i++) {
+            xprintf("%02X", chunk[i]);
+        }
+        xprintf("\n");
+    }
+    xprintf("task_profiler:end\n");
+}
+
+void task_profiler_task(void) {
+#if TASK_PROFILER_CONSOLE_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= TASK_PROFILER_CONSOLE_INTERVAL) {
+        last_print = timer_read32();
+        task_profiler_print();
+    }
+#endif
+}
+
+#ifdef RAW_ENABLE
+bool task_profiler_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 4 || data[0] != TASK_PROFILER_RAW_HID_ID) {
+        return false;
+    }
+
+    uint16_t offset = (data[2] << 8) | data[3];
+    switch (data[1]) {
+        case 0x01:
+            memset(&data[4], 0, length - 4);
+            task_profiler_read_dump(offset, &data[4], length - 4);
+            break;
+        case 0x02:
+            task_profiler_reset();
+            break;
+        case 0x03:
+            task_profiler_set_enabled(length > 4 && data[4]);
+            break;
+        default:
+            // Unknown command, reply with the id cleared
+            data[0] = 0xFF;
+            break;
+    }
+
+    raw_hid_send(data, length);
+    return true;
+}
+#endif
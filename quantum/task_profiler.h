@@ -0,0 +1,137 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "util.h"
+
+/*
+    Records how long each task of the main loop takes, as log2 histograms of
+    timestamp counter ticks, and how long it takes from a key event reaching
+    action_exec() until the next keyboard report is sent.
+
+    The collected data can be read as a compact binary dump, either over raw
+    HID through task_profiler_raw_hid_receive(), or printed to the console with
+    task_profiler_print(). `qmk decode-task-profile` turns it back into a table.
+*/
+
+// Number of histogram buckets per task
+#ifndef TASK_PROFILER_BUCKETS
+#    define TASK_PROFILER_BUCKETS 16
+#endif
+
+// Bucket 0 holds durations below (1 << TASK_PROFILER_BUCKET_SHIFT) ticks, every further bucket doubles the range
+#ifndef TASK_PROFILER_BUCKET_SHIFT
+#    define TASK_PROFILER_BUCKET_SHIFT 6
+#endif
+
+// First byte of raw HID packets handled by task_profiler_raw_hid_receive()
+#ifndef TASK_PROFILER_RAW_HID_ID
+#    define TASK_PROFILER_RAW_HID_ID 0xFE
+#endif
+
+#define TASK_PROFILER_DUMP_VERSION 1
+
+/* The numbering is part of the dump format, only ever append to this list. */
+typedef enum task_profiler_slot_t {
+    TASK_PROFILER_MAIN_LOOP,
+    TASK_PROFILER_KEY_LATENCY,
+    TASK_PROFILER_MATRIX_TASK,
+    TASK_PROFILER_QUANTUM_TASK,
+    TASK_PROFILER_SPLIT_WATCHDOG_TASK,
+    TASK_PROFILER_RGBLIGHT_TASK,
+    TASK_PROFILER_LED_MATRIX_TASK,
+    TASK_PROFILER_RGB_MATRIX_TASK,
+    TASK_PROFILER_BACKLIGHT_TASK,
+    TASK_PROFILER_ENCODER_TASK,
+    TASK_PROFILER_POINTING_DEVICE_TASK,
+    TASK_PROFILER_OLED_TASK,
+    TASK_PROFILER_ST7565_TASK,
+    TASK_PROFILER_MOUSEKEY_TASK,
+    TASK_PROFILER_PS2_MOUSE_TASK,
+    TASK_PROFILER_MIDI_TASK,
+    TASK_PROFILER_JOYSTICK_TASK,
+    TASK_PROFILER_BLUETOOTH_TASK,
+    TASK_PROFILER_HAPTIC_TASK,
+    TASK_PROFILER_LED_TASK,
+    TASK_PROFILER_OS_DETECTION_TASK,
+    TASK_PROFILER_QP_INTERNAL_TASK,
+    TASK_PROFILER_DEFERRED_EXEC_TASK,
+    TASK_PROFILER_HOUSEKEEPING_TASK,
+    TASK_PROFILER_SLOT_COUNT,
+} task_profiler_slot_t;
+
+typedef struct PACKED task_profiler_histogram_t {
+    uint32_t samples;
+    uint32_t max;
+    uint16_t buckets[TASK_PROFILER_BUCKETS];
+} task_profiler_histogram_t;
+
+/* In-memory layout is the dump format, all fields are little endian. */
+typedef struct PACKED task_profiler_dump_t {
+    uint8_t                   magic[2];
+    uint8_t                   version;
+    uint8_t                   slot_count;
+    uint8_t                   bucket_count;
+    uint8_t                   bucket_shift;
+    uint32_t                  timestamp_frequency;
+    task_profiler_histogram_t slots[TASK_PROFILER_SLOT_COUNT];
+} task_profiler_dump_t;
+
+/**
+ * @brief Current value of the fastest free running counter available, see task_profiler_timestamp_frequency().
+ */
+uint32_t task_profiler_timestamp(void);
+
+/**
+ * @brief Frequency of task_profiler_timestamp() in Hz, 0 if unknown.
+ */
+uint32_t task_profiler_timestamp_frequency(void);
+
+void task_profiler_init(void);
+void task_profiler_task(void);
+void task_profiler_record(task_profiler_slot_t slot, uint32_t duration);
+void task_profiler_reset(void);
+void task_profiler_set_enabled(bool enabled);
+bool task_profiler_is_enabled(void);
+
+/**
+ * @brief Marks the arrival of a key event, the next keyboard report completes the latency measurement.
+ */
+void task_profiler_key_event(void);
+
+/**
+ * @brief Called whenever a keyboard report is sent to the host.
+ */
+void task_profiler_report_sent(void);
+
+uint16_t task_profiler_dump_size(void);
+uint16_t task_profiler_read_dump(uint16_t offset, uint8_t *data, uint16_t size);
+void     task_profiler_print(void);
+
+/**
+ * @brief Handles task profiler requests. Called by VIA and the default raw_hid_receive(), a keymap that
+ * implements raw_hid_receive() itself has to call it from there.
+ *
+ * Request: TASK_PROFILER_RAW_HID_ID, command, offset high, offset low, [value]
+ * Commands: 0x01 read dump at offset, 0x02 reset, 0x03 enable (value 1) or pause (value 0)
+ *
+ * @return true if the packet was a task profiler request and a reply was sent
+ */
+bool task_profiler_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#ifdef TASK_PROFILER_ENABLE
+#    define TASK_PROFILE(slot, call)                                                       \
+        do {                                                                               \
+            uint32_t task_profiler_start = task_profiler_timestamp();                      \
+            call;                                                                          \
+            task_profiler_record((slot), task_profiler_timestamp() - task_profiler_start); \
+        } while (0)
+#else
+#    define TASK_PROFILE(slot, call) \
+        do {                         \
+            call;                    \
+        } while (0)
+#endif
@@ -0,0 +1,157 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+#include "keyboard.h"
+#include "matrix.h"
+#include "timer.h"
+#include "util.h"
+
+#ifdef SPLIT_KEYBOARD
+#    error "Tickless idle is not supported on split keyboards, the transport needs polling"
+#endif
+
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+#ifndef NO_ACTION_TAPPING
+#    include "action.h"
+#    include "action_tapping.h"
+#endif
+#ifdef COMBO_ENABLE
+#    include "process_combo.h"
+#endif
+#ifdef RGBLIGHT_ENABLE
+#    include "rgblight.h"
+#endif
+#ifdef LED_MATRIX_ENABLE
+#    include "led_matrix.h"
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+#    include "send_string.h"
+#endif
+#if !defined(NO_ACTION_ONESHOT) && (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+#    include "action_util.h"
+#endif
+#ifdef CAPS_WORD_ENABLE
+#    include "caps_word.h"
+#endif
+#ifdef TAP_DANCE_ENABLE
+#    include "process_tap_dance.h"
+#endif
+#ifdef OLED_ENABLE
+#    include "oled_driver.h"
+#endif
+#ifdef QUANTUM_PAINTER_ENABLE
+uint32_t qp_internal_idle_delay(uint32_t delay_ms);
+#endif
+
+// Time the matrix last woke the keyboard up
+static uint32_t last_wake_time = 0;
+
+__attribute__((weak)) bool matrix_idle_arm(void) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_idle_disarm(void) {}
+
+__attribute__((weak)) uint32_t tickless_idle_delay_kb(uint32_t delay_ms) {
+    return tickless_idle_delay_user(delay_ms);
+}
+
+__attribute__((weak)) uint32_t tickless_idle_delay_user(uint32_t delay_ms) {
+    return delay_ms;
+}
+
+uint32_t tickless_idle_until(uint32_t delay_ms, uint32_t deadline) {
+    int32_t remaining = (int32_t)TIMER_DIFF_32(deadline, timer_read32());
+    if (remaining <= 0) {
+        return 0;
+    }
+    return MIN(delay_ms, (uint32_t)remaining);
+}
+
+uint32_t tickless_idle_delay(void) {
+#if defined(ENCODER_ENABLE) || defined(POINTING_DEVICE_ENABLE)
+    // Encoders and pointing devices are polled, so they can't wake the keyboard up
+    return 0;
+#else
+    // Keep scanning at full rate for a while after any activity, so debouncing and whatever else follows sees every scan
+    if (last_input_activity_elapsed() < TICKLESS_IDLE_TIMEOUT || timer_elapsed32(last_wake_time) < TICKLESS_IDLE_TIMEOUT) {
+        return 0;
+    }
+
+    // Held keys need scanning until they are released
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return 0;
+        }
+    }
+
+    uint32_t delay_ms = TICKLESS_IDLE_MAX_SLEEP;
+
+#    ifdef DEFERRED_EXEC_ENABLE
+    uint32_t trigger_time;
+    if (deferred_exec_next_trigger(&trigger_time)) {
+        delay_ms = tickless_idle_until(delay_ms, trigger_time);
+    }
+#    endif
+#    ifndef NO_ACTION_TAPPING
+    delay_ms = action_tapping_idle_delay(delay_ms);
+#    endif
+#    ifdef COMBO_ENABLE
+    delay_ms = combo_idle_delay(delay_ms);
+#    endif
+#    ifdef RGBLIGHT_ENABLE
+    delay_ms = rgblight_idle_delay(delay_ms);
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    delay_ms = led_matrix_idle_delay(delay_ms);
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    delay_ms = rgb_matrix_idle_delay(delay_ms);
+#    endif
+#    if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+    delay_ms = send_string_idle_delay(delay_ms);
+#    endif
+#    if !defined(NO_ACTION_ONESHOT) && (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+    delay_ms = oneshot_idle_delay(delay_ms);
+#    endif
+#    ifdef CAPS_WORD_ENABLE
+    delay_ms = caps_word_idle_delay(delay_ms);
+#    endif
+#    ifdef TAP_DANCE_ENABLE
+    delay_ms = tap_dance_idle_delay(delay_ms);
+#    endif
+#    ifdef OLED_ENABLE
+    delay_ms = oled_idle_delay(delay_ms);
+#    endif
+#    ifdef QUANTUM_PAINTER_ENABLE
+    delay_ms = qp_internal_idle_delay(delay_ms);
+#    endif
+
+    return MIN(delay_ms, tickless_idle_delay_kb(delay_ms));
+#endif
+}
+
+void tickless_idle_task(void) {
+    uint32_t delay_ms = tickless_idle_delay();
+    if (delay_ms < TICKLESS_IDLE_MIN_SLEEP) {
+        return;
+    }
+
+    // Arming fails if a key went down since the last scan, in which case it needs scanning straight away, or if the
+    // matrix pins can't all raise a pin change, in which case it keeps polling
+    if (!matrix_idle_arm()) {
+        return;
+    }
+    bool woken = tickless_idle_sleep(delay_ms);
+    matrix_idle_disarm();
+
+    if (woken) {
+        last_wake_time = timer_read32();
+    }
+}
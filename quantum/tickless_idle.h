@@ -0,0 +1,103 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "gpio.h"
+
+/**
+ * @def How long to keep scanning at full rate after any input activity, or after being woken by the matrix.
+ */
+#ifndef TICKLESS_IDLE_TIMEOUT
+#    define TICKLESS_IDLE_TIMEOUT 50
+#endif
+
+/**
+ * @def The longest the keyboard sleeps in one go, bounding the latency of anything that is polled without a deadline.
+ */
+#ifndef TICKLESS_IDLE_MAX_SLEEP
+#    define TICKLESS_IDLE_MAX_SLEEP 50
+#endif
+
+/**
+ * @def Sleeps shorter than this are skipped, as arming the matrix costs more than it saves.
+ */
+#ifndef TICKLESS_IDLE_MIN_SLEEP
+#    define TICKLESS_IDLE_MIN_SLEEP 2
+#endif
+
+/**
+ * Sleeps until the next deadline or matrix activity, if the keyboard is idle. Called from the main loop.
+ */
+void tickless_idle_task(void);
+
+/**
+ * Works out how long the keyboard may sleep for.
+ *
+ * @return the number of milliseconds until something needs to run, or zero if the keyboard is not idle
+ */
+uint32_t tickless_idle_delay(void);
+
+/**
+ * Keyboard and user hooks to shorten the sleep, for anything that needs polling or has its own timers.
+ *
+ * @param delay_ms[in] the sleep duration determined so far
+ * @return the sleep duration to use -- return values larger than delay_ms are ignored
+ */
+uint32_t tickless_idle_delay_kb(uint32_t delay_ms);
+uint32_t tickless_idle_delay_user(uint32_t delay_ms);
+
+/**
+ * Shortens a sleep so that it ends at the given time.
+ *
+ * @param delay_ms[in] the sleep duration determined so far
+ * @param deadline[in] the time, in the same time-space as timer_read32(), something needs to run
+ * @return the shorter of the two
+ */
+uint32_t tickless_idle_until(uint32_t delay_ms, uint32_t deadline);
+
+/**
+ * Puts the matrix into a state where any key press raises a pin change, by selecting every row (or column) at once.
+ *
+ * @return true if the matrix was armed, false if a key is already down or the matrix does not support it
+ */
+bool matrix_idle_arm(void);
+
+/**
+ * Restores the matrix after matrix_idle_arm(), ready for scanning.
+ */
+void matrix_idle_disarm(void);
+
+//------------------------------------
+// Platform hooks
+//------------------------------------
+
+/**
+ * Sleeps until the timeout expires, or an armed pin changes.
+ *
+ * @param timeout_ms[in] the maximum number of milliseconds to sleep
+ * @return true if a pin change or tickless_idle_wake_from_isr() ended the sleep early
+ */
+bool tickless_idle_sleep(uint32_t timeout_ms);
+
+/**
+ * Ends the current tickless_idle_sleep() early, or the next one straight away. Called from interrupts that hand work
+ * to the main loop, such as USB OUT packets.
+ */
+void tickless_idle_wake_from_isr(void);
+
+#if __has_include("_pin_defs.h")
+/**
+ * Arms or disarms a pin so that a change in its level ends tickless_idle_sleep().
+ */
+void tickless_idle_wake_on_pin(pin_t pin, bool enable);
+
+/**
+ * Checks whether two pins share a pin change interrupt, in which case only one of them can wake the keyboard.
+ *
+ * @return true if the pins cannot both be armed at once
+ */
+bool tickless_idle_pins_conflict(pin_t a, pin_t b);
+#endif
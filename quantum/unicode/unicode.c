@@ -317,7 +317,7 @@ static void send_nibble_wrapper(uint8_t digit) {
         uint8_t kc = digit < 10
                    ? KC_KP_1 + (10 + digit - 1) % 10
                    : KC_A + (digit - 10);
-        tap_code(kc);
+        send_string_tap_code(kc);
         return;
     }
     send_nibble(digit);
@@ -363,7 +363,8 @@ void register_unicode(uint32_t code_point) {
         return;
     }
 
-    unicode_input_start();
+    // Goes through the send_string queue along with the digits, so it stays in order when typing is asynchronous
+    send_string_call(unicode_input_start);
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
@@ -373,7 +374,7 @@ void register_unicode(uint32_t code_point) {
     } else {
         register_hex32(code_point);
     }
-    unicode_input_finish();
+    send_string_call(unicode_input_finish);
 }
 
 void send_unicode_string(const char *str) {
@@ -12,17 +12,23 @@ void MockBackingStore::reset_instance() {
     for (auto&& e : backing_storage)
         e.reset();
 
-    locked = true;
+    locked      = true;
+    powered_off = false;
 
     backing_erasure_count     = 0;
     backing_max_write_count   = 0;
     backing_total_write_count = 0;
 
-    backing_init_invoke_count   = 0;
-    backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
+    backing_init_invoke_count       = 0;
+    backing_unlock_invoke_count     = 0;
+    backing_erase_invoke_count      = 0;
+    backing_erase_bank_invoke_count = 0;
+    backing_write_invoke_count      = 0;
+    backing_lock_invoke_count       = 0;
+    backing_read_invoke_count       = 0;
+
+    backing_operation_count = 0;
+    power_loss_operation    = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -65,6 +71,11 @@ bool MockBackingStore::erase(void) {
             return false;
         }
 
+        // Losing power part way through leaves the rest of the backing store as it was
+        if (!has_power()) {
+            return false;
+        }
+
         backing_storage[i].erase();
     }
 
@@ -75,6 +86,39 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+bool MockBackingStore::erase_bank(std::uint8_t bank, std::uint32_t& offset) {
+    ++backing_erase_bank_invoke_count;
+
+    EXPECT_TRUE(bank < 2) << "Attempted to erase a bank which doesn't exist";
+    EXPECT_FALSE(is_locked()) << "Bank erase was attempted without being unlocked first";
+    EXPECT_TRUE(offset % MOCK_BANK_SECTOR_SIZE::value == 0) << "Bank erase was attempted part way through a sector";
+    EXPECT_TRUE(offset < WEAR_LEVELING_BANK_SIZE) << "Bank erase was attempted past the end of the bank";
+
+    // Erases a single sector per call
+    const std::size_t first = (bank * WEAR_LEVELING_BANK_SIZE + offset) / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = first; i < first + MOCK_BANK_SECTOR_SIZE::value / BACKING_STORE_WRITE_SIZE; ++i) {
+        // Drop out of erase early with failure if we need to
+        if (erase_success_callback && !erase_success_callback(backing_erase_bank_invoke_count)) {
+            return false;
+        }
+
+        // Losing power part way through leaves the rest of the bank as it was
+        if (!has_power()) {
+            return false;
+        }
+
+        backing_storage[i].erase();
+    }
+
+    offset += MOCK_BANK_SECTOR_SIZE::value;
+    if (offset >= WEAR_LEVELING_BANK_SIZE) {
+        ++backing_erasure_count;
+    }
+    return true;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -88,6 +132,11 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
         return false;
     }
 
+    // Once power is lost, nothing more gets written
+    if (!has_power()) {
+        return false;
+    }
+
     // Write the complement as we're simulating flash memory -- 0xFF means 0x00
     std::size_t index = address / BACKING_STORE_WRITE_SIZE;
     backing_storage[index].set(~value);
@@ -114,6 +163,8 @@ bool MockBackingStore::lock(void) {
 }
 
 bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const {
+    ++backing_read_invoke_count;
+
     // precondition: value's buffer size already matches BACKING_STORE_WRITE_SIZE
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
@@ -141,6 +192,12 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+extern "C" bool backing_store_erase_bank(uint8_t bank, uint32_t* offset) {
+    return MockBackingStore::Instance().erase_bank(bank, *offset);
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
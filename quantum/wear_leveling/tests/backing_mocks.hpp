@@ -21,6 +21,11 @@ using MOCK_WRITE_LOG_MAX_ENTRIES = std::integral_constant<std::size_t, 1024>;
 using BACKING_STORE_INTEGRAL_COMPLEMENT = std::integral_constant<backing_store_int_t, ((backing_store_int_t)(~(backing_store_int_t)0))>;
 // Total number of elements stored in the backing arrays
 using BACKING_STORE_ELEMENT_COUNT = std::integral_constant<std::size_t, (WEAR_LEVELING_BACKING_SIZE / sizeof(backing_store_int_t))>;
+#ifdef WEAR_LEVELING_DUAL_BANK
+// Number of sectors each bank is erased in, one per call to backing_store_erase_bank()
+using MOCK_BANK_SECTOR_COUNT = std::integral_constant<std::size_t, 4>;
+using MOCK_BANK_SECTOR_SIZE  = std::integral_constant<std::size_t, (WEAR_LEVELING_BANK_SIZE / MOCK_BANK_SECTOR_COUNT::value)>;
+#endif // WEAR_LEVELING_DUAL_BANK
 
 class MockBackingStoreElement {
    private:
@@ -79,6 +84,8 @@ class MockBackingStore {
 
     // Whether the backing store is locked
     bool locked;
+    // Whether power has been lost, after which no writes or erases take effect
+    bool powered_off;
     // The actual data stored in the emulated flash
     storage_t backing_storage;
     // The number of erase cycles that have occurred
@@ -90,12 +97,20 @@ class MockBackingStore {
     // The write log for the backing store
     std::vector<MockBackingStoreLogEntry> write_log;
 
+    // The number of element writes and erases that have been performed, successful or not
+    std::uint64_t backing_operation_count;
+    // The number of element writes and erases after which power is lost, or zero to keep the power on
+    std::uint64_t power_loss_operation;
+
     // The number of times each API was invoked
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_bank_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    // Reads don't change the backing store, but are still counted
+    mutable std::uint64_t backing_read_invoke_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -108,6 +123,15 @@ class MockBackingStore {
     // Whether locks should succeed
     std::function<bool(std::uint64_t)> lock_success_callback;
 
+    // Counts an element write or erase, and whether it happens before power is lost
+    bool has_power() {
+        ++backing_operation_count;
+        if (power_loss_operation != 0 && backing_operation_count >= power_loss_operation) {
+            powered_off = true;
+        }
+        return !powered_off;
+    }
+
     template <typename... Args>
     void append_log(Args&&... args) {
         if (write_log.size() < MOCK_WRITE_LOG_MAX_ENTRIES::value) {
@@ -141,12 +165,18 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_bank_invoke_count() const {
+        return backing_erase_bank_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -155,10 +185,29 @@ class MockBackingStore {
         return locked;
     }
 
+    // Simulates losing power just before the given element write or erase, counting from 1, such that it and every
+    // later write or erase has no effect. Zero keeps the power on.
+    void set_power_loss_at(std::uint64_t operation) {
+        power_loss_operation = operation;
+    }
+    // Restores power, as if the keyboard was plugged back in
+    void restore_power() {
+        powered_off          = false;
+        power_loss_operation = 0;
+    }
+    bool power_lost() const {
+        return powered_off;
+    }
+    // The number of element writes and erases so far, to find every point at which power can be lost
+    std::uint64_t operation_count() const {
+        return backing_operation_count;
+    }
+
     // APIs for the backing store
     bool init();
     bool unlock();
     bool erase();
+    bool erase_bank(std::uint8_t bank, std::uint32_t& offset);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -63,4 +63,90 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_dual_bank_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DWEAR_LEVELING_DUAL_BANK_PAGE_SIZE=16 \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64
+wear_leveling_dual_bank_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_dual_bank.cpp
+wear_leveling_dual_bank_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_dual_bank_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DWEAR_LEVELING_DUAL_BANK_PAGE_SIZE=16 \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=512 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64
+wear_leveling_dual_bank_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_dual_bank.cpp
+wear_leveling_dual_bank_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_dual_bank_checkpoint_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_DUAL_BANK \
+	-DWEAR_LEVELING_DUAL_BANK_PAGE_SIZE=16 \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=64 \
+	-DPOWER_LOSS_SCENARIO_WRITES=200 \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=512 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32
+wear_leveling_dual_bank_checkpoint_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_dual_bank.cpp
+wear_leveling_dual_bank_checkpoint_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_checkpoint_2byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=128 \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64
+wear_leveling_checkpoint_2byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_checkpoint.cpp
+wear_leveling_checkpoint_2byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_checkpoint_8byte_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=128 \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64
+wear_leveling_checkpoint_8byte_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_checkpoint.cpp
+wear_leveling_checkpoint_8byte_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_benchmark_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=16384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024
+wear_leveling_benchmark_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_benchmark.cpp \
+	tests/benchmark/benchmark_timer.cpp
+wear_leveling_benchmark_INC := \
+	$(wear_leveling_common_INC) \
+	tests/benchmark
+
+wear_leveling_benchmark_checkpoint_DEFS := \
+	$(wear_leveling_benchmark_DEFS) \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=2048
+wear_leveling_benchmark_checkpoint_SRC := \
+	$(wear_leveling_benchmark_SRC)
+wear_leveling_benchmark_checkpoint_INC := \
+	$(wear_leveling_benchmark_INC)
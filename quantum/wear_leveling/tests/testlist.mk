@@ -3,4 +3,11 @@ TEST_LIST += \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
-	wear_leveling_8byte
+	wear_leveling_8byte \
+	wear_leveling_dual_bank_2byte \
+	wear_leveling_dual_bank_8byte \
+	wear_leveling_dual_bank_checkpoint_2byte \
+	wear_leveling_checkpoint_2byte \
+	wear_leveling_checkpoint_8byte \
+	wear_leveling_benchmark \
+	wear_leveling_benchmark_checkpoint
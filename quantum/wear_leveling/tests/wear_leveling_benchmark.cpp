@@ -0,0 +1,79 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <random>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+#include "benchmark_timer.hpp"
+
+// Where the write log starts and ends, after the consolidated data, its FNV1a_64 and any checkpoint index
+#define BENCHMARK_LOG_START (WEAR_LEVELING_LOGICAL_SIZE + 8 + WEAR_LEVELING_CHECKPOINT_INDEX_SIZE)
+#define BENCHMARK_LOG_END (WEAR_LEVELING_BACKING_SIZE)
+
+/*
+ * Times wear_leveling_init() with the write log filled to different levels, along with the number of backing store
+ * reads it makes, which are what dominate on a real flash chip. Build with and without WEAR_LEVELING_CHECKPOINT_INTERVAL
+ * to compare.
+ *
+ * Each measurement is timed and reported by run_benchmark(), like the benchmarks under tests/benchmark.
+ */
+class WearLevelingBenchmark : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    // The address following the last write to the backing store
+    static std::uint32_t log_used() {
+        auto& inst = MockBackingStore::Instance();
+        auto  last = std::find_if(std::make_reverse_iterator(inst.storage_end()), std::make_reverse_iterator(inst.storage_begin()), [](const MockBackingStoreElement& e) { return !e.is_erased(); });
+        return (std::uint32_t)(std::make_reverse_iterator(inst.storage_begin()) - last) * BACKING_STORE_WRITE_SIZE;
+    }
+
+    // Fills the write log to the given percentage with random single-byte writes
+    static void fill_log(std::uint32_t percent) {
+        std::mt19937        rng(percent);
+        const std::uint32_t target = BENCHMARK_LOG_START + (BENCHMARK_LOG_END - BENCHMARK_LOG_START) * percent / 100;
+        while (log_used() < target) {
+            std::uint32_t address = rng() % WEAR_LEVELING_LOGICAL_SIZE;
+            std::uint8_t  value   = (std::uint8_t)(1 + rng() % 255);
+            ASSERT_EQ(wear_leveling_write(address, &value, 1), WEAR_LEVELING_SUCCESS) << "Log filled up before " << percent << "%";
+        }
+    }
+
+    // Times repeated calls to wear_leveling_init(), reporting the time per call and the reads made by each
+    static void benchmark_init(const std::string& name, std::uint64_t reads) {
+        run_benchmark(name, reads, []() { wear_leveling_init(); });
+    }
+};
+
+/**
+ * Times initialisation against how full the write log is, with one item per backing store read.
+ */
+TEST_F(WearLevelingBenchmark, InitByLogFill) {
+    auto& inst = MockBackingStore::Instance();
+    for (std::uint32_t percent : {0, 25, 50, 75, 95}) {
+        SCOPED_TRACE(std::to_string(percent) + "% full");
+        inst.reset_instance();
+        wear_leveling_init();
+        fill_log(percent);
+        ASSERT_EQ(inst.erase_invoke_count(), 0) << "Log was consolidated while filling";
+
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> before, after;
+        wear_leveling_read(0, before.data(), before.size());
+        const std::uint64_t start = inst.read_invoke_count();
+        ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+        const std::uint64_t reads = inst.read_invoke_count() - start;
+        wear_leveling_read(0, after.data(), after.size());
+        ASSERT_EQ(after, before);
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+        // The consolidated data, the index, the last checkpoint, then the write log after it, however full the log is
+        const std::uint64_t bound = (WEAR_LEVELING_LOGICAL_SIZE + 8) / BACKING_STORE_WRITE_SIZE + WEAR_LEVELING_CHECKPOINT_SLOTS + (WEAR_LEVELING_CHECKPOINT_RECORD_SIZE * 2 + WEAR_LEVELING_CHECKPOINT_INTERVAL + 8) / BACKING_STORE_WRITE_SIZE + 1;
+        EXPECT_LE(reads, bound);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
+        benchmark_init("wear_leveling_init_" + std::to_string(percent), reads);
+    }
+}
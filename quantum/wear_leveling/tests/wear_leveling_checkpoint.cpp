@@ -0,0 +1,200 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <random>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Where the checkpoint index and the write log start, after the consolidated data and its FNV1a_64
+#define CHECKPOINT_INDEX_START (WEAR_LEVELING_LOGICAL_SIZE + 8)
+#define CHECKPOINT_LOG_START (CHECKPOINT_INDEX_START + WEAR_LEVELING_CHECKPOINT_INDEX_SIZE)
+
+class WearLevelingCheckpoint : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        std::fill(verify_data.begin(), verify_data.end(), 0);
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> read_all() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> data;
+        EXPECT_EQ(wear_leveling_read(0, data.data(), data.size()), WEAR_LEVELING_SUCCESS);
+        return data;
+    }
+
+    // The contents of an index slot, which is the offset of a checkpoint into the write log, or zero if unused
+    static backing_store_int_t index_slot(std::size_t slot) {
+        backing_store_int_t value;
+        MockBackingStore::Instance().read(CHECKPOINT_INDEX_START + slot * BACKING_STORE_WRITE_SIZE, value);
+        return value;
+    }
+
+    static std::uint32_t checkpoint_address(std::size_t slot) {
+        return CHECKPOINT_LOG_START + index_slot(slot) * BACKING_STORE_WRITE_SIZE;
+    }
+
+    // Writes distinct single bytes until the given number of checkpoints have been indexed
+    static void write_until_checkpoints(std::size_t count) {
+        for (std::size_t i = 0; index_slot(count - 1) == 0; ++i) {
+            std::uint8_t value = (std::uint8_t)(i * 3 + 1);
+            ASSERT_EQ(test_write(i % WEAR_LEVELING_LOGICAL_SIZE, &value, 1), WEAR_LEVELING_SUCCESS);
+            ASSERT_LT(i, WEAR_LEVELING_BACKING_SIZE) << "Checkpoint never written";
+        }
+    }
+};
+
+std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> WearLevelingCheckpoint::verify_data;
+
+/**
+ * This test verifies that a checkpoint of the logical data is written once enough of the write log has been used, and
+ * that it's only indexed once it's complete.
+ */
+TEST_F(WearLevelingCheckpoint, CheckpointIndexedAfterInterval) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_checkpoints(1);
+    EXPECT_EQ((inst.log_end() - 1)->address, CHECKPOINT_INDEX_START) << "Index slot should be written last";
+
+    const std::uint32_t address = checkpoint_address(0);
+    EXPECT_GE(address - CHECKPOINT_LOG_START, WEAR_LEVELING_CHECKPOINT_INTERVAL);
+
+    backing_store_int_t value;
+    write_log_entry_t   log{};
+    inst.read(address, value);
+    memcpy(log.raw8, &value, sizeof(value));
+    EXPECT_EQ(LOG_ENTRY_GET_TYPE(log), LOG_ENTRY_TYPE_CHECKPOINT);
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> stored;
+    for (std::size_t i = 0; i < stored.size(); i += BACKING_STORE_WRITE_SIZE) {
+        inst.read(address + BACKING_STORE_WRITE_SIZE + i, value);
+        memcpy(&stored[i], &value, sizeof(value));
+    }
+    EXPECT_EQ(stored, verify_data);
+}
+
+/**
+ * This test verifies that initialisation loads the last checkpoint, and only plays back the write log after it.
+ */
+TEST_F(WearLevelingCheckpoint, InitStartsAfterLastCheckpoint) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_checkpoints(3);
+    for (std::uint8_t i = 0; i < 8; ++i) {
+        std::uint8_t value = i ^ 0x5A;
+        test_write(i, &value, 1);
+    }
+
+    const std::uint64_t reads = inst.read_invoke_count();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(read_all(), verify_data);
+
+    // The consolidated data, the index, the checkpoint, then no more than a checkpoint interval of write log
+    const std::uint64_t expected = (WEAR_LEVELING_LOGICAL_SIZE + 8) / BACKING_STORE_WRITE_SIZE + WEAR_LEVELING_CHECKPOINT_SLOTS + WEAR_LEVELING_CHECKPOINT_RECORD_SIZE / BACKING_STORE_WRITE_SIZE + (WEAR_LEVELING_CHECKPOINT_INTERVAL + 8) / BACKING_STORE_WRITE_SIZE + 1;
+    EXPECT_LE(inst.read_invoke_count() - reads, expected);
+    EXPECT_LT(inst.read_invoke_count() - reads, (checkpoint_address(2) - CHECKPOINT_LOG_START) / BACKING_STORE_WRITE_SIZE) << "Should read less than the write log before the checkpoint";
+}
+
+/**
+ * This test verifies that a checkpoint which doesn't match its checksum is ignored, and the whole write log is played
+ * back instead.
+ */
+TEST_F(WearLevelingCheckpoint, DamagedCheckpointIgnored) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_checkpoints(2);
+    std::uint8_t value = 0x77;
+    test_write(1, &value, 1);
+
+    // Flip a bit of the checkpoint's copy of the logical data
+    auto&                     element = inst.storage_begin()[checkpoint_address(1) / BACKING_STORE_WRITE_SIZE + 1];
+    const backing_store_int_t damaged = element.get() ^ 1;
+    element.erase();
+    element.set(damaged);
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(read_all(), verify_data);
+}
+
+/**
+ * This test verifies that consolidation clears the checkpoint index along with the write log.
+ */
+TEST_F(WearLevelingCheckpoint, ConsolidationClearsIndex) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (std::size_t i = 0; status != WEAR_LEVELING_CONSOLIDATED; ++i) {
+        std::uint8_t value = (std::uint8_t)(i * 5 + 1);
+        status             = test_write(i % WEAR_LEVELING_LOGICAL_SIZE, &value, 1);
+        ASSERT_NE(status, WEAR_LEVELING_FAILED);
+        ASSERT_LT(i, WEAR_LEVELING_BACKING_SIZE) << "Consolidation never occurred";
+    }
+    EXPECT_EQ(index_slot(0), 0);
+
+    write_until_checkpoints(1);
+    EXPECT_EQ(index_slot(1), 0);
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(read_all(), verify_data);
+}
+
+/**
+ * This test cuts the power before every single write made by a sequence of writes spanning several checkpoints, and
+ * verifies that every write completed before the power loss is intact after a restart.
+ */
+TEST_F(WearLevelingCheckpoint, PowerLossAtEveryStep) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Writes a fixed sequence of single bytes until power is lost, or the given number of writes are made. Keeps the
+    // expected data after each write, and returns the number of writes which completed with power still on.
+    std::vector<std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>> snapshots;
+    auto                                                              run_scenario = [&](std::size_t writes, bool until_checkpoints) -> std::size_t {
+        std::mt19937                                         rng(1);
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> data{};
+        snapshots.assign(1, data);
+        for (std::size_t i = 0; i < writes; ++i) {
+            std::uint8_t address = rng() % WEAR_LEVELING_LOGICAL_SIZE;
+            std::uint8_t value   = data[address] ^ (1 + rng() % 255);
+            data[address]        = value;
+            snapshots.push_back(data);
+            wear_leveling_write(address, &value, 1);
+            if (inst.power_lost()) {
+                return i;
+            }
+            if (until_checkpoints && index_slot(2) != 0) {
+                return i + 1;
+            }
+        }
+        return writes;
+    };
+
+    // Run once with power on throughout, to find out how many writes it takes to make a few checkpoints
+    const std::size_t writes = run_scenario(WEAR_LEVELING_BACKING_SIZE, true);
+    ASSERT_NE(index_slot(2), 0) << "Checkpoints never written";
+    ASSERT_EQ(inst.erase_invoke_count(), 0) << "Scenario shouldn't need consolidation";
+    const std::uint64_t total_operations = inst.operation_count();
+
+    for (std::uint64_t operation = 1; operation <= total_operations; ++operation) {
+        SCOPED_TRACE("power lost at operation " + std::to_string(operation));
+        inst.reset_instance();
+        wear_leveling_init();
+        inst.set_power_loss_at(inst.operation_count() + operation);
+        std::size_t completed = run_scenario(writes, false);
+        ASSERT_TRUE(inst.power_lost());
+
+        // After a restart, the data is as of the last completed write, or the interrupted write if it made it
+        inst.restore_power();
+        wear_leveling_init();
+        auto recovered = read_all();
+        bool matches   = recovered == snapshots[completed] || (completed + 1 < snapshots.size() && recovered == snapshots[completed + 1]);
+        ASSERT_TRUE(matches) << "Data lost or corrupted after " << completed << " completed writes";
+
+        // The store carries on working from there
+        std::uint8_t value = ~recovered[0];
+        recovered[0]       = value;
+        ASSERT_NE(wear_leveling_write(0, &value, 1), WEAR_LEVELING_FAILED);
+        wear_leveling_init();
+        ASSERT_EQ(read_all(), recovered);
+    }
+}
@@ -0,0 +1,253 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <random>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Number of single-byte writes made while checking for data loss on power loss
+#ifndef POWER_LOSS_SCENARIO_WRITES
+#    define POWER_LOSS_SCENARIO_WRITES 100
+#endif
+
+class WearLevelingDualBank : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        std::fill(verify_data.begin(), verify_data.end(), 0);
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> read_all() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> data;
+        EXPECT_EQ(wear_leveling_read(0, data.data(), data.size()), WEAR_LEVELING_SUCCESS);
+        return data;
+    }
+
+    // Whether anything has been written to bank 1, which happens once consolidation into it has started
+    static bool bank_1_written() {
+        auto& inst = MockBackingStore::Instance();
+        return std::any_of(inst.log_begin(), inst.log_end(), [](const MockBackingStoreLogEntry& e) { return !e.erased && e.address >= WEAR_LEVELING_BANK_SIZE; });
+    }
+
+    // Writes distinct single bytes until consolidation into bank 1 starts, without running the background task
+    static void write_until_consolidating() {
+        for (std::uint8_t i = 0; !bank_1_written(); ++i) {
+            std::uint8_t value = i + 1;
+            ASSERT_EQ(test_write(i % WEAR_LEVELING_LOGICAL_SIZE, &value, 1), WEAR_LEVELING_SUCCESS);
+            ASSERT_LT(i, WEAR_LEVELING_BANK_SIZE / BACKING_STORE_WRITE_SIZE) << "Consolidation never started";
+        }
+    }
+
+    // Runs the background task until the banks are switched
+    static void finish_consolidation() {
+        for (std::size_t steps = 0; wear_leveling_task() != WEAR_LEVELING_CONSOLIDATED; ++steps) {
+            ASSERT_LT(steps, WEAR_LEVELING_LOGICAL_SIZE) << "Consolidation never completed";
+        }
+    }
+
+    static void power_loss_at_every_step(std::size_t task_interval);
+};
+
+std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> WearLevelingDualBank::verify_data;
+
+/**
+ * This test verifies that the first write after initialisation occurs after the first bank's header.
+ */
+TEST_F(WearLevelingDualBank, FirstWriteOccursAfterHeader) {
+    auto&   inst       = MockBackingStore::Instance();
+    uint8_t test_value = 0x15;
+    test_write(0x02, &test_value, sizeof(test_value));
+    EXPECT_EQ(inst.log_begin()->address, WEAR_LEVELING_BANK_LOG_OFFSET) << "Invalid first write address.";
+}
+
+/**
+ * This test verifies that consolidation copies one page per call to the background task, switches banks once
+ * complete, and only then erases the previous bank -- without ever erasing the whole backing store.
+ */
+TEST_F(WearLevelingDualBank, ConsolidatesInBackground) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_consolidating();
+
+    std::size_t steps = 0;
+    while (wear_leveling_task() != WEAR_LEVELING_CONSOLIDATED) {
+        ASSERT_LT(++steps, WEAR_LEVELING_LOGICAL_SIZE) << "Consolidation never completed";
+    }
+    EXPECT_EQ(steps, WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_DUAL_BANK_PAGE_SIZE) << "Expected one call per page, then one to switch banks";
+    EXPECT_EQ(inst.erase_bank_invoke_count(), 0) << "Previous bank erased before it was needed";
+
+    // The next calls erase the previous bank a sector at a time, then there's nothing left to do
+    for (std::size_t sector = 1; sector <= MOCK_BANK_SECTOR_COUNT::value; ++sector) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+        EXPECT_EQ(inst.erase_bank_invoke_count(), sector);
+    }
+    auto writes = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.write_invoke_count(), writes);
+    EXPECT_EQ(inst.erase_bank_invoke_count(), MOCK_BANK_SECTOR_COUNT::value);
+    EXPECT_EQ(inst.erasure_count(), 1);
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Whole backing store should never be erased";
+
+    // Further writes go to the new bank's write log, and everything reads back after a restart
+    uint8_t test_value = 0xA5;
+    test_write(0x01, &test_value, sizeof(test_value));
+    EXPECT_GE((inst.log_end() - 1)->address, WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_BANK_LOG_OFFSET);
+    wear_leveling_init();
+    EXPECT_EQ(read_all(), verify_data);
+}
+
+/**
+ * This test verifies that changes made to an already copied page during consolidation are carried over to the new
+ * bank, even once the previous bank has been erased.
+ */
+TEST_F(WearLevelingDualBank, WritesDuringConsolidationCarriedOver) {
+    write_until_consolidating();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+
+    uint8_t test_value = 0xC3;
+    EXPECT_EQ(test_write(0x00, &test_value, sizeof(test_value)), WEAR_LEVELING_SUCCESS);
+
+    finish_consolidation();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+
+    wear_leveling_init();
+    EXPECT_EQ(read_all(), verify_data);
+}
+
+/**
+ * This test verifies that the newer bank is used after a restart, even if the previous bank hasn't been erased yet.
+ */
+TEST_F(WearLevelingDualBank, NewerBankUsedBeforeErase) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_consolidating();
+    finish_consolidation();
+
+    uint8_t test_value = 0x5A;
+    test_write(0x03, &test_value, sizeof(test_value));
+    wear_leveling_init();
+    EXPECT_EQ(read_all(), verify_data);
+    EXPECT_EQ(inst.erase_bank_invoke_count(), 0);
+
+    // The previous bank is still erased in the background after the restart
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.erase_bank_invoke_count(), 1);
+}
+
+/**
+ * This test verifies that an interrupted consolidation is ignored after a restart, and its bank erased.
+ */
+TEST_F(WearLevelingDualBank, InterruptedConsolidationIgnored) {
+    auto& inst = MockBackingStore::Instance();
+    write_until_consolidating();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+
+    // The write log is still full, so the partly written bank is erased straight away to consolidate into it
+    wear_leveling_init();
+    EXPECT_EQ(read_all(), verify_data);
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.erase_bank_invoke_count(), MOCK_BANK_SECTOR_COUNT::value);
+    EXPECT_EQ(inst.erasure_count(), 1);
+}
+
+/**
+ * This test verifies that if the background task never runs, the banks are switched during writes instead.
+ */
+TEST_F(WearLevelingDualBank, SwitchesDuringWriteWithoutTask) {
+    auto& inst = MockBackingStore::Instance();
+    for (std::size_t i = 0; i < WEAR_LEVELING_BACKING_SIZE; ++i) {
+        std::uint8_t value = (std::uint8_t)(i * 7 + 1);
+        ASSERT_EQ(test_write(i % WEAR_LEVELING_LOGICAL_SIZE, &value, 1), WEAR_LEVELING_SUCCESS);
+    }
+    EXPECT_GE(inst.erase_bank_invoke_count(), 1) << "Banks were never switched";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Whole backing store should never be erased";
+
+    wear_leveling_init();
+    EXPECT_EQ(read_all(), verify_data);
+}
+
+/**
+ * This test cuts the power before every single write and erase made by a sequence of writes spanning several bank
+ * switches, and verifies that every write completed before the power loss is intact after a restart. The sequence is
+ * run both with the background task keeping up, and with it running too rarely to finish a switch before the write
+ * log fills up.
+ */
+TEST_F(WearLevelingDualBank, PowerLossAtEveryStep) {
+    for (std::size_t task_interval : {1, 4}) {
+        SCOPED_TRACE("background task every " + std::to_string(task_interval) + " writes");
+        power_loss_at_every_step(task_interval);
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+}
+
+void WearLevelingDualBank::power_loss_at_every_step(std::size_t task_interval) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Writes a fixed sequence of single bytes, running the background task in between, until power is lost. Keeps the
+    // expected data after each write, and returns the number of writes which completed with power still on.
+    std::vector<std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>> snapshots;
+    auto                                                              run_scenario = [&]() -> std::size_t {
+        std::mt19937                                         rng(1);
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> data{};
+        snapshots.assign(1, data);
+        for (std::size_t i = 0; i < POWER_LOSS_SCENARIO_WRITES; ++i) {
+            std::uint8_t address = rng() % WEAR_LEVELING_LOGICAL_SIZE;
+            std::uint8_t value   = data[address] ^ (1 + rng() % 255);
+            data[address]        = value;
+            snapshots.push_back(data);
+            wear_leveling_write(address, &value, 1);
+            if (inst.power_lost()) {
+                return i;
+            }
+            if (i % task_interval != 0) {
+                continue;
+            }
+            wear_leveling_task();
+            if (inst.power_lost()) {
+                return i + 1;
+            }
+        }
+        return POWER_LOSS_SCENARIO_WRITES;
+    };
+
+    // Run once with power on throughout, to find out how many steps there are
+    inst.reset_instance();
+    wear_leveling_init();
+    ASSERT_EQ(run_scenario(), POWER_LOSS_SCENARIO_WRITES);
+    const std::uint64_t total_operations = inst.operation_count();
+    ASSERT_GE(inst.erasure_count(), 3) << "Scenario should cover several bank switches";
+
+    for (std::uint64_t operation = 1; operation <= total_operations; ++operation) {
+        SCOPED_TRACE("power lost at operation " + std::to_string(operation));
+        inst.reset_instance();
+        wear_leveling_init();
+        inst.set_power_loss_at(inst.operation_count() + operation);
+        std::size_t completed = run_scenario();
+        ASSERT_TRUE(inst.power_lost());
+
+        // After a restart, the data is as of the last completed write, or the interrupted write if it made it
+        inst.restore_power();
+        wear_leveling_init();
+        auto recovered = read_all();
+        bool matches   = recovered == snapshots[completed] || (completed + 1 < snapshots.size() && recovered == snapshots[completed + 1]);
+        ASSERT_TRUE(matches) << "Data lost or corrupted after " << completed << " completed writes";
+
+        // The store carries on working from there
+        std::uint8_t value = ~recovered[0];
+        recovered[0]       = value;
+        ASSERT_NE(wear_leveling_write(0, &value, 1), WEAR_LEVELING_FAILED);
+        for (std::size_t i = 0; i <= MOCK_BANK_SECTOR_COUNT::value + WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_DUAL_BANK_PAGE_SIZE + 1; ++i) {
+            ASSERT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED);
+        }
+        wear_leveling_init();
+        ASSERT_EQ(read_all(), recovered);
+    }
+}
@@ -61,6 +61,14 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_DUAL_BANK: Splits the backing store into two banks, see
+            "Dual-bank structure" below. Each bank must fit the logical size,
+            a 16-byte header and a write log.
+
+        - WEAR_LEVELING_CHECKPOINT_INTERVAL: Number of bytes of write log
+            between checkpoints, see "Checkpoints" below. Unset by default,
+            disabling checkpoints. This must be a multiple of the write size.
+
     General algorithm:
 
         During initialization:
@@ -153,7 +161,59 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Dual-bank structure:
+
+        With WEAR_LEVELING_DUAL_BANK, the backing store is split into two equal
+        banks, each laid out as:
+
+            [consolidated data][sequence number][FNV1a_64][write log...]
+
+        The FNV1a_64 covers both the consolidated data and the 8-byte sequence
+        number, and is written last -- a bank only becomes valid once it has
+        been completely written. On startup the valid bank with the highest
+        sequence number is the active bank, and its write log is played back.
+
+        Writes are appended to the active bank's write log. Once fewer than
+        WEAR_LEVELING_DUAL_BANK_RESERVE bytes of it remain, wear_leveling_task()
+        copies the cache into the inactive bank, one page of
+        WEAR_LEVELING_DUAL_BANK_PAGE_SIZE bytes per call. Write log entries made
+        in the meantime go to both banks, so the active bank stays complete and
+        the inactive bank carries over any change to a page already copied.
+        Writing the sequence number and checksum then switches banks, and a
+        later call erases the previous bank.
+
+        If the active bank's write log fills up before the copy completes, such
+        as when wear_leveling_task() isn't called often enough, the rest of the
+        copy is done during that write instead.
+
+        The active bank is never erased or rewritten while it is active, so a
+        power loss at any point leaves either the previous or the new bank
+        intact, with every completed write.
+
+    Checkpoints:
+
+        With WEAR_LEVELING_CHECKPOINT_INTERVAL, a checkpoint is added to the
+        write log whenever a write leaves at least that many bytes of log
+        since the previous one. A checkpoint is a copy of the whole cache:
+
+            [log entry][logical data][FNV1a_64 of the logical data]
+
+        The log entry is a single backing store write with type 0x03, and
+        playback skips over the rest of the checkpoint.
+
+        Checkpoints are indexed in slots between the consolidated data's
+        header and the write log, one backing store write each, holding the
+        checkpoint's offset from the start of the write log in units of the
+        write size. A slot is only written once its checkpoint is complete.
+
+        During initialization, the last filled slot is found, and the cache is
+        loaded from that checkpoint if its checksum matches. Only the write log
+        after it is played back, rather than the whole write log. Otherwise,
+        the whole write log is played back as usual.
+
+        Consolidation clears the index along with the write log. */
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,8 +222,41 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_DUAL_BANK
+    uint8_t  active_bank;          // the bank holding the latest consolidated data and write log
+    uint32_t sequence;             // the sequence number of the active bank
+    bool     consolidating;        // whether the cache is being copied into the inactive bank
+    bool     erase_pending;        // whether the inactive bank needs erasing before it can be written
+    uint32_t erase_offset;         // how far into the inactive bank erasing has got
+    uint32_t consolidate_offset;   // the next logical address to copy into the inactive bank
+    uint64_t consolidate_checksum; // FNV1a_64 of the data copied into the inactive bank so far
+    uint32_t shadow_address;       // the next write log address in the inactive bank
+#endif // WEAR_LEVELING_DUAL_BANK
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    uint32_t checkpoint_address; // the write log address after the last checkpoint, or the start of the write log
+    uint32_t checkpoint_slots;   // the number of index slots in use
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_DUAL_BANK
+#    define WEAR_LEVELING_BANK_BASE(bank) ((uint32_t)(bank) * (WEAR_LEVELING_BANK_SIZE))
+#    define WEAR_LEVELING_LOG_START (WEAR_LEVELING_BANK_BASE(wear_leveling.active_bank) + (WEAR_LEVELING_BANK_LOG_OFFSET))
+#    define WEAR_LEVELING_LOG_END (WEAR_LEVELING_BANK_BASE(wear_leveling.active_bank) + (WEAR_LEVELING_BANK_SIZE))
+#else
+#    define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + 8 + (WEAR_LEVELING_CHECKPOINT_INDEX_SIZE)) // +8 is due to the FNV1a_64 of the consolidated buffer
+#    define WEAR_LEVELING_LOG_END (WEAR_LEVELING_BACKING_SIZE)
+#endif // WEAR_LEVELING_DUAL_BANK
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+#    define WEAR_LEVELING_CHECKPOINT_INDEX_START (WEAR_LEVELING_LOG_START - (WEAR_LEVELING_CHECKPOINT_INDEX_SIZE))
+#    ifdef WEAR_LEVELING_DUAL_BANK
+// Leave the reserve free, so that consolidation into the inactive bank starts with as much time as usual
+#        define WEAR_LEVELING_CHECKPOINT_LOG_END (WEAR_LEVELING_LOG_END - (WEAR_LEVELING_DUAL_BANK_RESERVE))
+#    else
+#        define WEAR_LEVELING_CHECKPOINT_LOG_END (WEAR_LEVELING_LOG_END)
+#    endif
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
 /**
  * Locking helper: status
  */
@@ -197,14 +290,54 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+/**
+ * Forgets all checkpoints, such as when the write log has been cleared.
+ */
+static void wear_leveling_checkpoint_clear(void) {
+    wear_leveling.checkpoint_address = WEAR_LEVELING_LOG_START;
+    wear_leveling.checkpoint_slots   = 0;
+}
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
 /**
  * Resets the cache, ensuring the write address is correctly initialised.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling_checkpoint_clear();
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+}
+
+/**
+ * Reads a complete 8-byte entry, such as a checksum, from the backing store.
+ */
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
 }
 
+/**
+ * Writes a complete 8-byte entry, such as a checksum, to the backing store.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
+}
+
+#ifndef WEAR_LEVELING_DUAL_BANK
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -223,13 +356,7 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
         uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_entry((WEAR_LEVELING_LOGICAL_SIZE), &entry);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
         if (entry.raw64 == expected) {
@@ -268,24 +395,9 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
         write_log_entry_t entry;
         entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_entry((WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -316,7 +428,10 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling_checkpoint_clear();
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
 
     return status;
 }
@@ -329,7 +444,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= WEAR_LEVELING_LOG_END) {
         return wear_leveling_consolidate_force();
     }
 
@@ -351,6 +466,262 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
     return wear_leveling_consolidate_if_needed();
 }
 
+#else // WEAR_LEVELING_DUAL_BANK
+
+/**
+ * Reads the consolidated data of a bank into the cache, and checks it against the bank's checksum.
+ * The cache is left holding the bank's data whether or not it is valid.
+ *
+ * @return true if the bank is valid
+ */
+static bool wear_leveling_read_bank(uint8_t bank, uint32_t *sequence) {
+    const uint32_t    base = WEAR_LEVELING_BANK_BASE(bank);
+    write_log_entry_t stored_sequence;
+    write_log_entry_t stored_checksum;
+    if (!backing_store_read_bulk(base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t)) || !wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &stored_sequence) || !wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &stored_checksum)) {
+        wl_dprintf("Failed to read bank %d from backing store\n", (int)bank);
+        return false;
+    }
+
+    uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+    expected          = fnv_64a_buf(stored_sequence.raw8, sizeof(stored_sequence.raw8), expected);
+    *sequence         = (uint32_t)stored_sequence.raw64;
+    return stored_checksum.raw64 == expected;
+}
+
+/**
+ * Checks whether a bank is fully erased, and can be written without erasing it first.
+ */
+static bool wear_leveling_bank_is_erased(uint8_t bank) {
+    for (uint32_t address = WEAR_LEVELING_BANK_BASE(bank); address < WEAR_LEVELING_BANK_BASE(bank) + (WEAR_LEVELING_BANK_SIZE); address += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!backing_store_read(address, &value) || value != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads the consolidated data of the newest valid bank into the cache, making it the active bank.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    uint32_t sequence[2] = {0, 0};
+    bool     valid[2];
+    valid[0] = wear_leveling_read_bank(0, &sequence[0]);
+    valid[1] = wear_leveling_read_bank(1, &sequence[1]);
+
+    // Bank 0 is used if neither is valid, such as after an erase
+    const uint8_t active        = (valid[1] && (!valid[0] || (int32_t)(sequence[1] - sequence[0]) > 0)) ? 1 : 0;
+    wear_leveling.active_bank   = active;
+    wear_leveling.sequence      = valid[active] ? sequence[active] : 0;
+    wear_leveling.consolidating = false;
+
+    if (!valid[active]) {
+        wl_dprintf("No valid bank, clearing cache\n");
+        wear_leveling_clear_cache();
+    } else {
+        wl_dprintf("Bank %d is active, sequence %ld\n", (int)active, (long)wear_leveling.sequence);
+        if (active == 0) {
+            // The cache holds bank 1 after checking both banks
+            wear_leveling_read_bank(0, &sequence[0]);
+        }
+        wear_leveling.write_address = WEAR_LEVELING_LOG_START;
+    }
+
+    // Whatever is in the other bank is stale, either an older copy or an interrupted consolidation
+    wear_leveling.erase_pending = !wear_leveling_bank_is_erased(active ^ 1);
+    wear_leveling.erase_offset  = 0;
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Erases the next sector of the inactive bank, so that it can eventually be consolidated into. Erasing a sector at a
+ * time keeps each call to wear_leveling_task() short.
+ */
+static wear_leveling_status_t wear_leveling_erase_inactive_step(void) {
+    wl_dprintf("Erasing bank %d from offset %ld\n", (int)(wear_leveling.active_bank ^ 1), (long)wear_leveling.erase_offset);
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    bool                        ok          = (lock_status != STATUS_FAILURE) && backing_store_erase_bank(wear_leveling.active_bank ^ 1, &wear_leveling.erase_offset);
+    if (lock_status == STATUS_SUCCESS) {
+        ok &= (wear_leveling_lock() != STATUS_FAILURE);
+    }
+
+    if (!ok) {
+        wl_dprintf("Failed to erase bank\n");
+        wear_leveling.erase_offset = 0;
+        return WEAR_LEVELING_FAILED;
+    }
+    if (wear_leveling.erase_offset >= (WEAR_LEVELING_BANK_SIZE)) {
+        wear_leveling.erase_pending = false;
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Erases whatever is left of the inactive bank in one go, for when it's needed straight away.
+ */
+static wear_leveling_status_t wear_leveling_erase_inactive(void) {
+    while (wear_leveling.erase_pending) {
+        if (wear_leveling_erase_inactive_step() == WEAR_LEVELING_FAILED) {
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Starts consolidating the cache into the inactive bank, erasing it first if that hasn't already happened.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_start(void) {
+    if (wear_leveling.erase_pending && wear_leveling_erase_inactive() == WEAR_LEVELING_FAILED) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wl_dprintf("Consolidating into bank %d\n", (int)(wear_leveling.active_bank ^ 1));
+    wear_leveling.consolidating        = true;
+    wear_leveling.consolidate_offset   = 0;
+    wear_leveling.consolidate_checksum = FNV1A_64_INIT;
+    wear_leveling.shadow_address       = WEAR_LEVELING_BANK_BASE(wear_leveling.active_bank ^ 1) + (WEAR_LEVELING_BANK_LOG_OFFSET);
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Copies the next page of the cache into the inactive bank. Once the whole cache has been copied, writes the bank's
+ * sequence number and checksum, which switches banks, and leaves the previous bank to be erased.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the banks have been switched
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    const uint8_t  target = wear_leveling.active_bank ^ 1;
+    const uint32_t base   = WEAR_LEVELING_BANK_BASE(target);
+    const uint32_t offset = wear_leveling.consolidate_offset;
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    wear_leveling_status_t      status      = lock_status == STATUS_FAILURE ? WEAR_LEVELING_FAILED : WEAR_LEVELING_SUCCESS;
+    if (status != WEAR_LEVELING_FAILED && offset < (WEAR_LEVELING_LOGICAL_SIZE)) {
+        // The checksum covers the page as written, any later change to it is carried over by the mirrored write log
+        const uint32_t remaining = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+        const uint32_t length    = remaining < (WEAR_LEVELING_DUAL_BANK_PAGE_SIZE) ? remaining : (WEAR_LEVELING_DUAL_BANK_PAGE_SIZE);
+        if (backing_store_write_bulk(base + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / sizeof(backing_store_int_t))) {
+            wear_leveling.consolidate_checksum = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling.consolidate_checksum);
+            wear_leveling.consolidate_offset += length;
+        } else {
+            status = WEAR_LEVELING_FAILED;
+        }
+    } else if (status != WEAR_LEVELING_FAILED) {
+        // Writing the checksum last is what makes the bank valid
+        write_log_entry_t sequence = {.raw64 = (uint32_t)(wear_leveling.sequence + 1)};
+        write_log_entry_t checksum = {.raw64 = fnv_64a_buf(sequence.raw8, sizeof(sequence.raw8), wear_leveling.consolidate_checksum)};
+        if (wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &sequence) && wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &checksum)) {
+            wl_dprintf("Switched to bank %d\n", (int)target);
+            wear_leveling.active_bank   = target;
+            wear_leveling.sequence      = (uint32_t)sequence.raw64;
+            wear_leveling.write_address = wear_leveling.shadow_address;
+            wear_leveling.consolidating = false;
+            wear_leveling.erase_pending = true;
+            wear_leveling.erase_offset  = 0;
+            status                      = WEAR_LEVELING_CONSOLIDATED;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+            wear_leveling_checkpoint_clear();
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+        } else {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    if (lock_status == STATUS_SUCCESS && wear_leveling_lock() == STATUS_FAILURE) {
+        status = WEAR_LEVELING_FAILED;
+    }
+
+    if (status == WEAR_LEVELING_FAILED) {
+        // The inactive bank is now in an unknown state, so start over from an erase next time
+        wl_dprintf("Failed to write to backing store\n");
+        wear_leveling.consolidating = false;
+        wear_leveling.erase_pending = true;
+        wear_leveling.erase_offset  = 0;
+    }
+    return status;
+}
+
+/**
+ * Forces a write of the current cache into the inactive bank, restarting any consolidation in progress.
+ * The active bank is left untouched until the switch, so a power loss during this operation does not lose data.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    if (wear_leveling.consolidating) {
+        wear_leveling.consolidating = false;
+        wear_leveling.erase_pending = true;
+        wear_leveling.erase_offset  = 0;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_start();
+    while (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_consolidate_step();
+    }
+    if (status == WEAR_LEVELING_FAILED) {
+        wl_dprintf("Failed to write consolidated data\n");
+    }
+    return status;
+}
+
+/**
+ * Starts consolidating into the inactive bank once the active bank's write log is nearly full.
+ * Must only be called between write log entries, so that the inactive bank only ever receives complete entries.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
+    if (!wear_leveling.consolidating && wear_leveling.write_address + (WEAR_LEVELING_DUAL_BANK_RESERVE) >= WEAR_LEVELING_LOG_END) {
+        return wear_leveling_consolidate_start();
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Appends the supplied fixed-width entry to the write log, mirroring it into the inactive bank while consolidating.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
+    if (wear_leveling.write_address >= WEAR_LEVELING_LOG_END) {
+        if (!wear_leveling.consolidating) {
+            return wear_leveling_consolidate_force();
+        }
+
+        // The background task hasn't kept up, so finish the switch now. Any part of this entry already written stays
+        // valid, as it was mirrored into the new bank's write log, which is where the rest of it now goes.
+        wear_leveling_status_t status;
+        do {
+            status = wear_leveling_consolidate_step();
+        } while (status == WEAR_LEVELING_SUCCESS);
+        if (status == WEAR_LEVELING_FAILED) {
+            return status;
+        }
+    }
+
+    if (wear_leveling.consolidating) {
+        // Started with no more than the reserve left in the active bank, so the inactive bank's write log has room too
+        if (!backing_store_write(wear_leveling.shadow_address, value)) {
+            wl_dprintf("Failed to write to backing store\n");
+            return WEAR_LEVELING_FAILED;
+        }
+        wear_leveling.shadow_address += (BACKING_STORE_WRITE_SIZE);
+    }
+
+    if (!backing_store_write(wear_leveling.write_address, value)) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+    wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // WEAR_LEVELING_DUAL_BANK
+
 /**
  * Handles writing multi_byte-encoded data to the backing store.
  *
@@ -469,6 +840,110 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+/**
+ * Appends a checkpoint of the current cache to the write log, if enough of the write log has been used since the last
+ * one. Must only be called between write log entries, once the cache matches the write log.
+ */
+static wear_leveling_status_t wear_leveling_checkpoint_if_needed(void) {
+    const uint32_t address = wear_leveling.write_address;
+    if (address - wear_leveling.checkpoint_address < (WEAR_LEVELING_CHECKPOINT_INTERVAL) || address + (WEAR_LEVELING_CHECKPOINT_RECORD_SIZE) >= WEAR_LEVELING_CHECKPOINT_LOG_END || wear_leveling.checkpoint_slots >= (WEAR_LEVELING_CHECKPOINT_SLOTS)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+#    ifdef WEAR_LEVELING_DUAL_BANK
+    // Checkpoints aren't mirrored, so wait for the new bank instead
+    if (wear_leveling.consolidating) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+#    endif // WEAR_LEVELING_DUAL_BANK
+
+    wl_dprintf("Writing checkpoint\n");
+
+    // Once the log entry is written, playback skips the whole checkpoint whether or not the rest of it makes it
+    write_log_entry_t log = LOG_ENTRY_MAKE_CHECKPOINT();
+    bool              ok;
+#    if BACKING_STORE_WRITE_SIZE == 2
+    ok = backing_store_write(address, log.raw16[0]);
+#    elif BACKING_STORE_WRITE_SIZE == 4
+    ok = backing_store_write(address, log.raw32[0]);
+#    elif BACKING_STORE_WRITE_SIZE == 8
+    ok = backing_store_write(address, log.raw64);
+#    endif
+    if (!ok) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+    wear_leveling.write_address      = address + (WEAR_LEVELING_CHECKPOINT_RECORD_SIZE);
+    wear_leveling.checkpoint_address = wear_leveling.write_address;
+
+    write_log_entry_t checksum = {.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT)};
+    if (!backing_store_write_bulk(address + (BACKING_STORE_WRITE_SIZE), (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t)) || !wear_leveling_write_entry(address + (BACKING_STORE_WRITE_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE), &checksum)) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // Only index the checkpoint once it's complete
+    const uint32_t slot = wear_leveling.checkpoint_slots++;
+    if (!backing_store_write(WEAR_LEVELING_CHECKPOINT_INDEX_START + slot * (BACKING_STORE_WRITE_SIZE), (backing_store_int_t)((address - WEAR_LEVELING_LOG_START) / (BACKING_STORE_WRITE_SIZE)))) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Loads the cache from the last indexed checkpoint, if there is one. The cache is left holding the consolidated data if
+ * there isn't, or if the checkpoint doesn't match its checksum.
+ *
+ * @return the write log address to start playback from
+ */
+static uint32_t wear_leveling_checkpoint_restore(void) {
+    wear_leveling_checkpoint_clear();
+
+    backing_store_int_t offset = 0;
+    while (wear_leveling.checkpoint_slots < (WEAR_LEVELING_CHECKPOINT_SLOTS)) {
+        backing_store_int_t value;
+        if (!backing_store_read(WEAR_LEVELING_CHECKPOINT_INDEX_START + wear_leveling.checkpoint_slots * (BACKING_STORE_WRITE_SIZE), &value) || value == 0) {
+            break;
+        }
+        offset = value;
+        wear_leveling.checkpoint_slots++;
+    }
+    if (wear_leveling.checkpoint_slots == 0) {
+        return WEAR_LEVELING_LOG_START;
+    }
+
+    const uint32_t      address = WEAR_LEVELING_LOG_START + (uint32_t)offset * (BACKING_STORE_WRITE_SIZE);
+    const uint32_t      end     = address + (WEAR_LEVELING_CHECKPOINT_RECORD_SIZE);
+    backing_store_int_t value;
+    write_log_entry_t   log     = {.raw64 = 0};
+    write_log_entry_t   checksum;
+    if (end <= WEAR_LEVELING_LOG_END && backing_store_read(address, &value)) {
+#    if BACKING_STORE_WRITE_SIZE == 2
+        log.raw16[0] = value;
+#    elif BACKING_STORE_WRITE_SIZE == 4
+        log.raw32[0] = value;
+#    elif BACKING_STORE_WRITE_SIZE == 8
+        log.raw64 = value;
+#    endif
+    }
+    if (LOG_ENTRY_GET_TYPE(log) == LOG_ENTRY_TYPE_CHECKPOINT) {
+        wl_dprintf("Reading checkpoint %d\n", (int)wear_leveling.checkpoint_slots);
+        if (backing_store_read_bulk(address + (BACKING_STORE_WRITE_SIZE), (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t)) && wear_leveling_read_entry(address + (BACKING_STORE_WRITE_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE), &checksum) && checksum.raw64 == fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT)) {
+            wear_leveling.checkpoint_address = end;
+            return end;
+        }
+    }
+
+    // The cache may hold part of the checkpoint by now, so start over from the consolidated data
+    wl_dprintf("Checkpoint mismatch, playing back the whole write log\n");
+    const uint32_t slots = wear_leveling.checkpoint_slots;
+    wear_leveling_read_consolidated();
+    wear_leveling.checkpoint_slots = slots;
+    return WEAR_LEVELING_LOG_START;
+}
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
@@ -477,8 +952,12 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    uint32_t address = wear_leveling_checkpoint_restore();
+#else
+    uint32_t address = WEAR_LEVELING_LOG_START;
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+    while (!cancel_playback && address < WEAR_LEVELING_LOG_END) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -508,6 +987,20 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
+                // An entry cut short by the end of the write log was never completed, so the log ends before it
+#if BACKING_STORE_WRITE_SIZE == 2
+                const uint32_t remaining_bytes = (BACKING_STORE_WRITE_SIZE) * (1 + (LOG_ENTRY_MULTIBYTE_GET_LENGTH(log) > 1) + (LOG_ENTRY_MULTIBYTE_GET_LENGTH(log) > 3));
+#elif BACKING_STORE_WRITE_SIZE == 4
+                const uint32_t remaining_bytes = (BACKING_STORE_WRITE_SIZE) * (LOG_ENTRY_MULTIBYTE_GET_LENGTH(log) > 1);
+#elif BACKING_STORE_WRITE_SIZE == 8
+                const uint32_t remaining_bytes = 0;
+#endif
+                if (address + remaining_bytes > WEAR_LEVELING_LOG_END) {
+                    wl_dprintf("Incomplete entry at the end of the write log\n");
+                    cancel_playback = true;
+                    break;
+                }
+
 #if BACKING_STORE_WRITE_SIZE == 2
                 ok = backing_store_read(address, &log.raw16[1]);
                 if (!ok) {
@@ -590,6 +1083,18 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 wear_leveling.cache[a + 1] = 0;
             } break;
 #endif // BACKING_STORE_WRITE_SIZE == 2
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+            case LOG_ENTRY_TYPE_CHECKPOINT: {
+                // The checkpoint is made up of the entries before it, so there's nothing to play back
+                if (address + (WEAR_LEVELING_CHECKPOINT_RECORD_SIZE) - (BACKING_STORE_WRITE_SIZE) > WEAR_LEVELING_LOG_END) {
+                    wl_dprintf("Incomplete checkpoint at the end of the write log\n");
+                    cancel_playback = true;
+                    break;
+                }
+                address += (WEAR_LEVELING_CHECKPOINT_RECORD_SIZE) - (BACKING_STORE_WRITE_SIZE);
+                wear_leveling.checkpoint_address = address;
+            } break;
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
             default: {
                 cancel_playback = true;
                 status          = WEAR_LEVELING_FAILED;
@@ -661,6 +1166,12 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_DUAL_BANK
+    wear_leveling.active_bank   = 0;
+    wear_leveling.sequence      = 0;
+    wear_leveling.consolidating = false;
+    wear_leveling.erase_pending = false;
+#endif // WEAR_LEVELING_DUAL_BANK
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -709,6 +1220,12 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         case WEAR_LEVELING_SUCCESS:
             // Consolidate the cache + write log if required
             status = wear_leveling_consolidate_if_needed();
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+            // Otherwise, checkpoint the cache if required
+            if (status == WEAR_LEVELING_SUCCESS) {
+                status = wear_leveling_checkpoint_if_needed();
+            }
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
             break;
 
         default:
@@ -743,6 +1260,21 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+/**
+ * Wear-leveling background work, only needed for dual-bank consolidation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_DUAL_BANK
+    if (wear_leveling.consolidating) {
+        return wear_leveling_consolidate_step();
+    }
+    if (wear_leveling.erase_pending) {
+        return wear_leveling_erase_inactive_step();
+    }
+#endif // WEAR_LEVELING_DUAL_BANK
+    return WEAR_LEVELING_SUCCESS;
+}
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
@@ -52,3 +52,13 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Wear-leveling background work.
+ *
+ * With WEAR_LEVELING_DUAL_BANK, copies the next page of a pending consolidation into the inactive bank, switches banks
+ * once the copy is complete, or erases the next sector of the previously active bank. Does nothing otherwise.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED if the banks were switched
+ */
+wear_leveling_status_t wear_leveling_task(void);
@@ -66,10 +66,66 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+// Space following the consolidated data and its header, shared by the checkpoint index and the write log
+#    ifdef WEAR_LEVELING_DUAL_BANK
+#        define WEAR_LEVELING_CHECKPOINT_LOG_SPACE ((WEAR_LEVELING_BACKING_SIZE) / 2 - (WEAR_LEVELING_LOGICAL_SIZE) - 16)
+#    else
+#        define WEAR_LEVELING_CHECKPOINT_LOG_SPACE ((WEAR_LEVELING_BACKING_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - 8)
+#    endif
+
+// One index slot for every checkpoint that could fit in the write log, each holding the offset of a checkpoint
+#    define WEAR_LEVELING_CHECKPOINT_SLOTS ((WEAR_LEVELING_CHECKPOINT_LOG_SPACE) / (WEAR_LEVELING_CHECKPOINT_INTERVAL))
+#    define WEAR_LEVELING_CHECKPOINT_INDEX_SIZE ((WEAR_LEVELING_CHECKPOINT_SLOTS) * (BACKING_STORE_WRITE_SIZE))
+
+// A checkpoint is its log entry, a copy of the logical data, then the copy's FNV1a_64
+#    define WEAR_LEVELING_CHECKPOINT_RECORD_SIZE ((BACKING_STORE_WRITE_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE) + 8)
+
+_Static_assert(WEAR_LEVELING_CHECKPOINT_INTERVAL % BACKING_STORE_WRITE_SIZE == 0, "Checkpoint interval must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CHECKPOINT_SLOTS > 0, "Checkpoint interval must be smaller than the write log");
+_Static_assert(BACKING_STORE_WRITE_SIZE > 2 || WEAR_LEVELING_CHECKPOINT_LOG_SPACE / BACKING_STORE_WRITE_SIZE <= UINT16_MAX, "Write log too large to index checkpoints with 2-byte writes");
+#else
+#    define WEAR_LEVELING_CHECKPOINT_INDEX_SIZE 0
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
+#ifdef WEAR_LEVELING_DUAL_BANK
+// Each bank holds the consolidated data, its sequence number and FNV1a_64, the checkpoint index, then its own write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_BANK_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 16 + (WEAR_LEVELING_CHECKPOINT_INDEX_SIZE))
+
+// Number of bytes copied into the inactive bank per call to wear_leveling_task()
+#    ifndef WEAR_LEVELING_DUAL_BANK_PAGE_SIZE
+#        define WEAR_LEVELING_DUAL_BANK_PAGE_SIZE 64
+#    endif
+
+// Number of bytes left in the active bank's write log when consolidation into the inactive bank starts
+#    ifndef WEAR_LEVELING_DUAL_BANK_RESERVE
+#        define WEAR_LEVELING_DUAL_BANK_RESERVE (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_BANK_LOG_OFFSET)) / 4)
+#    endif
+
+_Static_assert(WEAR_LEVELING_BANK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Bank size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE > WEAR_LEVELING_BANK_LOG_OFFSET, "Bank size must leave room for a write log after the logical size and header");
+_Static_assert(WEAR_LEVELING_DUAL_BANK_PAGE_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Dual-bank page size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_DUAL_BANK_RESERVE >= 8, "Dual-bank reserve must fit at least one write log entry");
+_Static_assert(WEAR_LEVELING_DUAL_BANK_RESERVE < WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_BANK_LOG_OFFSET, "Dual-bank reserve must be smaller than the write log");
+#endif // WEAR_LEVELING_DUAL_BANK
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+// At least one checkpoint has to fit in the write log once the interval has passed, or the index is wasted space
+#    ifdef WEAR_LEVELING_DUAL_BANK
+_Static_assert(WEAR_LEVELING_CHECKPOINT_INDEX_SIZE + WEAR_LEVELING_CHECKPOINT_INTERVAL + WEAR_LEVELING_CHECKPOINT_RECORD_SIZE + WEAR_LEVELING_DUAL_BANK_RESERVE < WEAR_LEVELING_CHECKPOINT_LOG_SPACE, "Write log too small to fit a checkpoint after the checkpoint interval and dual-bank reserve -- increase the backing size or reduce the checkpoint interval");
+#    else
+_Static_assert(WEAR_LEVELING_CHECKPOINT_INDEX_SIZE + WEAR_LEVELING_CHECKPOINT_INTERVAL + WEAR_LEVELING_CHECKPOINT_RECORD_SIZE < WEAR_LEVELING_CHECKPOINT_LOG_SPACE, "Write log too small to fit a checkpoint after the checkpoint interval -- increase the backing size or reduce the checkpoint interval");
+#    endif
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
 bool backing_store_erase(void);
+#ifdef WEAR_LEVELING_DUAL_BANK
+bool backing_store_erase_bank(uint8_t bank, uint32_t* offset); // erases the sector at *offset into one half of the backing store, bank 0 or 1, and moves *offset past it
+#endif
 bool backing_store_write(uint32_t address, backing_store_int_t value);
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 bool backing_store_lock(void);
@@ -101,6 +157,9 @@ enum {
     // 0x02 -- 2-byte backing store write optimization: word-encoded 0/1 values
     LOG_ENTRY_TYPE_WORD_01,
 
+    // 0x03 -- Checkpoint of the logical data, followed by the data and its checksum
+    LOG_ENTRY_TYPE_CHECKPOINT,
+
     LOG_ENTRY_TYPES
 };
 
@@ -149,3 +208,10 @@ _Static_assert(LOG_ENTRY_TYPES <= (1 << 2), "Too many log entry types to fit int
             [1] = (uint8_t)((address) >> 1), /* address */                                            \
         }                                                                                             \
     }
+
+#define LOG_ENTRY_MAKE_CHECKPOINT()                                                                   \
+    (write_log_entry_t) {                                                                             \
+        .raw8 = {                                                                                     \
+            [0] = ((((uint8_t)LOG_ENTRY_TYPE_CHECKPOINT) & BITMASK_FOR_BITCOUNT(2)) << 6), /* type */ \
+        }                                                                                             \
+    }
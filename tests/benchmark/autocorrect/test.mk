@@ -0,0 +1,6 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTOCORRECT_ENABLE = yes
+
+SRC += tests/benchmark/benchmark_fixture.cpp tests/benchmark/benchmark_timer.cpp
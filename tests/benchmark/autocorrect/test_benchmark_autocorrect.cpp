@@ -0,0 +1,49 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "../benchmark_fixture.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// One word in the default dictionary is misspelled, and gets corrected
+static const char text[] = "the quick brown fox becuase it was there ";
+
+class BenchmarkAutocorrect : public BenchmarkFixture {
+   protected:
+    void SetUp() override {
+        for (uint8_t i = 0; i < 26; i++) {
+            add_key(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i));
+        }
+        add_key(KeymapKey(0, 26 % MATRIX_COLS, 26 / MATRIX_COLS, KC_SPC));
+        autocorrect_enable();
+    }
+
+    static void type(char c) {
+        uint8_t index = c == ' ' ? 26 : c - 'a';
+        press_key(index % MATRIX_COLS, index / MATRIX_COLS);
+        keyboard_task();
+        advance_time(1);
+        release_key(index % MATRIX_COLS, index / MATRIX_COLS);
+        keyboard_task();
+        advance_time(1);
+    }
+};
+
+TEST_F(BenchmarkAutocorrect, Typing) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    benchmark("autocorrect_typing", strlen(text), []() {
+        for (const char* c = text; *c; c++) {
+            type(*c);
+        }
+    });
+}
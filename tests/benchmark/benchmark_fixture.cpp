@@ -0,0 +1,9 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark_fixture.hpp"
+#include "benchmark_timer.hpp"
+
+void BenchmarkFixture::benchmark(const std::string& name, uint32_t items, const std::function<void()>& iteration) {
+    run_benchmark(name, items, iteration);
+}
@@ -0,0 +1,21 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "test_fixture.hpp"
+
+/*
+ * Times pieces of the quantum core on the host, so their cost can be compared across commits without flashing hardware.
+ *
+ * Each benchmark is timed and reported by run_benchmark() from benchmark_timer.hpp. Timings include the test harness, such
+ * as its keymap lookup and mocked host driver, so they are only comparable with each other on the same machine.
+ */
+class BenchmarkFixture : public TestFixture {
+   protected:
+    /* Times an iteration that processes the given number of items, such as LEDs or key events, and reports the cost of each. */
+    static void benchmark(const std::string& name, uint32_t items, const std::function<void()>& iteration);
+};
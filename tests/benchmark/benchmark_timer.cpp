@@ -0,0 +1,45 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark_timer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include "gtest/gtest.h"
+
+static uint32_t env_or(const char* name, uint32_t fallback) {
+    const char* value = std::getenv(name);
+    return value ? (uint32_t)std::strtoul(value, nullptr, 0) : fallback;
+}
+
+void run_benchmark(const std::string& name, uint32_t items, const std::function<void()>& iteration) {
+    using clock = std::chrono::steady_clock;
+
+    const std::chrono::milliseconds min_time(env_or("QMK_BENCHMARK_MIN_TIME", 20));
+    uint64_t                        iterations = 1;
+    clock::duration                 elapsed;
+    while (true) {
+        auto start = clock::now();
+        for (uint64_t i = 0; i < iterations; i++) {
+            iteration();
+        }
+        elapsed = clock::now() - start;
+        if (elapsed >= min_time || iterations >= (1ULL << 32)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    double ns_per_iteration = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    double ns_per_item      = ns_per_iteration / items;
+    printf("[ STATS    ] %-32s %10.1f ns per iteration, %8.1f ns per item (%u items, %llu iterations)\n", name.c_str(), ns_per_iteration, ns_per_item, (unsigned)items, (unsigned long long)iterations);
+
+    if (const char* path = std::getenv("QMK_BENCHMARK_JSON")) {
+        const ::testing::TestInfo* test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+        char                       line[512];
+        snprintf(line, sizeof(line), "{\"suite\": \"%s\", \"test\": \"%s\", \"benchmark\": \"%s\", \"iterations\": %llu, \"items\": %u, \"ns_per_iteration\": %.2f, \"ns_per_item\": %.2f}\n", test_info->test_suite_name(), test_info->name(), name.c_str(), (unsigned long long)iterations, (unsigned)items, ns_per_iteration, ns_per_item);
+        std::ofstream(path, std::ios::app) << line;
+    }
+}
@@ -0,0 +1,18 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/*
+ * Times an iteration that processes the given number of items, such as LEDs or key events, and reports the cost of each.
+ *
+ * The iteration is repeated, doubling the count until the run takes at least QMK_BENCHMARK_MIN_TIME milliseconds (20 by
+ * default). Results are printed, and appended as JSON lines to the file named by QMK_BENCHMARK_JSON when it is set.
+ *
+ * Only needs gtest, for the name of the running test, so benchmarks outside the keyboard test harness can use it too.
+ */
+void run_benchmark(const std::string& name, uint32_t items, const std::function<void()>& iteration);
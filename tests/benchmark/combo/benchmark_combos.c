@@ -0,0 +1,40 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Pairs of function keys, none of which share keys with the combo being benchmarked
+#define FILLER_COMBO(first, second) const uint16_t PROGMEM first##_##second##_combo[] = {first, second, COMBO_END};
+
+FILLER_COMBO(KC_F1, KC_F2)
+FILLER_COMBO(KC_F3, KC_F4)
+FILLER_COMBO(KC_F5, KC_F6)
+FILLER_COMBO(KC_F7, KC_F8)
+FILLER_COMBO(KC_F9, KC_F10)
+FILLER_COMBO(KC_F11, KC_F12)
+FILLER_COMBO(KC_F13, KC_F14)
+FILLER_COMBO(KC_F15, KC_F16)
+FILLER_COMBO(KC_F17, KC_F18)
+FILLER_COMBO(KC_F19, KC_F20)
+FILLER_COMBO(KC_F21, KC_F22)
+FILLER_COMBO(KC_F23, KC_F24)
+
+const uint16_t PROGMEM jk_combo[] = {KC_J, KC_K, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    COMBO(KC_F1_KC_F2_combo, KC_1),
+    COMBO(KC_F3_KC_F4_combo, KC_2),
+    COMBO(KC_F5_KC_F6_combo, KC_3),
+    COMBO(KC_F7_KC_F8_combo, KC_4),
+    COMBO(KC_F9_KC_F10_combo, KC_5),
+    COMBO(KC_F11_KC_F12_combo, KC_6),
+    COMBO(KC_F13_KC_F14_combo, KC_7),
+    COMBO(KC_F15_KC_F16_combo, KC_8),
+    COMBO(KC_F17_KC_F18_combo, KC_9),
+    COMBO(KC_F19_KC_F20_combo, KC_0),
+    COMBO(KC_F21_KC_F22_combo, KC_MINS),
+    COMBO(KC_F23_KC_F24_combo, KC_EQL),
+    COMBO(jk_combo, KC_ESC)
+};
+// clang-format on
@@ -0,0 +1,8 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = benchmark_combos.c
+
+SRC += tests/benchmark/benchmark_fixture.cpp tests/benchmark/benchmark_timer.cpp
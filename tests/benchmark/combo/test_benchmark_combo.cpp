@@ -0,0 +1,50 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../benchmark_fixture.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class BenchmarkCombo : public BenchmarkFixture {};
+
+TEST_F(BenchmarkCombo, KeyOutsideCombos) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_A)});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    benchmark("combo_key_outside_combos", 2, []() {
+        press_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+        release_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+    });
+}
+
+TEST_F(BenchmarkCombo, ComboTriggered) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_J), KeymapKey(0, 1, 0, KC_K)});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    benchmark("combo_triggered", 4, []() {
+        press_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+        press_key(1, 0);
+        keyboard_task();
+        advance_time(1);
+        release_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+        release_key(1, 0);
+        keyboard_task();
+        advance_time(1);
+    });
+}
@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// A large matrix, where per-key debouncing costs the most
+#undef MATRIX_ROWS
+#undef MATRIX_COLS
+#define MATRIX_ROWS 20
+#define MATRIX_COLS 20
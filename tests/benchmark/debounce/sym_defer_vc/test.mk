@@ -0,0 +1,7 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+DEBOUNCE_TYPE = sym_defer_vc
+
+# Runs the same benchmarks as the default algorithm
+SRC += tests/benchmark/benchmark_fixture.cpp tests/benchmark/benchmark_timer.cpp tests/benchmark/debounce/test_benchmark_debounce.cpp
@@ -0,0 +1,59 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "../benchmark_fixture.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "debounce.h"
+void advance_time(uint32_t ms);
+}
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+class BenchmarkDebounce : public BenchmarkFixture {
+   protected:
+    matrix_row_t raw[MATRIX_ROWS]    = {};
+    matrix_row_t cooked[MATRIX_ROWS] = {};
+
+    void SetUp() override {
+        debounce_init(MATRIX_ROWS);
+    }
+
+    void TearDown() override {
+        debounce_free();
+    }
+};
+
+TEST_F(BenchmarkDebounce, SteadyMatrix) {
+    benchmark("debounce_steady", 1, [&]() {
+        debounce(raw, cooked, MATRIX_ROWS, false);
+        advance_time(1);
+    });
+}
+
+TEST_F(BenchmarkDebounce, Typing) {
+    // A key changes every 8 scans, giving it time to settle in between
+    uint32_t scan = 0;
+    benchmark("debounce_typing", 1, [&]() {
+        bool changed = scan % 8 == 0;
+        if (changed) {
+            uint8_t key = (scan / 8) % (MATRIX_ROWS * MATRIX_COLS);
+            raw[key / MATRIX_COLS] ^= (matrix_row_t)1 << (key % MATRIX_COLS);
+        }
+        debounce(raw, cooked, MATRIX_ROWS, changed);
+        advance_time(1);
+        scan++;
+    });
+
+    // Let the last change settle, and check it came through
+    for (int i = 0; i < DEBOUNCE * 2; i++) {
+        debounce(raw, cooked, MATRIX_ROWS, false);
+        advance_time(1);
+    }
+    EXPECT_EQ(memcmp(raw, cooked, sizeof(raw)), 0);
+}
@@ -0,0 +1,125 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include "../benchmark_fixture.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_key_override.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+static key_override_t make_override(uint8_t trigger_mods, uint16_t trigger, uint16_t replacement) {
+    key_override_t override  = {};
+    override.trigger         = trigger;
+    override.trigger_mods    = trigger_mods;
+    override.layers          = ~0;
+    override.suppressed_mods = trigger_mods;
+    override.replacement     = replacement;
+    override.options         = ko_options_default;
+    return override;
+}
+
+class BenchmarkKeyOverride : public BenchmarkFixture {
+   protected:
+    std::vector<key_override_t>        overrides;
+    std::vector<const key_override_t*> override_list;
+
+    void SetUp() override {
+        // Forty overrides requiring ctrl, which the benchmarks never hold, then one they do trigger
+        for (uint16_t i = 0; i < 40; i++) {
+            overrides.push_back(make_override(MOD_MASK_CTRL, KC_F1 + (i % 12), KC_F13 + (i % 12)));
+        }
+        overrides.push_back(make_override(MOD_MASK_SHIFT, KC_BSPC, KC_DEL));
+        for (auto& override : overrides) {
+            override_list.push_back(&override);
+        }
+        override_list.push_back(NULL);
+        key_overrides = override_list.data();
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+        key_override_index_invalidate();
+#endif
+    }
+
+    void TearDown() override {
+        key_overrides = NULL;
+    }
+};
+
+TEST_F(BenchmarkKeyOverride, KeyWithoutOverride) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_A)});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    benchmark("key_override_no_match", 2, []() {
+        press_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+        release_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+    });
+}
+
+TEST_F(BenchmarkKeyOverride, OverrideTriggered) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_LSFT), KeymapKey(0, 1, 0, KC_BSPC)});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    press_key(0, 0);
+    keyboard_task();
+    advance_time(1);
+    benchmark("key_override_triggered", 2, []() {
+        press_key(1, 0);
+        keyboard_task();
+        advance_time(1);
+        release_key(1, 0);
+        keyboard_task();
+        advance_time(1);
+    });
+    release_key(0, 0);
+    keyboard_task();
+}
+
+TEST_F(BenchmarkKeyOverride, ScalesWithOverrideCount) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_LSFT), KeymapKey(0, 1, 0, KC_A)});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    // Shift passes the fast mods check, so every override that can't be ruled out by its trigger needs looking at
+    press_key(0, 0);
+    keyboard_task();
+    advance_time(1);
+    for (uint16_t count : {8, 64, 256, 1024}) {
+        overrides.clear();
+        override_list.clear();
+        for (uint16_t i = 0; i < count; i++) {
+            overrides.push_back(make_override(MOD_MASK_SHIFT, KC_F1 + (i % 12), KC_F13 + (i % 12)));
+        }
+        for (auto& override : overrides) {
+            override_list.push_back(&override);
+        }
+        override_list.push_back(NULL);
+        key_overrides = override_list.data();
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+        key_override_index_invalidate();
+#endif
+
+        benchmark("key_override_shifted_" + std::to_string(count), 2, []() {
+            press_key(1, 0);
+            keyboard_task();
+            advance_time(1);
+            release_key(1, 0);
+            keyboard_task();
+            advance_time(1);
+        });
+    }
+    release_key(0, 0);
+    keyboard_task();
+}
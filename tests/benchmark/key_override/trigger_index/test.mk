@@ -0,0 +1,8 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+# Runs the same benchmarks as the linear search
+SRC += tests/benchmark/benchmark_fixture.cpp tests/benchmark/benchmark_timer.cpp
+SRC += tests/benchmark/key_override/test_benchmark_key_override.cpp
@@ -0,0 +1,82 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// rgb_matrix_types.h checks its layout with the C11 spelling
+#define _Static_assert static_assert
+
+#include "../benchmark_fixture.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void advance_time(uint32_t ms);
+
+led_config_t g_led_config = {};
+
+static void mock_init(void) {}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void mock_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+};
+}
+
+class BenchmarkRgbMatrix : public BenchmarkFixture {
+   protected:
+    void SetUp() override {
+        // One LED under each key, laid out in a grid
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint8_t index                   = row * MATRIX_COLS + col;
+                g_led_config.matrix_co[row][col] = index;
+                g_led_config.point[index]        = {(uint8_t)(col * 224 / (MATRIX_COLS - 1)), (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+                g_led_config.flags[index]        = LED_FLAG_KEYLIGHT;
+            }
+        }
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    }
+
+    /* Steps the task through syncing, starting, rendering and flushing a frame. */
+    static void run_frame() {
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (int i = 0; i < 4; i++) {
+            rgb_matrix_task();
+        }
+    }
+
+    static void benchmark_mode(const char* name, uint8_t mode) {
+        rgb_matrix_mode_noeeprom(mode);
+        run_frame();
+        benchmark(name, RGB_MATRIX_LED_COUNT, run_frame);
+    }
+};
+
+TEST_F(BenchmarkRgbMatrix, SolidColor) {
+    benchmark_mode("rgb_matrix_solid_color", RGB_MATRIX_SOLID_COLOR);
+}
+
+TEST_F(BenchmarkRgbMatrix, Breathing) {
+    benchmark_mode("rgb_matrix_breathing", RGB_MATRIX_BREATHING);
+}
+
+TEST_F(BenchmarkRgbMatrix, CycleLeftRight) {
+    benchmark_mode("rgb_matrix_cycle_left_right", RGB_MATRIX_CYCLE_LEFT_RIGHT);
+}
+
+TEST_F(BenchmarkRgbMatrix, CycleOutIn) {
+    benchmark_mode("rgb_matrix_cycle_out_in", RGB_MATRIX_CYCLE_OUT_IN);
+}
+
+TEST_F(BenchmarkRgbMatrix, RainbowMovingChevron) {
+    benchmark_mode("rgb_matrix_rainbow_moving_chevron", RGB_MATRIX_RAINBOW_MOVING_CHEVRON);
+}
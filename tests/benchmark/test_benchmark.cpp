@@ -0,0 +1,65 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark_fixture.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "action_layer.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class Benchmark : public BenchmarkFixture {};
+
+TEST_F(Benchmark, KeyboardTaskIdle) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_A)});
+
+    benchmark("keyboard_task_idle", 1, []() {
+        keyboard_task();
+        advance_time(1);
+    });
+}
+
+TEST_F(Benchmark, KeypressToReport) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 1, 0, LSFT_T(KC_B))});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    benchmark("keypress_to_report", 2, []() {
+        press_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+        release_key(0, 0);
+        keyboard_task();
+        advance_time(1);
+    });
+}
+
+TEST_F(Benchmark, LayerResolution) {
+    TestDriver driver;
+    // Every key falls through three transparent layers to the base layer
+    for (uint8_t layer = 0; layer < 4; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(layer, col, row, layer == 0 ? KC_A : KC_TRNS));
+            }
+        }
+    }
+    layer_state_set(0b1111);
+
+    uint32_t resolved = 0;
+    benchmark("layer_resolution", MATRIX_ROWS * MATRIX_COLS, [&]() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                resolved += layer_switch_get_action({.col = col, .row = row}).code == ACTION_KEY(KC_A);
+            }
+        }
+    });
+    EXPECT_GT(resolved, 0);
+    EXPECT_EQ(resolved % (MATRIX_ROWS * MATRIX_COLS), 0);
+    layer_clear();
+}
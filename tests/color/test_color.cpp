@@ -0,0 +1,84 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+}
+
+static constexpr uint8_t BATCH = 128;
+
+/* Runs f over every HSV color, BATCH hues at a time. */
+template <typename F>
+static void for_each_batch(F f) {
+    HSV hsv[BATCH];
+    for (uint32_t sv = 0; sv <= UINT16_MAX; sv++) {
+        for (uint16_t h = 0; h < 256; h += BATCH) {
+            for (uint8_t i = 0; i < BATCH; i++) {
+                hsv[i] = (HSV){.h = (uint8_t)(h + i), .s = (uint8_t)(sv >> 8), .v = (uint8_t)sv};
+            }
+            f(hsv);
+        }
+    }
+}
+
+TEST(Color, BatchMatchesScalar) {
+    uint32_t mismatches = 0;
+
+    for_each_batch([&](const HSV *hsv) {
+        RGB rgb[BATCH];
+        hsv_to_rgb_batch(hsv, rgb, BATCH);
+        for (uint8_t i = 0; i < BATCH; i++) {
+            RGB expected = hsv_to_rgb(hsv[i]);
+            if (rgb[i].r != expected.r || rgb[i].g != expected.g || rgb[i].b != expected.b) {
+                if (mismatches++ == 0) {
+                    ADD_FAILURE() << "hsv " << +hsv[i].h << "," << +hsv[i].s << "," << +hsv[i].v;
+                }
+            }
+        }
+    });
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST(Color, BatchHandlesPartialBatches) {
+    HSV hsv[3] = {{0, 255, 255}, {85, 255, 255}, {170, 255, 255}};
+    RGB rgb[4] = {};
+
+    hsv_to_rgb_batch(hsv, rgb, 3);
+    EXPECT_EQ(rgb[0].r, 255);
+    EXPECT_EQ(rgb[1].g, 255);
+    EXPECT_EQ(rgb[2].b, 255);
+    EXPECT_EQ(rgb[3].r | rgb[3].g | rgb[3].b, 0);
+
+    hsv_to_rgb_batch(hsv, rgb, 0);
+    EXPECT_EQ(rgb[0].r, 255);
+}
+
+TEST(Color, Benchmark) {
+    using clock  = std::chrono::steady_clock;
+    uint32_t sum = 0;
+
+    auto start = clock::now();
+    for_each_batch([&](const HSV *hsv) {
+        for (uint8_t i = 0; i < BATCH; i++) {
+            sum += hsv_to_rgb(hsv[i]).g;
+        }
+    });
+    auto scalar = clock::now() - start;
+
+    start = clock::now();
+    for_each_batch([&](const HSV *hsv) {
+        RGB rgb[BATCH];
+        hsv_to_rgb_batch(hsv, rgb, BATCH);
+        for (uint8_t i = 0; i < BATCH; i++) {
+            sum -= rgb[i].g;
+        }
+    });
+    auto batch = clock::now() - start;
+
+    EXPECT_EQ(sum, 0);
+    RecordProperty("scalar_ps_per_color", (int)(std::chrono::duration<double, std::pico>(scalar).count() / (1 << 24)));
+    RecordProperty("batch_ps_per_color", (int)(std::chrono::duration<double, std::pico>(batch).count() / (1 << 24)));
+}
@@ -0,0 +1,126 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <string>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static uint16_t combo_index_test_keys[325][3];
+static uint16_t combo_index_test_count = 0;
+
+extern "C" {
+extern combo_t key_combos[];
+
+uint16_t combo_count(void) {
+    return combo_index_test_count;
+}
+}
+
+/* Every generated combo is a unique pair of letters, 325 pairs in total. */
+static void combo_index_test_setup(uint16_t count) {
+    uint16_t combo = 0;
+    for (uint16_t first = 0; first < 26 && combo < count; first++) {
+        for (uint16_t second = first + 1; second < 26 && combo < count; second++, combo++) {
+            combo_index_test_keys[combo][0] = KC_A + first;
+            combo_index_test_keys[combo][1] = KC_A + second;
+            combo_index_test_keys[combo][2] = COMBO_END;
+            key_combos[combo]               = (combo_t)COMBO(combo_index_test_keys[combo], (uint16_t)(KC_F1 + (combo % 12)));
+        }
+    }
+    combo_index_test_count = combo;
+}
+
+class ComboKeycodeIndex : public TestFixture {};
+
+TEST_F(ComboKeycodeIndex, combo_among_many_is_triggered) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_y(0, 2, 0, KC_Y);
+    KeymapKey  key_z(0, 3, 0, KC_Z);
+    set_keymap({key_a, key_b, key_y, key_z});
+
+    combo_index_test_setup(325);
+
+    /* First and last generated combo. */
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F1 + (324 % 12)));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_z});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, combo_key_alone_is_sent_after_combo_term) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    combo_index_test_setup(64);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a, COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, index_follows_combo_count) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_z(0, 1, 0, KC_Z);
+    set_keymap({key_a, key_z});
+
+    /* A+Z is combo #24, not part of the first 10 combos. */
+    combo_index_test_setup(10);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_Z));
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_z});
+    VERIFY_AND_CLEAR(driver);
+
+    combo_index_test_setup(25);
+
+    EXPECT_REPORT(driver, (KC_F1 + (24 % 12)));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_z});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, per_event_cost_by_combo_count) {
+    TestDriver    driver;
+    constexpr int iterations = 20000;
+
+    for (uint16_t count : {8, 32, 128, 256}) {
+        combo_index_test_setup(count);
+
+        /* KC_1 isn't part of any combo, this is the cost every regular key press pays. */
+        keyrecord_t press     = {};
+        press.event.type      = KEY_EVENT;
+        press.event.pressed   = true;
+        keyrecord_t release   = press;
+        release.event.pressed = false;
+        process_combo(KC_1, &press);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            process_combo(KC_1, &press);
+            process_combo(KC_1, &release);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (iterations * 2);
+
+        RecordProperty("ns_per_event_" + std::to_string(count) + "_combos", (int)ns);
+    }
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,7 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+/* Combo keys are generated at runtime by the tests, see combo_index_test_setup(). */
+combo_t key_combos[325];
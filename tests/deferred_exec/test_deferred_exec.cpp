@@ -0,0 +1,180 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+
+void advance_time(uint32_t ms);
+}
+
+static std::vector<uintptr_t> calls;
+
+static uint32_t record(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back((uintptr_t)cb_arg);
+    return 0;
+}
+
+static uint32_t repeat_10ms(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back((uintptr_t)cb_arg);
+    return 10;
+}
+
+class DeferredExec : public TestFixture {
+   protected:
+    static constexpr size_t TABLE_SIZE = 8;
+
+    deferred_executor_t table[TABLE_SIZE] = {};
+    uint32_t            last_exec         = 0;
+
+    void SetUp() override {
+        calls.clear();
+        last_exec = timer_read32();
+    }
+
+    deferred_token defer(uint32_t delay_ms, deferred_exec_callback callback, uintptr_t id) {
+        return defer_exec_advanced(table, TABLE_SIZE, delay_ms, callback, (void *)id);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+        }
+    }
+};
+
+TEST_F(DeferredExec, RunsInTriggerOrder) {
+    defer(30, record, 3);
+    defer(10, record, 1);
+    defer(40, record, 4);
+    defer(20, record, 2);
+
+    run_for(9);
+    EXPECT_TRUE(calls.empty());
+    run_for(40);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{1, 2, 3, 4}));
+}
+
+TEST_F(DeferredExec, CancelAndExtend) {
+    deferred_token a = defer(10, record, 1);
+    deferred_token b = defer(20, record, 2);
+    deferred_token c = defer(30, record, 3);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, b));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, b));
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, a, 50));
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, c, 5));
+
+    run_for(60);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{3, 1}));
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, a, 10));
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToTrigger) {
+    defer(10, repeat_10ms, 1);
+    defer(15, record, 2);
+
+    run_for(35);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{1, 2, 1, 1}));
+}
+
+TEST_F(DeferredExec, OverdueRepeatCatchesUpOncePerPass) {
+    defer(10, repeat_10ms, 1);
+    defer(30, record, 2);
+
+    // Three repeats are overdue, but only one runs per pass, and the other executor still gets its turn
+    advance_time(35);
+    deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{1, 2}));
+
+    run_for(1);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{1, 2, 1}));
+    run_for(1);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{1, 2, 1, 1}));
+    run_for(1);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{1, 2, 1, 1})) << "Caught up, next repeat is not due yet";
+}
+
+TEST_F(DeferredExec, TableCapacity) {
+    std::vector<deferred_token> tokens;
+    for (uintptr_t i = 0; i < TABLE_SIZE; i++) {
+        tokens.push_back(defer(100 - i, record, i));
+        EXPECT_NE(tokens.back(), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer(10, record, 99), INVALID_DEFERRED_TOKEN);
+
+    // Freeing any slot makes room again
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, tokens[3]));
+    EXPECT_NE(defer(10, record, 99), INVALID_DEFERRED_TOKEN);
+
+    run_for(100);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{99, 7, 6, 5, 4, 2, 1, 0}));
+}
+
+TEST_F(DeferredExec, NextTrigger) {
+    uint32_t trigger;
+    EXPECT_FALSE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &trigger));
+
+    uint32_t       now = timer_read32();
+    deferred_token a   = defer(25, record, 1);
+    defer(40, record, 2);
+    EXPECT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &trigger));
+    EXPECT_EQ(trigger, now + 25);
+
+    cancel_deferred_exec_advanced(table, TABLE_SIZE, a);
+    EXPECT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &trigger));
+    EXPECT_EQ(trigger, now + 40);
+}
+
+static deferred_executor_t *callback_table;
+static deferred_token       callback_token;
+
+static uint32_t cancel_self_and_requeue(uint32_t trigger_time, void *cb_arg) {
+    calls.push_back((uintptr_t)cb_arg);
+    cancel_deferred_exec_advanced(callback_table, 8, callback_token);
+    callback_token = defer_exec_advanced(callback_table, 8, 5, record, (void *)((uintptr_t)cb_arg + 1));
+    return 10;
+}
+
+TEST_F(DeferredExec, CallbackCanRequeueItself) {
+    callback_table = table;
+    callback_token = defer(10, cancel_self_and_requeue, 1);
+
+    run_for(30);
+    EXPECT_EQ(calls, (std::vector<uintptr_t>{1, 2}));
+}
+
+TEST_F(DeferredExec, ManyRandomTimers) {
+    srand(1234);
+    for (int round = 0; round < 50; round++) {
+        std::vector<deferred_token> tokens;
+        for (uintptr_t i = 0; i < TABLE_SIZE; i++) {
+            tokens.push_back(defer(1 + rand() % 200, record, i));
+        }
+        for (int i = 0; i < 3; i++) {
+            cancel_deferred_exec_advanced(table, TABLE_SIZE, tokens[rand() % TABLE_SIZE]);
+        }
+
+        // Everything still queued fires in trigger order
+        std::vector<std::pair<uint32_t, uintptr_t>> pending;
+        for (auto &entry : table) {
+            if (entry.token != INVALID_DEFERRED_TOKEN) {
+                pending.push_back({entry.trigger_time, (uintptr_t)entry.cb_arg});
+            }
+        }
+        calls.clear();
+        run_for(200);
+        ASSERT_EQ(calls.size(), pending.size());
+        for (size_t i = 1; i < calls.size(); i++) {
+            uint32_t prev = 0, curr = 0;
+            for (auto &p : pending) {
+                if (p.second == calls[i - 1]) prev = p.first;
+                if (p.second == calls[i]) curr = p.first;
+            }
+            EXPECT_LE(prev, curr);
+        }
+    }
+}
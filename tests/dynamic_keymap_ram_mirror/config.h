@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for eeconfig, four layers of keymap and the dynamic macros
+#define EEPROM_SIZE 512
+
+#define DYNAMIC_KEYMAP_RAM_MIRROR
+#define DYNAMIC_KEYMAP_RAM_MIRROR_WRITE_DELAY 100
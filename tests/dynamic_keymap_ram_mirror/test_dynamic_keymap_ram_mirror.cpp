@@ -0,0 +1,61 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+
+class DynamicKeymapRamMirror : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        dynamic_keymap_reset();
+    }
+
+    /* Reads the keycode straight from EEPROM, bypassing the mirror. */
+    static uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymapRamMirror, EditsWrittenBackAfterDelay) {
+    dynamic_keymap_set_keycode(0, 2, 3, KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 2, 3), KC_A);
+    EXPECT_EQ(eeprom_keycode(0, 2, 3), KC_NO) << "The edit should be held in RAM";
+
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_WRITE_DELAY);
+    EXPECT_EQ(eeprom_keycode(0, 2, 3), KC_NO);
+
+    run_one_scan_loop();
+    EXPECT_EQ(eeprom_keycode(0, 2, 3), KC_A);
+}
+
+TEST_F(DynamicKeymapRamMirror, ResetRewritesErasedEeprom) {
+    /* Erase the keymap underneath the mirror, as eeconfig_init_quantum() does on flash backed drivers. */
+    for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                eeprom_update_word((uint16_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column), 0xFFFF);
+            }
+        }
+    }
+
+    dynamic_keymap_reset();
+
+    for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(eeprom_keycode(layer, row, column), keycode_at_keymap_location_raw(layer, row, column)) << "layer " << +layer << " row " << +row << " column " << +column;
+            }
+        }
+    }
+}
@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for 64 bytes of encoded events, 32 taps of a key in the first column
+#define DYNAMIC_MACRO_SIZE 8
+#define DYNAMIC_MACRO_BUFFER_SIZE 64
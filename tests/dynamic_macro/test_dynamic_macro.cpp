@@ -0,0 +1,195 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_dynamic_macro.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   protected:
+    TestDriver driver;
+    KeymapKey  key_a     = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b     = KeymapKey(0, 0, 1, KC_B);
+    KeymapKey  key_rec1  = KeymapKey(0, 1, 0, DM_REC1);
+    KeymapKey  key_rec2  = KeymapKey(0, 2, 0, DM_REC2);
+    KeymapKey  key_stop  = KeymapKey(0, 3, 0, DM_RSTP);
+    KeymapKey  key_play1 = KeymapKey(0, 4, 0, DM_PLY1);
+    KeymapKey  key_play2 = KeymapKey(0, 5, 0, DM_PLY2);
+
+    void SetUp() override {
+        set_keymap({key_a, key_b, key_rec1, key_rec2, key_stop, key_play1, key_play2});
+
+        // Leave macro 2 empty, so that macro 1 has the whole buffer
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        tap_keys(key_rec2, key_stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    void ExpectTaps(uint16_t keycode, unsigned count) {
+        InSequence s;
+        for (unsigned i = 0; i < count; i++) {
+            EXPECT_REPORT(driver, (keycode));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+    }
+};
+
+TEST_F(DynamicMacro, PlaysBackWithoutBlocking) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_b, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // One event is played back per pass, starting with the pass the macro is played in
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_play1);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    run_one_scan_loop();
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, KeysHeldWhenStoppingNotRecorded) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a);
+    key_b.press();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    ExpectTaps(KC_A, 1);
+    tap_key(key_play1);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, SecondMacro) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_stop);
+    tap_keys(key_rec2, key_b, key_b, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    ExpectTaps(KC_B, 2);
+    tap_key(key_play2);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    ExpectTaps(KC_A, 1);
+    tap_key(key_play1);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, HoldsMoreEventsThanKeyRecords) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    for (int i = 0; i < DYNAMIC_MACRO_SIZE * 2; i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    ExpectTaps(KC_A, DYNAMIC_MACRO_SIZE * 2);
+    tap_key(key_play1);
+    idle_for(DYNAMIC_MACRO_SIZE * 8);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, RecordingStopsWhenFull) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    for (int i = 0; i < DYNAMIC_MACRO_BUFFER_SIZE; i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // Each event takes two bytes
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    ExpectTaps(KC_A, DYNAMIC_MACRO_BUFFER_SIZE / 4);
+    tap_key(key_play1);
+    idle_for(DYNAMIC_MACRO_BUFFER_SIZE * 2);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, RecursionIgnored) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_play1, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    ExpectTaps(KC_A, 1);
+    tap_key(key_play1);
+    idle_for(100);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, PlayingAgainReplaysOnceDone) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_b, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+    }
+    tap_key(key_play1);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    tap_key(key_play1);
+    idle_for(100);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, NestedMacroPlaysToCompletion) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec2, key_b, key_stop);
+    tap_keys(key_rec1, key_a, key_play2, key_a, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_A));
+    }
+    tap_key(key_play1);
+    idle_for(100);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,13 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for eeconfig, four layers of keymap, the dynamic keymap macros and the recorded macros
+#define EEPROM_SIZE 1024
+
+// Left at the default buffer size, which is only known to the compiler
+#define DYNAMIC_MACRO_SIZE 8
+#define DYNAMIC_MACRO_EEPROM_STORAGE
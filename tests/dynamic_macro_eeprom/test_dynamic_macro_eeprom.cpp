@@ -0,0 +1,126 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeconfig.h"
+#include "process_dynamic_macro.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacroEeprom : public TestFixture {
+   protected:
+    TestDriver driver;
+    KeymapKey  key_a     = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b     = KeymapKey(0, 0, 1, KC_B);
+    KeymapKey  key_rec1  = KeymapKey(0, 1, 0, DM_REC1);
+    KeymapKey  key_rec2  = KeymapKey(0, 2, 0, DM_REC2);
+    KeymapKey  key_stop  = KeymapKey(0, 3, 0, DM_RSTP);
+    KeymapKey  key_play1 = KeymapKey(0, 4, 0, DM_PLY1);
+    KeymapKey  key_play2 = KeymapKey(0, 5, 0, DM_PLY2);
+
+    void SetUp() override {
+        set_keymap({key_a, key_b, key_rec1, key_rec2, key_stop, key_play1, key_play2});
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+    }
+
+    void ExpectPlayback(KeymapKey &key_play, std::vector<uint16_t> keycodes) {
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        {
+            InSequence s;
+            for (uint16_t keycode : keycodes) {
+                EXPECT_REPORT(driver, (keycode));
+            }
+        }
+        tap_key(key_play);
+        idle_for(100);
+        EXPECT_FALSE(dynamic_macro_is_playing());
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(DynamicMacroEeprom, SavedMacrosReloaded) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_b, key_stop);
+    tap_keys(key_rec2, key_b, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    uint8_t saved[DYNAMIC_MACRO_EEPROM_SIZE];
+    dynamic_keymap_recorded_macro_get_buffer(0, sizeof(saved), saved);
+
+    // Record over both macros, then put back what was saved before, as if the keyboard had restarted
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_b, key_stop);
+    tap_keys(key_rec2, key_a, key_a, key_a, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    dynamic_keymap_recorded_macro_set_buffer(0, sizeof(saved), saved);
+    dynamic_macro_init();
+
+    ExpectPlayback(key_play1, {KC_A, KC_B});
+    ExpectPlayback(key_play2, {KC_B});
+}
+
+TEST_F(DynamicMacroEeprom, CorruptHeaderRejected) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // A length longer than the buffer
+    uint16_t length = DYNAMIC_MACRO_BUFFER_SIZE + 1;
+    dynamic_keymap_recorded_macro_set_buffer(2, sizeof(length), (uint8_t *)&length);
+    dynamic_macro_init();
+    ExpectPlayback(key_play1, {});
+
+    uint16_t header[3];
+    dynamic_keymap_recorded_macro_get_buffer(0, sizeof(header), (uint8_t *)header);
+    EXPECT_EQ(header[0], DYNAMIC_MACRO_BUFFER_SIZE);
+    EXPECT_EQ(header[1], 0);
+    EXPECT_EQ(header[2], 0);
+}
+
+TEST_F(DynamicMacroEeprom, SaveRewritesWholeHeader) {
+    // An erased header, as left by the EEPROM driver erasing everything
+    uint16_t header[3] = {0, 0, 0};
+    dynamic_keymap_recorded_macro_set_buffer(0, sizeof(header), (uint8_t *)header);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec2, key_b, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    dynamic_keymap_recorded_macro_get_buffer(0, sizeof(header), (uint8_t *)header);
+    EXPECT_EQ(header[0], DYNAMIC_MACRO_BUFFER_SIZE);
+
+    dynamic_macro_init();
+    ExpectPlayback(key_play2, {KC_B});
+}
+
+TEST_F(DynamicMacroEeprom, MacroResetClearsRecordedMacros) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_stop);
+    tap_keys(key_rec2, key_b, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    dynamic_keymap_macro_reset();
+    ExpectPlayback(key_play1, {});
+    ExpectPlayback(key_play2, {});
+}
+
+TEST_F(DynamicMacroEeprom, EepromResetClearsRecordedMacros) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_keys(key_rec1, key_a, key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    eeconfig_init();
+    ExpectPlayback(key_play1, {});
+
+    dynamic_macro_init();
+    ExpectPlayback(key_play1, {});
+}
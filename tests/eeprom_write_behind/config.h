@@ -0,0 +1,13 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for some scratch space past eeconfig
+#define EEPROM_SIZE 128
+
+#define EEPROM_WRITE_BEHIND_DELAY 100
+#define EEPROM_WRITE_BEHIND_BLOCK_SIZE 8
+#define EEPROM_WRITE_BEHIND_BLOCK_COUNT 4
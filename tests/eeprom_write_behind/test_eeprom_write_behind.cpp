@@ -0,0 +1,111 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+#include "eeprom_write_behind.h"
+
+uint32_t eeprom_test_write_count(void);
+void     shutdown_quantum(bool jump_to_bootloader);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// Somewhere past eeconfig, aligned to a cache block
+#define SCRATCH_ADDRESS ((uint8_t *)(EECONFIG_SIZE + 2 * EEPROM_WRITE_BEHIND_BLOCK_SIZE - EECONFIG_SIZE % EEPROM_WRITE_BEHIND_BLOCK_SIZE))
+
+class EepromWriteBehind : public TestFixture {
+   protected:
+    TestDriver driver;
+    uint32_t   writes;
+
+    void SetUp() override {
+        eeprom_write_behind_flush();
+        writes = eeprom_test_write_count();
+    }
+
+    uint32_t writes_since_setup() {
+        return eeprom_test_write_count() - writes;
+    }
+};
+
+TEST_F(EepromWriteBehind, WritesHeldUntilQuietPeriod) {
+    eeconfig_update_user(0x12345678);
+    EXPECT_TRUE(eeprom_write_behind_pending());
+    EXPECT_EQ(writes_since_setup(), 0);
+    EXPECT_EQ(eeconfig_read_user(), 0x12345678) << "Reads should see writes still held in the cache";
+
+    idle_for(EEPROM_WRITE_BEHIND_DELAY);
+    EXPECT_EQ(writes_since_setup(), 0);
+
+    run_one_scan_loop();
+    EXPECT_FALSE(eeprom_write_behind_pending());
+    EXPECT_EQ(writes_since_setup(), 4);
+    EXPECT_EQ(eeconfig_read_user(), 0x12345678);
+}
+
+TEST_F(EepromWriteBehind, RepeatedWritesCoalesced) {
+    for (uint32_t i = 1; i <= 10; i++) {
+        eeconfig_update_user(i);
+        idle_for(EEPROM_WRITE_BEHIND_DELAY / 2);
+    }
+    EXPECT_EQ(writes_since_setup(), 0) << "Each write should restart the quiet period";
+
+    idle_for(EEPROM_WRITE_BEHIND_DELAY);
+    EXPECT_EQ(writes_since_setup(), 4) << "Only the last value should have been written";
+    EXPECT_EQ(eeconfig_read_user(), 10);
+}
+
+TEST_F(EepromWriteBehind, OverlappingWritesMerged) {
+    const uint8_t first[]  = {1, 2, 3, 4, 5, 6};
+    const uint8_t second[] = {9, 9, 9};
+    eeprom_write_block(first, SCRATCH_ADDRESS, sizeof(first));
+    eeprom_write_block(second, SCRATCH_ADDRESS + 2, sizeof(second));
+
+    uint8_t expected[] = {0, 1, 2, 9, 9, 9, 6, 0};
+    uint8_t read[sizeof(expected)];
+    eeprom_read_block(read, SCRATCH_ADDRESS - 1, sizeof(read));
+    EXPECT_EQ(memcmp(read, expected, sizeof(expected)), 0);
+
+    eeprom_write_behind_flush();
+    EXPECT_EQ(writes_since_setup(), sizeof(first));
+    eeprom_read_block(read, SCRATCH_ADDRESS - 1, sizeof(read));
+    EXPECT_EQ(memcmp(read, expected, sizeof(expected)), 0);
+}
+
+TEST_F(EepromWriteBehind, FullCacheWrittenBack) {
+    for (uint8_t block = 0; block < EEPROM_WRITE_BEHIND_BLOCK_COUNT; block++) {
+        eeprom_write_byte(SCRATCH_ADDRESS + block * EEPROM_WRITE_BEHIND_BLOCK_SIZE, block + 1);
+    }
+    EXPECT_EQ(writes_since_setup(), 0);
+
+    // One more block than there's room for writes back everything held so far, then holds the new write
+    eeprom_write_byte(SCRATCH_ADDRESS + EEPROM_WRITE_BEHIND_BLOCK_COUNT * EEPROM_WRITE_BEHIND_BLOCK_SIZE, 0xAA);
+    EXPECT_EQ(writes_since_setup(), EEPROM_WRITE_BEHIND_BLOCK_COUNT);
+    EXPECT_TRUE(eeprom_write_behind_pending());
+
+    for (uint8_t block = 0; block < EEPROM_WRITE_BEHIND_BLOCK_COUNT; block++) {
+        EXPECT_EQ(eeprom_read_byte(SCRATCH_ADDRESS + block * EEPROM_WRITE_BEHIND_BLOCK_SIZE), block + 1);
+    }
+    EXPECT_EQ(eeprom_read_byte(SCRATCH_ADDRESS + EEPROM_WRITE_BEHIND_BLOCK_COUNT * EEPROM_WRITE_BEHIND_BLOCK_SIZE), 0xAA);
+}
+
+TEST_F(EepromWriteBehind, FlushedOnSuspend) {
+    eeconfig_update_user(0xCAFEF00D);
+    suspend_power_down_quantum();
+    EXPECT_FALSE(eeprom_write_behind_pending());
+    EXPECT_EQ(writes_since_setup(), 4);
+}
+
+TEST_F(EepromWriteBehind, FlushedOnShutdown) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    eeconfig_update_user(0xDEADBEEF);
+    shutdown_quantum(false);
+    EXPECT_FALSE(eeprom_write_behind_pending());
+    EXPECT_EQ(writes_since_setup(), 4);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,6 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTO_SHIFT_ENABLE = yes
+
+SRC += tests/fuzz/fuzz_fixture.cpp
@@ -0,0 +1,16 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../fuzz_fixture.hpp"
+#include "quantum.h"
+
+class FuzzAutoShift : public FuzzFixture {};
+
+TEST_F(FuzzAutoShift, AutoShiftStream) {
+    // clang-format off
+    run_stream("autoshift", {
+        KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 1, 0, KC_B), KeymapKey(0, 2, 0, KC_1), KeymapKey(0, 3, 0, KC_MINS),
+        KeymapKey(0, 4, 0, KC_E), KeymapKey(0, 5, 0, LSFT_T(KC_F)), KeymapKey(0, 6, 0, KC_SPC), KeymapKey(0, 7, 0, KC_DOT),
+    });
+    // clang-format on
+}
@@ -0,0 +1,18 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { ab_esc, cd_tab, efg_enter };
+
+uint16_t const ab_combo[]  = {KC_A, KC_B, COMBO_END};
+uint16_t const cd_combo[]  = {KC_C, KC_D, COMBO_END};
+uint16_t const efg_combo[] = {KC_E, KC_F, KC_G, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab_esc]    = COMBO(ab_combo, KC_ESC),
+    [cd_tab]    = COMBO(cd_combo, KC_TAB),
+    [efg_enter] = COMBO(efg_combo, KC_ENT)
+};
+// clang-format on
@@ -0,0 +1,16 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../fuzz_fixture.hpp"
+#include "quantum.h"
+
+class FuzzCombo : public FuzzFixture {};
+
+TEST_F(FuzzCombo, ComboStream) {
+    // clang-format off
+    run_stream("combo", {
+        KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 1, 0, KC_B), KeymapKey(0, 2, 0, KC_C), KeymapKey(0, 3, 0, KC_D),
+        KeymapKey(0, 4, 0, KC_E), KeymapKey(0, 5, 0, KC_F), KeymapKey(0, 6, 0, KC_G), KeymapKey(0, 7, 0, LSFT_T(KC_H)),
+    });
+    // clang-format on
+}
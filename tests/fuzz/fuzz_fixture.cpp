@@ -0,0 +1,205 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "fuzz_fixture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "test_driver.hpp"
+
+extern "C" {
+#include "action_layer.h"
+#include "action_tapping.h"
+#include "test_matrix.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::Invoke;
+
+// How long after the physical key is released the host may still see it down, to allow for tap and hold resolution
+#define FUZZ_RESOLVE_SLACK (TAPPING_TERM * 3)
+
+// How long to let the keyboard settle after the last event
+#define FUZZ_SETTLE_TIME 5000
+
+static uint32_t env_or(const char* name, uint32_t fallback) {
+    const char* value = std::getenv(name);
+    return value ? (uint32_t)std::strtoul(value, nullptr, 0) : fallback;
+}
+
+static uint32_t clamp_duration(double ms) {
+    return (uint32_t)std::min(std::max(ms, 1.0), 2000.0);
+}
+
+std::vector<KeyStreamEvent> FuzzFixture::generate_stream(const std::vector<KeymapKey>& keys, size_t presses, uint32_t seed) {
+    std::mt19937 rng(seed);
+    // Typing intervals are roughly log-normal: mostly quick rolls, with a long tail of pauses. Some presses are held, as for modifiers and layers.
+    std::lognormal_distribution<double> gap(std::log(110.0), 0.6);
+    std::lognormal_distribution<double> tap(std::log(80.0), 0.5);
+    std::lognormal_distribution<double> hold(std::log(350.0), 0.4);
+    std::bernoulli_distribution         is_hold(0.15);
+    std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+
+    std::vector<KeyStreamEvent> stream;
+    std::vector<uint32_t>       free_at(keys.size(), 0);
+    uint32_t                    time = 0;
+    for (size_t i = 0; i < presses; i++) {
+        time += clamp_duration(gap(rng));
+
+        // Pick a key that isn't still held, waiting for one to come up if they all are
+        size_t index = pick(rng);
+        for (size_t tries = 0; free_at[index] > time && tries < keys.size(); tries++) {
+            index = (index + 1) % keys.size();
+        }
+        if (free_at[index] > time) {
+            index = std::min_element(free_at.begin(), free_at.end()) - free_at.begin();
+            time  = free_at[index];
+        }
+
+        uint32_t duration = clamp_duration(is_hold(rng) ? hold(rng) : tap(rng));
+        stream.push_back({time, keys[index].position.col, keys[index].position.row, true});
+        stream.push_back({time + duration, keys[index].position.col, keys[index].position.row, false});
+        free_at[index] = time + duration + 1;
+    }
+
+    std::stable_sort(stream.begin(), stream.end(), [](const KeyStreamEvent& a, const KeyStreamEvent& b) { return a.time < b.time; });
+    return stream;
+}
+
+std::vector<KeyStreamEvent> FuzzFixture::load_stream(const std::string& path) {
+    std::vector<KeyStreamEvent> stream;
+    std::ifstream               file(path);
+    std::string                 line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           col, row;
+        char               direction;
+        if (line.empty() || line[0] == '#' || !(fields >> time >> col >> row >> direction)) {
+            continue;
+        }
+        stream.push_back({time, (uint8_t)col, (uint8_t)row, direction == 'd'});
+    }
+    EXPECT_FALSE(stream.empty()) << "no events in " << path;
+    return stream;
+}
+
+void FuzzFixture::save_stream(const std::vector<KeyStreamEvent>& stream, const std::string& path) {
+    std::ofstream file(path);
+    for (const KeyStreamEvent& event : stream) {
+        file << event.time << ' ' << +event.col << ' ' << +event.row << ' ' << (event.pressed ? 'd' : 'u') << '\n';
+    }
+}
+
+void FuzzFixture::run_stream(const char* pipeline, const std::vector<KeymapKey>& keys) {
+    TestDriver driver;
+
+    keymap.clear();
+    std::vector<KeymapKey> base_keys;
+    for (const KeymapKey& key : keys) {
+        add_key(key);
+        if (key.layer == 0) {
+            base_keys.push_back(key);
+        }
+    }
+
+    uint32_t                    seed = env_or("QMK_FUZZ_SEED", 1);
+    std::vector<KeyStreamEvent> stream;
+    if (const char* replay = std::getenv("QMK_FUZZ_REPLAY")) {
+        stream = load_stream(replay);
+    } else {
+        stream = generate_stream(base_keys, env_or("QMK_FUZZ_PRESSES", 2000), seed);
+    }
+    if (const char* record = std::getenv("QMK_FUZZ_RECORD")) {
+        save_stream(stream, record);
+    }
+    SCOPED_TRACE(std::string(pipeline) + " stream, seed " + std::to_string(seed));
+
+    // The longest any key is physically held, which bounds how long the host should see anything held
+    uint32_t longest_hold = 0;
+    for (auto press = stream.cbegin(); press != stream.cend(); press++) {
+        if (press->pressed) {
+            auto release = std::find_if(press + 1, stream.cend(), [&](const KeyStreamEvent& event) { return !event.pressed && event.col == press->col && event.row == press->row; });
+            ASSERT_NE(release, stream.cend()) << "key " << +press->col << "," << +press->row << " is never released";
+            longest_hold = std::max(longest_hold, release->time - press->time);
+        }
+    }
+
+    // Follow the host's view of which keys and modifiers are down, indexed by HID usage with modifiers at 0xE0 onwards
+    std::vector<int64_t> down_since(256, -1);
+    size_t               downs = 0, ups = 0, reports = 0, stuck = 0;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) {
+        std::vector<bool> now_down(256, false);
+        for (uint8_t key : report.keys) {
+            if (key != KC_NO) {
+                now_down[key] = true;
+            }
+        }
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            now_down[0xE0 + bit] = report.mods & (1 << bit);
+        }
+
+        uint32_t now = timer_read32();
+        for (size_t code = 0; code < now_down.size(); code++) {
+            if (now_down[code] && down_since[code] < 0) {
+                down_since[code] = now;
+                downs++;
+            } else if (!now_down[code] && down_since[code] >= 0) {
+                if (now - down_since[code] > longest_hold + FUZZ_RESOLVE_SLACK) {
+                    ADD_FAILURE() << "0x" << std::hex << code << std::dec << " was down for " << now - down_since[code] << "ms, until " << now << "ms";
+                    stuck++;
+                }
+                down_since[code] = -1;
+                ups++;
+            }
+        }
+        reports++;
+    }));
+
+    uint8_t peak_waiting = 0;
+    auto    step         = [&]() {
+        keyboard_task();
+        advance_time(1);
+        peak_waiting = std::max(peak_waiting, action_tapping_waiting_count());
+    };
+
+    auto wall_start = std::chrono::steady_clock::now();
+    for (const KeyStreamEvent& event : stream) {
+        while (timer_read32() < event.time) {
+            step();
+        }
+        if (event.pressed) {
+            press_key(event.col, event.row);
+        } else {
+            release_key(event.col, event.row);
+        }
+    }
+    for (uint32_t i = 0; i < FUZZ_SETTLE_TIME; i++) {
+        step();
+    }
+    std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_start;
+
+    // Every key that went down came back up, nothing is left waiting to resolve, and no layer is left on
+    EXPECT_EQ(downs, ups);
+    for (size_t code = 0; code < down_since.size(); code++) {
+        EXPECT_LT(down_since[code], 0) << "0x" << std::hex << code << " is stuck down";
+    }
+    EXPECT_EQ(stuck, 0);
+    EXPECT_LT(peak_waiting, WAITING_BUFFER_SIZE - 1) << "the waiting buffer filled up";
+    EXPECT_EQ(action_tapping_waiting_count(), 0);
+    EXPECT_EQ(layer_state, 0);
+    EXPECT_GT(reports, 0);
+
+    RecordProperty("events_per_second", (int)(stream.size() / wall_time.count()));
+    RecordProperty("waiting_buffer_peak", peak_waiting);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
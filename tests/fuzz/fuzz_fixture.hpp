@@ -0,0 +1,35 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "test_fixture.hpp"
+
+/* A key going down or up, at a time in milliseconds from the start of the stream. */
+struct KeyStreamEvent {
+    uint32_t time;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+/*
+ * Replays long keystroke streams through the keyboard at full host speed, checking that nothing gets stuck along the way.
+ *
+ * Streams are generated from a seed unless QMK_FUZZ_REPLAY names a recorded one. QMK_FUZZ_SEED and QMK_FUZZ_PRESSES tune
+ * the generated stream, and QMK_FUZZ_RECORD saves whichever stream was run, so a failing seed can be kept and replayed.
+ */
+class FuzzFixture : public TestFixture {
+   protected:
+    /* Generates presses of the given keys, with typing-like timing. The same seed always gives the same stream. */
+    static std::vector<KeyStreamEvent> generate_stream(const std::vector<KeymapKey>& keys, size_t presses, uint32_t seed);
+
+    /* Reads and writes streams as lines of "<time> <col> <row> <d|u>". */
+    static std::vector<KeyStreamEvent> load_stream(const std::string& path);
+    static void                        save_stream(const std::vector<KeyStreamEvent>& stream, const std::string& path);
+
+    /* Sets the keymap, runs a stream of base layer key presses through it, and reports the event rate for the pipeline. */
+    void run_stream(const char* pipeline, const std::vector<KeymapKey>& keys);
+};
@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[] = {
+    ACTION_TAP_DANCE_DOUBLE(KC_A, KC_ESC),
+    ACTION_TAP_DANCE_DOUBLE(KC_B, KC_TAB),
+    ACTION_TAP_DANCE_DOUBLE(KC_LSFT, KC_CAPS)
+};
+// clang-format on
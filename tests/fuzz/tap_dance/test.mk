@@ -0,0 +1,6 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+TAP_DANCE_ENABLE = yes
+
+SRC += fuzz_tap_dances.c tests/fuzz/fuzz_fixture.cpp
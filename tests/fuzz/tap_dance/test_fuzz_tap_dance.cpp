@@ -0,0 +1,16 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../fuzz_fixture.hpp"
+#include "quantum.h"
+
+class FuzzTapDance : public FuzzFixture {};
+
+TEST_F(FuzzTapDance, TapDanceStream) {
+    // clang-format off
+    run_stream("tap dance", {
+        KeymapKey(0, 0, 0, TD(0)), KeymapKey(0, 1, 0, TD(1)), KeymapKey(0, 2, 0, TD(2)), KeymapKey(0, 3, 0, KC_C),
+        KeymapKey(0, 4, 0, KC_D), KeymapKey(0, 5, 0, LCTL_T(KC_E)), KeymapKey(0, 6, 0, KC_F), KeymapKey(0, 7, 0, KC_G),
+    });
+    // clang-format on
+}
@@ -0,0 +1,18 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "fuzz_fixture.hpp"
+#include "quantum.h"
+
+class Fuzz : public FuzzFixture {};
+
+TEST_F(Fuzz, TappingStream) {
+    // clang-format off
+    run_stream("tapping", {
+        KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 1, 0, KC_B), KeymapKey(0, 2, 0, KC_C), KeymapKey(0, 3, 0, KC_D),
+        KeymapKey(0, 4, 0, LSFT_T(KC_E)), KeymapKey(0, 5, 0, LCTL_T(KC_F)), KeymapKey(0, 6, 0, LT(1, KC_G)), KeymapKey(0, 7, 0, MO(1)),
+        KeymapKey(1, 0, 0, KC_1), KeymapKey(1, 1, 0, KC_2), KeymapKey(1, 2, 0, KC_TRNS), KeymapKey(1, 3, 0, KC_TRNS),
+        KeymapKey(1, 4, 0, KC_TRNS), KeymapKey(1, 5, 0, KC_TRNS), KeymapKey(1, 6, 0, KC_TRNS), KeymapKey(1, 7, 0, KC_TRNS),
+    });
+    // clang-format on
+}
@@ -0,0 +1,84 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "key_event_queue.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::Invoke;
+
+class KeyEventQueue : public TestFixture {};
+
+TEST_F(KeyEventQueue, KeysAreProcessed) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, EventsKeepTheirScanTime) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_mod_tap = KeymapKey(0, 0, 0, LSFT_T(KC_A));
+    set_keymap({key_mod_tap});
+
+    // A quick tap is scanned, but not processed until after the tapping term has passed
+    key_mod_tap.press();
+    key_event_queue_scan();
+    advance_time(50);
+    key_mod_tap.release();
+    key_event_queue_scan();
+    advance_time(TAPPING_TERM * 2);
+    EXPECT_EQ(key_event_queue_count(), 2);
+
+    // It is still a tap, as it is timed from when it was scanned
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, OverflowIsRetriedOnNextScan) {
+    TestDriver driver;
+    set_keymap({KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 1, 0, KC_B), KeymapKey(0, 2, 0, KC_C), KeymapKey(0, 3, 0, KC_D), KeymapKey(0, 4, 0, KC_E), KeymapKey(0, 5, 0, KC_F)});
+
+    report_keyboard_t last_report = {};
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t& report) { last_report = report; }));
+
+    // Only three of the six presses fit in the queue, the others wait for the next scan
+    uint32_t overflows = key_event_queue_overflows();
+    for (uint8_t col = 0; col < 6; col++) {
+        press_key(col, 0);
+    }
+    run_one_scan_loop();
+    EXPECT_EQ(key_event_queue_overflows() - overflows, 3);
+    EXPECT_EQ(key_event_queue_high_water(), KEY_EVENT_QUEUE_SIZE - 1);
+    EXPECT_TRUE(KeyboardReport(KC_A, KC_B, KC_C).Matches(last_report));
+
+    run_one_scan_loop();
+    EXPECT_EQ(key_event_queue_overflows() - overflows, 3);
+    EXPECT_TRUE(KeyboardReport(KC_A, KC_B, KC_C, KC_D, KC_E, KC_F).Matches(last_report));
+
+    for (uint8_t col = 0; col < 6; col++) {
+        release_key(col, 0);
+    }
+    idle_for(2);
+    EXPECT_TRUE(KeyboardReport().Matches(last_report));
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,182 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_key_override.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static key_override_t make_override(uint8_t trigger_mods, uint16_t trigger, uint16_t replacement) {
+    key_override_t override = {};
+    override.trigger        = trigger;
+    override.trigger_mods   = trigger_mods;
+    override.layers         = ~0;
+    override.suppressed_mods = trigger_mods;
+    override.replacement    = replacement;
+    override.options        = ko_options_default;
+    return override;
+}
+
+class KeyOverride : public TestFixture {
+   protected:
+    std::vector<key_override_t>        overrides;
+    std::vector<const key_override_t*> override_list;
+
+    void TearDown() override {
+        key_overrides = NULL;
+        TestFixture::TearDown();
+    }
+
+    /* Adds count overrides requiring ctrl, none of which are triggered by the keys in these tests. */
+    void add_fillers(uint16_t count) {
+        for (uint16_t i = 0; i < count; i++) {
+            overrides.push_back(make_override(MOD_MASK_CTRL, KC_F1 + (i % 12), KC_F13 + (i % 12)));
+        }
+    }
+
+    /* Points key_overrides at the overrides added so far. */
+    void install() {
+        override_list.clear();
+        for (auto& override : overrides) {
+            override_list.push_back(&override);
+        }
+        override_list.push_back(NULL);
+        key_overrides = override_list.data();
+#ifdef KEY_OVERRIDE_TRIGGER_INDEX
+        // The vectors may reuse the previous test's allocation
+        key_override_index_invalidate();
+#endif
+    }
+};
+
+TEST_F(KeyOverride, TriggerWithModsSendsReplacement) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+
+    add_fillers(100);
+    overrides.push_back(make_override(MOD_MASK_SHIFT, KC_BSPC, KC_DEL));
+    install();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_DEL));
+    key_bspc.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_bspc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, FirstDeclaredOverrideWins) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_shift, key_a});
+
+    // The second override for the same trigger matches too, but is declared later
+    overrides.push_back(make_override(MOD_MASK_SHIFT, KC_A, KC_X));
+    add_fillers(20);
+    overrides.push_back(make_override(MOD_MASK_SHIFT, KC_A, KC_Y));
+    install();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_X));
+    key_a.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_a.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ModifierAfterTriggerActivatesOverride) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+
+    add_fillers(30);
+    overrides.push_back(make_override(MOD_MASK_SHIFT, KC_BSPC, KC_DEL));
+    install();
+
+    EXPECT_REPORT(driver, (KC_BSPC));
+    key_bspc.press();
+    run_one_scan_loop();
+
+    // The trigger is removed, and the replacement follows after the key repeat delay
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_DEL));
+    key_shift.press();
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_bspc.release();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ModsOnlyOverrideActivates) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LCTL);
+    KeymapKey  key_shift(0, 1, 0, KC_LSFT);
+    set_keymap({key_ctrl, key_shift});
+
+    add_fillers(30);
+    key_override_t override  = make_override(MOD_MASK_CS, KC_NO, KC_ESC);
+    override.suppressed_mods = MOD_MASK_CS;
+    overrides.push_back(override);
+    install();
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    key_ctrl.press();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ESC));
+    key_shift.press();
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
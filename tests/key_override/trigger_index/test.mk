@@ -0,0 +1,7 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+# Runs the same tests as the linear search
+SRC += tests/key_override/test_key_override.cpp
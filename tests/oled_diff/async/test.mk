@@ -0,0 +1,11 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+OLED_ENABLE = yes
+OLED_TRANSPORT = custom
+
+SRC += tests/oled_diff/test_oled_diff.cpp
@@ -0,0 +1,177 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+#include <cstring>
+
+extern "C" {
+#include "oled_driver.h"
+
+// Simulates the panel's memory, as written in horizontal addressing mode
+static uint8_t panel[OLED_MATRIX_SIZE];
+static uint8_t window_start_column, window_end_column, window_start_page, window_end_page;
+static uint8_t cursor_column, cursor_page;
+static int     spans_sent;
+static int     bytes_sent;
+static uint8_t last_span_page, last_span_column;
+
+bool oled_send_cmd(const uint8_t *data, uint16_t size) {
+    if (size == 7 && data[1] == 0x21 && data[4] == 0x22) {
+        window_start_column = cursor_column = data[2];
+        window_end_column                   = data[3];
+        window_start_page = cursor_page = data[5];
+        window_end_page                 = data[6];
+    }
+    return true;
+}
+
+bool oled_send_data(const uint8_t *data, uint16_t size) {
+    spans_sent++;
+    bytes_sent += size;
+    last_span_page   = cursor_page;
+    last_span_column = cursor_column;
+    for (uint16_t i = 0; i < size; i++) {
+        panel[cursor_page * OLED_DISPLAY_WIDTH + cursor_column] = data[i];
+        if (cursor_column++ == window_end_column) {
+            cursor_column = window_start_column;
+            cursor_page   = cursor_page == window_end_page ? window_start_page : cursor_page + 1;
+        }
+    }
+    return true;
+}
+
+#ifdef OLED_ASYNC_FLUSH
+static bool flush_pending;
+
+void oled_flush_async(void) {
+    flush_pending = true;
+}
+
+bool oled_flush_async_busy(void) {
+    return flush_pending;
+}
+#endif
+}
+
+class OledDiff : public TestFixture {
+   protected:
+    void SetUp() override {
+        init(OLED_ROTATION_0);
+    }
+
+    static void init(oled_rotation_t rotation) {
+        memset(panel, 0xAA, sizeof(panel));
+        oled_init(rotation);
+        render();
+    }
+
+    /* Renders everything that is dirty, finishing any background transfer, and returns the number of bytes sent. */
+    static int render() {
+        spans_sent = 0;
+        bytes_sent = 0;
+        oled_render_dirty(true);
+#ifdef OLED_ASYNC_FLUSH
+        if (flush_pending) {
+            oled_flush_batch();
+            flush_pending = false;
+        }
+#endif
+        return bytes_sent;
+    }
+
+    static void expect_panel_matches_buffer() {
+        oled_buffer_reader_t reader = oled_read_raw(0);
+        EXPECT_EQ(memcmp(panel, reader.current_element, OLED_MATRIX_SIZE), 0);
+    }
+};
+
+TEST_F(OledDiff, FirstRenderWritesWholePanel) {
+    memset(panel, 0xAA, sizeof(panel));
+    oled_init(OLED_ROTATION_0);
+    EXPECT_EQ(render(), OLED_MATRIX_SIZE);
+    expect_panel_matches_buffer();
+}
+
+TEST_F(OledDiff, UnchangedBlockSendsNothing) {
+    oled_write_raw_byte(0xFF, 40);
+    oled_write_raw_byte(0x00, 40);
+    EXPECT_EQ(render(), 0);
+    EXPECT_EQ(spans_sent, 0);
+}
+
+TEST_F(OledDiff, SingleByteChangeSendsSingleByte) {
+    oled_write_raw_byte(0x5A, OLED_DISPLAY_WIDTH + 72);
+    EXPECT_EQ(render(), 1);
+    EXPECT_EQ(spans_sent, 1);
+    EXPECT_EQ(last_span_page, 1);
+    EXPECT_EQ(last_span_column, 72);
+    expect_panel_matches_buffer();
+}
+
+TEST_F(OledDiff, CloseChangesAreMerged) {
+    oled_write_raw_byte(0x01, 4);
+    oled_write_raw_byte(0x02, 4 + OLED_DIFF_MAX_GAP + 1);
+    EXPECT_EQ(render(), OLED_DIFF_MAX_GAP + 2);
+    EXPECT_EQ(spans_sent, 1);
+    expect_panel_matches_buffer();
+}
+
+TEST_F(OledDiff, DistantChangesAreSplit) {
+    oled_write_raw_byte(0x01, 4);
+    oled_write_raw_byte(0x02, 4 + OLED_DIFF_MAX_GAP + 2);
+    EXPECT_EQ(render(), 2);
+    EXPECT_EQ(spans_sent, 2);
+    expect_panel_matches_buffer();
+}
+
+TEST_F(OledDiff, TextChangeSendsOnlyChangedColumns) {
+    oled_write("Layer 1", false);
+    render();
+    oled_set_cursor(0, 0);
+    oled_write("Layer 2", false);
+    EXPECT_LE(render(), OLED_FONT_WIDTH);
+    expect_panel_matches_buffer();
+}
+
+TEST_F(OledDiff, RotatedChangesMatchFullRender) {
+    // Draw in two steps, so the second render goes through the diff
+    init(OLED_ROTATION_90);
+    oled_write_pixel(0, 0, true);
+    oled_write_pixel(5, 100, true);
+    render();
+    oled_write_pixel(17, 9, true);
+    oled_write_pixel(31, 127, true);
+    EXPECT_LT(render(), OLED_BLOCK_SIZE * 2);
+    uint8_t diffed[OLED_MATRIX_SIZE];
+    memcpy(diffed, panel, sizeof(diffed));
+
+    // Draw everything in one go onto a fresh panel
+    init(OLED_ROTATION_90);
+    oled_write_pixel(0, 0, true);
+    oled_write_pixel(5, 100, true);
+    oled_write_pixel(17, 9, true);
+    oled_write_pixel(31, 127, true);
+    render();
+    EXPECT_EQ(memcmp(diffed, panel, sizeof(diffed)), 0);
+}
+
+#ifdef OLED_ASYNC_FLUSH
+TEST_F(OledDiff, ChangesWaitForBackgroundTransfer) {
+    oled_write_raw_byte(0x01, 4);
+    bytes_sent = 0;
+    oled_render_dirty(true);
+    EXPECT_TRUE(oled_flush_async_busy());
+
+    // Changes made while the transfer is running are held back until the next render
+    oled_write_raw_byte(0x02, 300);
+    oled_render_dirty(true);
+    EXPECT_EQ(bytes_sent, 0);
+
+    oled_flush_batch();
+    flush_pending = false;
+    EXPECT_EQ(panel[4], 0x01);
+    EXPECT_EQ(render(), 1);
+    expect_panel_matches_buffer();
+}
+#endif
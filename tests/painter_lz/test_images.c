@@ -0,0 +1,381 @@
+// Copyright 2023 QMK -- generated source code only, image retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// keyboards/tzarc/ghoul/graphics/ghoul-logo.qgf.c, re-encoded with each compression scheme
+
+#include "test_images.h"
+
+// clang-format off
+const uint32_t gfx_ghoul_logo_raw_length = 2288;
+
+const uint8_t gfx_ghoul_logo_raw[2288] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0xF0, 0x08, 0x00, 0x00, 0x0F, 0xF7, 0xFF,
+    0xFF, 0x46, 0x00, 0x80, 0x00, 0x01, 0x00, 0x01, 0xFE, 0x04, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xE8, 0x03, 0x05, 0xFA, 0xC0, 0x08, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF9, 0x6F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xFE, 0xFF, 0xBF, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0xFF, 0x7F, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xFF, 0xFF, 0xFF, 0xFF, 0x2F,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xFE, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x0B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0xF8, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0xE0,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0xF4, 0x01, 0x00,
+    0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0xA0, 0x00, 0x00, 0xC0, 0x1F,
+    0x00, 0x00, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x0A, 0x00, 0x00,
+    0xFD, 0x01, 0x00, 0xF4, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x00, 0xA4, 0x01,
+    0x00, 0xE0, 0x0F, 0x00, 0xD0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x00, 0x40,
+    0x2A, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F,
+    0x00, 0xA4, 0x06, 0x00, 0xF4, 0x0F, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x02, 0x40, 0xAA, 0x00, 0x80, 0xBF, 0x00, 0xD0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x7F, 0x00, 0xA4, 0x0A, 0x00, 0xFC, 0x0B, 0x00, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x0B, 0x40, 0xAA, 0x01, 0xC0, 0xBF, 0x00, 0xF4, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x01, 0xA4, 0x2A, 0x00, 0xFD, 0x0B, 0x80, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x2B, 0x40, 0xAA, 0x02, 0xD0, 0xBF, 0x00, 0xFD, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x06, 0xA4, 0x6A, 0x00, 0xFE, 0x0B, 0xE0,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAB, 0x40, 0xAA, 0x0A, 0xE0, 0xFF,
+    0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x0A, 0xA4, 0xAA, 0x00,
+    0xFE, 0x0F, 0xF4, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAA, 0x02, 0xAA,
+    0x0A, 0xE0, 0xFF, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0x2A,
+    0xA0, 0xAA, 0x00, 0xFE, 0x1F, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xAA, 0x06, 0xA9, 0x0A, 0xE0, 0xFF, 0xD1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xAF, 0x6A, 0x90, 0xAA, 0x00, 0xFE, 0x2F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xAA, 0x0A, 0xA9, 0x0A, 0xF0, 0xFF, 0xF3, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0xAA, 0xA0, 0x6A, 0x00, 0xFF, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAA, 0x1A, 0xAA, 0x02, 0xF0, 0xFF, 0xFB, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0xAA, 0xA6, 0x1A, 0x00, 0xFF, 0xFF, 0xFF, 0xF7,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA9, 0xAA, 0xAA, 0x00, 0xF0, 0xFF, 0xFF,
+    0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xAA, 0xAA, 0x1A, 0x40, 0xFF,
+    0xFF, 0xBF, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x90, 0xAA, 0xAA, 0x06,
+    0xF4, 0xFF, 0xFF, 0x07, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xA8, 0xAA,
+    0xAA, 0x41, 0xFF, 0xFF, 0x7F, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0xAA, 0xAA, 0x2A, 0xF8, 0xFF, 0xFF, 0x03, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x0B, 0xA8, 0xAA, 0xAA, 0x86, 0xFF, 0xFF, 0x3F, 0xD0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x7F, 0x80, 0xAA, 0xAA, 0x6A, 0xFC, 0xFF, 0xFF, 0x07, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x03, 0xA8, 0xAA, 0xAA, 0xCA, 0xFF, 0xFF, 0xBF, 0x80, 0xFF, 0xD7, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xBF, 0xFD, 0x3F, 0x80, 0xAA, 0xAA, 0xAA, 0xFD, 0xFF, 0xFF, 0x0F, 0xF4, 0x0F, 0xF8,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0xFE, 0x02, 0xA9, 0xAA, 0xAA, 0xEA, 0xFF, 0xFF, 0xFF, 0x01, 0x2E,
+    0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x80, 0x0F, 0xA0, 0xAA, 0xAA, 0xAA, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x00, 0x00, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x80, 0xAA, 0xAA, 0xAA, 0xEA, 0xFF, 0xFF,
+    0xFF, 0x0F, 0x00, 0x00, 0xFD, 0xFF, 0xFF, 0xFF, 0x0B, 0x00, 0x00, 0xA9, 0xAA, 0xAA, 0x6A, 0xFD,
+    0xFF, 0xFF, 0xFF, 0x07, 0x00, 0x80, 0xFF, 0xFF, 0xFF, 0x3F, 0x00, 0x00, 0xA9, 0xAA, 0xAA, 0xAA,
+    0xC2, 0xFF, 0xFF, 0xFF, 0xBF, 0x00, 0x00, 0xF4, 0xFF, 0xFF, 0xFF, 0x02, 0x00, 0xA0, 0xAA, 0xAA,
+    0xAA, 0x2A, 0xFC, 0xFF, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0xFE, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0xA9,
+    0xAA, 0xAA, 0xAA, 0xC2, 0xFF, 0xFF, 0xFF, 0x2F, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x7F, 0x00, 0x00,
+    0x00, 0xAA, 0xAA, 0xAA, 0x1A, 0xF8, 0xFF, 0xFF, 0xBF, 0x00, 0x00, 0x00, 0xF4, 0xFF, 0xFF, 0x02,
+    0x00, 0x00, 0x90, 0xAA, 0xAA, 0xAA, 0x81, 0xFF, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0xFD, 0xFF,
+    0x07, 0x00, 0x00, 0x00, 0xA8, 0xAA, 0xAA, 0x1A, 0xF8, 0xFF, 0xFF, 0x2F, 0x00, 0x00, 0x00, 0x94,
+    0xFF, 0x6F, 0x01, 0x00, 0x00, 0x40, 0xAA, 0xAA, 0xAA, 0x82, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00,
+    0x80, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0xA0, 0xAA, 0xAA, 0x2A, 0xF8, 0xFF, 0xFF, 0x0F, 0x00,
+    0x00, 0x00, 0xFC, 0xFF, 0xFF, 0x03, 0x00, 0x00, 0x00, 0xA9, 0xAA, 0xAA, 0x82, 0xFF, 0xFF, 0x7F,
+    0x00, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0x80, 0xAA, 0xAA, 0x6A, 0xF8, 0xFF,
+    0xFF, 0x07, 0x00, 0x00, 0x00, 0xFC, 0xFF, 0xFF, 0x07, 0x00, 0x00, 0x00, 0xA8, 0xAA, 0xAA, 0xC6,
+    0xFF, 0xFF, 0x3F, 0x00, 0x00, 0x00, 0xD0, 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x00, 0x40, 0xAA, 0xAA,
+    0x6A, 0xFC, 0xFF, 0xFF, 0x02, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0xFF, 0x0B, 0x00, 0x00, 0x00, 0xA4,
+    0xAA, 0xAA, 0xC6, 0xFF, 0xFF, 0x2F, 0x00, 0x00, 0x00, 0xE0, 0xBF, 0xD0, 0xBF, 0x00, 0x00, 0x00,
+    0x00, 0xAA, 0xAA, 0x6A, 0xFC, 0xFF, 0xFF, 0x01, 0x00, 0x00, 0x00, 0xFE, 0x03, 0xF8, 0x0F, 0x00,
+    0x00, 0x00, 0xA0, 0xAA, 0xAA, 0xC6, 0xFF, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0xF0, 0x1F, 0x00, 0xFF,
+    0x00, 0x00, 0x00, 0x00, 0xAA, 0xAA, 0x6A, 0xFC, 0xFF, 0xFF, 0x01, 0x00, 0x00, 0x40, 0xBF, 0x00,
+    0xE0, 0x1F, 0x00, 0x00, 0x00, 0xA0, 0xAA, 0xAA, 0xC6, 0xFF, 0xFF, 0x1F, 0x00, 0x00, 0x00, 0xF4,
+    0x07, 0x00, 0xFC, 0x02, 0x00, 0x00, 0x00, 0xAA, 0xAA, 0x2A, 0xFC, 0xFF, 0xFF, 0x02, 0x00, 0x00,
+    0x80, 0x3F, 0x00, 0x80, 0x3F, 0x00, 0x00, 0x00, 0xA0, 0xAA, 0xAA, 0x82, 0xFF, 0xFF, 0x2F, 0x00,
+    0x00, 0x00, 0xFD, 0x02, 0x00, 0xF8, 0x0B, 0x00, 0x00, 0x40, 0xAA, 0xAA, 0x2A, 0xF8, 0xFF, 0xFF,
+    0x03, 0x00, 0x00, 0xF0, 0x1F, 0x00, 0x40, 0xFF, 0x00, 0x00, 0x00, 0xA8, 0xAA, 0xAA, 0x41, 0xFF,
+    0xFF, 0x7F, 0x00, 0x00, 0x80, 0xFF, 0x01, 0x00, 0xF0, 0x2F, 0x00, 0x00, 0x80, 0xAA, 0xAA, 0x1A,
+    0xF0, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0xFE, 0x0F, 0x00, 0x00, 0xFF, 0x0B, 0x00, 0x00, 0xA9, 0xAA,
+    0xAA, 0x00, 0xFE, 0xFF, 0xFF, 0x02, 0x00, 0xF8, 0xFF, 0x00, 0x00, 0xE0, 0xFF, 0x07, 0x00, 0xA0,
+    0xAA, 0xAA, 0x0A, 0xD0, 0xFF, 0xFF, 0xBF, 0x00, 0xF4, 0xFF, 0x0F, 0x00, 0x00, 0xFE, 0xFF, 0x02,
+    0x90, 0xAA, 0xAA, 0x6A, 0x00, 0xBC, 0xFF, 0xFF, 0xBF, 0xFA, 0xFF, 0xFF, 0x00, 0x00, 0xE0, 0xFF,
+    0xBF, 0x96, 0xAA, 0xAA, 0xAA, 0x02, 0x40, 0xF3, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0B, 0x00, 0x00,
+    0xFE, 0xFF, 0xAB, 0xAA, 0xAA, 0xAA, 0x1A, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x00,
+    0x00, 0xE0, 0xFF, 0xBF, 0xAA, 0xAA, 0xAA, 0x9A, 0x00, 0x00, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x0B, 0x00, 0x00, 0xFE, 0xFF, 0xAB, 0xAA, 0xAA, 0xAA, 0x01, 0x00, 0x00, 0xFD, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xBF, 0x00, 0x00, 0xD0, 0xFF, 0xAF, 0xAA, 0xAA, 0xAA, 0x0A, 0x00, 0x00, 0xC0, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x0B, 0x00, 0x00, 0xFD, 0xFF, 0xAA, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0xF8,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x00, 0x00, 0xD0, 0xFF, 0xAF, 0xAA, 0xAA, 0xAA, 0x06, 0x00, 0x00,
+    0x40, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0B, 0x00, 0x00, 0xFD, 0xFF, 0xAA, 0xAA, 0xAA, 0x2A, 0x00,
+    0x00, 0x00, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0x00, 0x00, 0xD0, 0xFF, 0xAF, 0xAA, 0xAA, 0xAA,
+    0x01, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0x1B, 0x00, 0x40, 0xFE, 0xBF, 0xAA, 0xAA,
+    0xAA, 0x0A, 0x00, 0x00, 0x00, 0xD0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x00, 0xFE, 0xFF, 0xAB,
+    0xAA, 0xAA, 0x6A, 0x00, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x90, 0xE0, 0xFF,
+    0xBF, 0xAA, 0xAA, 0xAA, 0x02, 0x00, 0x00, 0x00, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x4F, 0x2F,
+    0xFE, 0xFF, 0xAB, 0xAA, 0xAA, 0x6A, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFD, 0xFB, 0xFF, 0xBF, 0xAA, 0xAA, 0xAA, 0x0A, 0x00, 0x00, 0x00, 0xF4, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAA, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0xAA, 0xAA, 0xAA, 0x1A, 0x00, 0x00, 0x00, 0xF8, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAA, 0xAA, 0xAA, 0xAA, 0x02, 0x00, 0x00, 0xC0,
+    0xFF, 0xFF, 0xEB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0xAA, 0xAA, 0xAA, 0x2A, 0x00, 0x00,
+    0x00, 0xFC, 0xFF, 0x2F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0xAA, 0xAA, 0xAA, 0xAA, 0x02,
+    0x00, 0x00, 0xD0, 0xFF, 0xBF, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAB, 0xAA, 0xAA, 0xAA,
+    0x2A, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF, 0xAA, 0x6A,
+    0xA9, 0xAA, 0x06, 0x00, 0x00, 0xD0, 0xFF, 0x7F, 0xF0, 0xFF, 0xFE, 0xBF, 0xFF, 0xEF, 0xFF, 0x9B,
+    0xAA, 0x81, 0xAA, 0x6A, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0x07, 0xFF, 0xDF, 0xFF, 0xF7, 0xFF, 0xFD,
+    0x2F, 0xAA, 0x0A, 0xA8, 0xAA, 0x06, 0x00, 0x00, 0xD0, 0xFF, 0x7F, 0xE0, 0xFF, 0xFD, 0x7F, 0xFE,
+    0xCF, 0xFF, 0xA2, 0xAA, 0x80, 0xAA, 0x6A, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0x07, 0xFD, 0x9F, 0xFF,
+    0xE7, 0xFF, 0xFC, 0x2F, 0xAA, 0x0A, 0xA8, 0xAA, 0x06, 0x00, 0x00, 0xD0, 0xFF, 0x7F, 0xD0, 0xFF,
+    0xF9, 0x3F, 0xFE, 0xCF, 0xFF, 0xA2, 0x6A, 0x80, 0xAA, 0x6A, 0x00, 0x00, 0x00, 0xFC, 0xFF, 0x07,
+    0xFC, 0x9F, 0xFF, 0xE3, 0xFF, 0xFC, 0x1B, 0xAA, 0x02, 0xA8, 0xAA, 0x02, 0x00, 0x00, 0xC0, 0xFF,
+    0x3F, 0x80, 0xFF, 0xF5, 0x3F, 0xFF, 0xCF, 0xBF, 0xA1, 0x2A, 0x80, 0xAA, 0x2A, 0x00, 0x00, 0x00,
+    0xF8, 0xBF, 0x00, 0xF4, 0x5F, 0xFF, 0xF3, 0xFF, 0xF9, 0x1B, 0xAA, 0x01, 0x90, 0xAA, 0x02, 0x00,
+    0x00, 0x40, 0x6F, 0x00, 0x00, 0xFF, 0xF5, 0x3F, 0xFF, 0x9F, 0xAF, 0xA1, 0x0A, 0x00, 0xA0, 0x2A,
+    0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0xF0, 0x5F, 0xFF, 0xF3, 0xFF, 0xF9, 0x1A, 0xAA, 0x00, 0x00,
+    0x90, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xF1, 0x2F, 0xFF, 0x5F, 0xAF, 0xA1, 0x0A,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xD0, 0x1F, 0xFF, 0xF2, 0xFF, 0xF5, 0x0A,
+    0x6A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xF2, 0x1F, 0xFF, 0x5F,
+    0xAB, 0xA0, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x1F, 0xFF, 0xF0,
+    0xFF, 0xB0, 0x0A, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xE1,
+    0x0F, 0xFE, 0x0F, 0xAA, 0xA0, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+    0x0F, 0x7D, 0xD0, 0x7F, 0x90, 0x06, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xB4, 0x80, 0x03, 0xF8, 0x03, 0x28, 0x90, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x40, 0x1F, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x02, 0x0E, 0x00, 0x00, 0x50, 0x00, 0x00, 0x40, 0x0A, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x70, 0xF0, 0x02, 0xA0, 0x00, 0x00, 0x40, 0x00, 0xA4, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0B, 0x7F, 0x00, 0x1F, 0xE0, 0x00, 0x0A, 0x80, 0x0A, 0x18,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xF0, 0x0F, 0xF4, 0x02, 0x1F, 0xA4, 0x01, 0xA9,
+    0x90, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x1F, 0xFF, 0x82, 0x7F, 0xF4, 0x82, 0x1A,
+    0xA0, 0x0A, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xF2, 0x3F, 0xFC, 0xDF, 0xBF,
+    0xAA, 0x82, 0xAA, 0xA4, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x7F, 0xFE, 0xDB, 0xFF,
+    0xFF, 0xAB, 0x6A, 0xA9, 0x8A, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xEF, 0xFF,
+    0xFF, 0xFF, 0xBF, 0xAA, 0xAA, 0x6A, 0xAA, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xAB, 0xAA, 0xAA, 0xAA, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xF4, 0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0xAA, 0xAA, 0xAA, 0xAA, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x40, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAA, 0xAA, 0xAA, 0xAA, 0x1A, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0xAA, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFF, 0xFF, 0xFF, 0xBF, 0xAA, 0xAA, 0xAA, 0xAA, 0x0A, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xAB, 0xAA, 0xAA, 0xAA, 0x6A,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFD, 0xFF, 0xFF, 0xFF, 0xBF, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xAA, 0xAA,
+    0xAA, 0xAA, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF4, 0xFF, 0xFF, 0xFF, 0xAF,
+    0xAA, 0xAA, 0xAA, 0xAA, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+    0xBF, 0xAA, 0xAA, 0xAA, 0xAA, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x6F,
+    0xFE, 0xFF, 0xAB, 0xAA, 0xAA, 0x5A, 0x6A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFD, 0x40, 0xFF, 0xBF, 0xAA, 0xAA, 0x0A, 0x90, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x80, 0x07, 0x40, 0xFE, 0xAA, 0xAA, 0x1A, 0x00, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA9, 0xAA, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint32_t gfx_ghoul_logo_rle_length = 1936;
+
+const uint8_t gfx_ghoul_logo_rle[1936] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0x90, 0x07, 0x00, 0x00, 0x6F, 0xF8, 0xFF,
+    0xFF, 0x46, 0x00, 0x80, 0x00, 0x01, 0x00, 0x01, 0xFE, 0x04, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x00, 0x01, 0xFF, 0xE8, 0x03, 0x05, 0xFA, 0x60, 0x07, 0x00,
+    0x08, 0x00, 0x81, 0xF9, 0x6F, 0x0E, 0x00, 0x83, 0x40, 0xFE, 0xFF, 0xBF, 0x0D, 0x00, 0x80, 0x80,
+    0x03, 0xFF, 0x80, 0x7F, 0x0C, 0x00, 0x80, 0x40, 0x04, 0xFF, 0x80, 0x2F, 0x0B, 0x00, 0x81, 0x40,
+    0xFE, 0x04, 0xFF, 0x80, 0x1F, 0x0B, 0x00, 0x80, 0xFD, 0x05, 0xFF, 0x80, 0x0B, 0x03, 0x00, 0x80,
+    0x01, 0x02, 0x00, 0x80, 0x80, 0x03, 0x00, 0x80, 0xF8, 0x06, 0xFF, 0x80, 0x03, 0x02, 0x00, 0x80,
+    0x20, 0x03, 0x00, 0x80, 0x0E, 0x02, 0x00, 0x80, 0xE0, 0x07, 0xFF, 0x03, 0x00, 0x80, 0x02, 0x02,
+    0x00, 0x83, 0xF4, 0x01, 0x00, 0x80, 0x07, 0xFF, 0x80, 0x3F, 0x02, 0x00, 0x80, 0xA0, 0x02, 0x00,
+    0x81, 0xC0, 0x1F, 0x02, 0x00, 0x80, 0xFE, 0x07, 0xFF, 0x80, 0x0F, 0x02, 0x00, 0x80, 0x0A, 0x02,
+    0x00, 0x83, 0xFD, 0x01, 0x00, 0xF4, 0x08, 0xFF, 0x88, 0x02, 0x00, 0xA4, 0x01, 0x00, 0xE0, 0x0F,
+    0x00, 0xD0, 0x08, 0xFF, 0x83, 0xBF, 0x00, 0x40, 0x2A, 0x02, 0x00, 0x80, 0xFF, 0x02, 0x00, 0x09,
+    0xFF, 0x88, 0x1F, 0x00, 0xA4, 0x06, 0x00, 0xF4, 0x0F, 0x00, 0xF8, 0x09, 0xFF, 0x87, 0x02, 0x40,
+    0xAA, 0x00, 0x80, 0xBF, 0x00, 0xD0, 0x09, 0xFF, 0x88, 0x7F, 0x00, 0xA4, 0x0A, 0x00, 0xFC, 0x0B,
+    0x00, 0xFE, 0x09, 0xFF, 0x87, 0x0B, 0x40, 0xAA, 0x01, 0xC0, 0xBF, 0x00, 0xF4, 0x09, 0xFF, 0x87,
+    0xBF, 0x01, 0xA4, 0x2A, 0x00, 0xFD, 0x0B, 0x80, 0x0A, 0xFF, 0x87, 0x2B, 0x40, 0xAA, 0x02, 0xD0,
+    0xBF, 0x00, 0xFD, 0x09, 0xFF, 0x87, 0xBF, 0x06, 0xA4, 0x6A, 0x00, 0xFE, 0x0B, 0xE0, 0x0A, 0xFF,
+    0x86, 0xAB, 0x40, 0xAA, 0x0A, 0xE0, 0xFF, 0x00, 0x0A, 0xFF, 0x87, 0xBF, 0x0A, 0xA4, 0xAA, 0x00,
+    0xFE, 0x0F, 0xF4, 0x0A, 0xFF, 0x86, 0xAA, 0x02, 0xAA, 0x0A, 0xE0, 0xFF, 0x80, 0x0A, 0xFF, 0x87,
+    0xAF, 0x2A, 0xA0, 0xAA, 0x00, 0xFE, 0x1F, 0xFC, 0x0A, 0xFF, 0x86, 0xAA, 0x06, 0xA9, 0x0A, 0xE0,
+    0xFF, 0xD1, 0x0A, 0xFF, 0x87, 0xAF, 0x6A, 0x90, 0xAA, 0x00, 0xFE, 0x2F, 0xFE, 0x0A, 0xFF, 0x86,
+    0xAA, 0x0A, 0xA9, 0x0A, 0xF0, 0xFF, 0xF3, 0x0A, 0xFF, 0x86, 0xAF, 0xAA, 0xA0, 0x6A, 0x00, 0xFF,
+    0x7F, 0x0B, 0xFF, 0x86, 0xAA, 0x1A, 0xAA, 0x02, 0xF0, 0xFF, 0xFB, 0x0A, 0xFF, 0x84, 0xAF, 0xAA,
+    0xA6, 0x1A, 0x00, 0x03, 0xFF, 0x80, 0xF7, 0x09, 0xFF, 0x80, 0xA9, 0x02, 0xAA, 0x81, 0x00, 0xF0,
+    0x02, 0xFF, 0x80, 0x1F, 0x09, 0xFF, 0x80, 0x0F, 0x02, 0xAA, 0x81, 0x1A, 0x40, 0x02, 0xFF, 0x81,
+    0xBF, 0xF0, 0x09, 0xFF, 0x80, 0x90, 0x02, 0xAA, 0x81, 0x06, 0xF4, 0x02, 0xFF, 0x81, 0x07, 0xFE,
+    0x08, 0xFF, 0x81, 0x0F, 0xA8, 0x02, 0xAA, 0x80, 0x41, 0x02, 0xFF, 0x81, 0x7F, 0xE0, 0x09, 0xFF,
+    0x80, 0x80, 0x02, 0xAA, 0x81, 0x2A, 0xF8, 0x02, 0xFF, 0x81, 0x03, 0xFD, 0x08, 0xFF, 0x81, 0x0B,
+    0xA8, 0x02, 0xAA, 0x80, 0x86, 0x02, 0xFF, 0x81, 0x3F, 0xD0, 0x08, 0xFF, 0x81, 0x7F, 0x80, 0x02,
+    0xAA, 0x81, 0x6A, 0xFC, 0x02, 0xFF, 0x81, 0x07, 0xFC, 0x08, 0xFF, 0x81, 0x03, 0xA8, 0x02, 0xAA,
+    0x80, 0xCA, 0x02, 0xFF, 0x83, 0xBF, 0x80, 0xFF, 0xD7, 0x04, 0xFF, 0x83, 0xBF, 0xFD, 0x3F, 0x80,
+    0x03, 0xAA, 0x80, 0xFD, 0x02, 0xFF, 0x83, 0x0F, 0xF4, 0x0F, 0xF8, 0x04, 0xFF, 0x83, 0x02, 0xFE,
+    0x02, 0xA9, 0x02, 0xAA, 0x80, 0xEA, 0x03, 0xFF, 0x82, 0x01, 0x2E, 0x00, 0x04, 0xFF, 0x83, 0x1F,
+    0x80, 0x0F, 0xA0, 0x03, 0xAA, 0x03, 0xFF, 0x80, 0x3F, 0x02, 0x00, 0x80, 0xE0, 0x04, 0xFF, 0x02,
+    0x00, 0x80, 0x80, 0x03, 0xAA, 0x80, 0xEA, 0x03, 0xFF, 0x80, 0x0F, 0x02, 0x00, 0x80, 0xFD, 0x03,
+    0xFF, 0x80, 0x0B, 0x02, 0x00, 0x80, 0xA9, 0x02, 0xAA, 0x81, 0x6A, 0xFD, 0x03, 0xFF, 0x82, 0x07,
+    0x00, 0x80, 0x03, 0xFF, 0x80, 0x3F, 0x02, 0x00, 0x80, 0xA9, 0x03, 0xAA, 0x80, 0xC2, 0x03, 0xFF,
+    0x80, 0xBF, 0x02, 0x00, 0x80, 0xF4, 0x03, 0xFF, 0x82, 0x02, 0x00, 0xA0, 0x03, 0xAA, 0x81, 0x2A,
+    0xFC, 0x03, 0xFF, 0x80, 0x07, 0x02, 0x00, 0x80, 0xFE, 0x02, 0xFF, 0x80, 0x0F, 0x02, 0x00, 0x80,
+    0xA9, 0x03, 0xAA, 0x80, 0xC2, 0x03, 0xFF, 0x80, 0x2F, 0x02, 0x00, 0x80, 0xC0, 0x02, 0xFF, 0x80,
+    0x7F, 0x03, 0x00, 0x03, 0xAA, 0x81, 0x1A, 0xF8, 0x02, 0xFF, 0x80, 0xBF, 0x03, 0x00, 0x80, 0xF4,
+    0x02, 0xFF, 0x80, 0x02, 0x02, 0x00, 0x80, 0x90, 0x03, 0xAA, 0x80, 0x81, 0x03, 0xFF, 0x80, 0x07,
+    0x03, 0x00, 0x82, 0xFD, 0xFF, 0x07, 0x03, 0x00, 0x80, 0xA8, 0x02, 0xAA, 0x81, 0x1A, 0xF8, 0x02,
+    0xFF, 0x80, 0x2F, 0x03, 0x00, 0x83, 0x94, 0xFF, 0x6F, 0x01, 0x02, 0x00, 0x80, 0x40, 0x03, 0xAA,
+    0x80, 0x82, 0x03, 0xFF, 0x80, 0x01, 0x02, 0x00, 0x80, 0x80, 0x02, 0xFF, 0x80, 0x7F, 0x03, 0x00,
+    0x80, 0xA0, 0x02, 0xAA, 0x81, 0x2A, 0xF8, 0x02, 0xFF, 0x80, 0x0F, 0x03, 0x00, 0x80, 0xFC, 0x02,
+    0xFF, 0x80, 0x03, 0x03, 0x00, 0x80, 0xA9, 0x02, 0xAA, 0x80, 0x82, 0x02, 0xFF, 0x80, 0x7F, 0x03,
+    0x00, 0x80, 0xC0, 0x02, 0xFF, 0x80, 0x7F, 0x03, 0x00, 0x80, 0x80, 0x02, 0xAA, 0x81, 0x6A, 0xF8,
+    0x02, 0xFF, 0x80, 0x07, 0x03, 0x00, 0x80, 0xFC, 0x02, 0xFF, 0x80, 0x07, 0x03, 0x00, 0x80, 0xA8,
+    0x02, 0xAA, 0x80, 0xC6, 0x02, 0xFF, 0x80, 0x3F, 0x03, 0x00, 0x80, 0xD0, 0x02, 0xFF, 0x80, 0x7F,
+    0x03, 0x00, 0x80, 0x40, 0x02, 0xAA, 0x81, 0x6A, 0xFC, 0x02, 0xFF, 0x80, 0x02, 0x03, 0x00, 0x80,
+    0xFD, 0x02, 0xFF, 0x80, 0x0B, 0x03, 0x00, 0x80, 0xA4, 0x02, 0xAA, 0x80, 0xC6, 0x02, 0xFF, 0x80,
+    0x2F, 0x03, 0x00, 0x83, 0xE0, 0xBF, 0xD0, 0xBF, 0x04, 0x00, 0x02, 0xAA, 0x81, 0x6A, 0xFC, 0x02,
+    0xFF, 0x80, 0x01, 0x03, 0x00, 0x83, 0xFE, 0x03, 0xF8, 0x0F, 0x03, 0x00, 0x80, 0xA0, 0x02, 0xAA,
+    0x80, 0xC6, 0x02, 0xFF, 0x80, 0x1F, 0x03, 0x00, 0x83, 0xF0, 0x1F, 0x00, 0xFF, 0x04, 0x00, 0x02,
+    0xAA, 0x81, 0x6A, 0xFC, 0x02, 0xFF, 0x80, 0x01, 0x02, 0x00, 0x84, 0x40, 0xBF, 0x00, 0xE0, 0x1F,
+    0x03, 0x00, 0x80, 0xA0, 0x02, 0xAA, 0x80, 0xC6, 0x02, 0xFF, 0x80, 0x1F, 0x03, 0x00, 0x84, 0xF4,
+    0x07, 0x00, 0xFC, 0x02, 0x03, 0x00, 0x02, 0xAA, 0x81, 0x2A, 0xFC, 0x02, 0xFF, 0x80, 0x02, 0x02,
+    0x00, 0x84, 0x80, 0x3F, 0x00, 0x80, 0x3F, 0x03, 0x00, 0x80, 0xA0, 0x02, 0xAA, 0x80, 0x82, 0x02,
+    0xFF, 0x80, 0x2F, 0x03, 0x00, 0x84, 0xFD, 0x02, 0x00, 0xF8, 0x0B, 0x02, 0x00, 0x80, 0x40, 0x02,
+    0xAA, 0x81, 0x2A, 0xF8, 0x02, 0xFF, 0x80, 0x03, 0x02, 0x00, 0x84, 0xF0, 0x1F, 0x00, 0x40, 0xFF,
+    0x03, 0x00, 0x80, 0xA8, 0x02, 0xAA, 0x80, 0x41, 0x02, 0xFF, 0x80, 0x7F, 0x02, 0x00, 0x85, 0x80,
+    0xFF, 0x01, 0x00, 0xF0, 0x2F, 0x02, 0x00, 0x80, 0x80, 0x02, 0xAA, 0x81, 0x1A, 0xF0, 0x02, 0xFF,
+    0x80, 0x0F, 0x02, 0x00, 0x81, 0xFE, 0x0F, 0x02, 0x00, 0x81, 0xFF, 0x0B, 0x02, 0x00, 0x80, 0xA9,
+    0x02, 0xAA, 0x81, 0x00, 0xFE, 0x02, 0xFF, 0x83, 0x02, 0x00, 0xF8, 0xFF, 0x02, 0x00, 0x84, 0xE0,
+    0xFF, 0x07, 0x00, 0xA0, 0x02, 0xAA, 0x81, 0x0A, 0xD0, 0x02, 0xFF, 0x84, 0xBF, 0x00, 0xF4, 0xFF,
+    0x0F, 0x02, 0x00, 0x83, 0xFE, 0xFF, 0x02, 0x90, 0x02, 0xAA, 0x82, 0x6A, 0x00, 0xBC, 0x02, 0xFF,
+    0x81, 0xBF, 0xFA, 0x02, 0xFF, 0x02, 0x00, 0x83, 0xE0, 0xFF, 0xBF, 0x96, 0x03, 0xAA, 0x82, 0x02,
+    0x40, 0xF3, 0x05, 0xFF, 0x80, 0x0B, 0x02, 0x00, 0x82, 0xFE, 0xFF, 0xAB, 0x03, 0xAA, 0x80, 0x1A,
+    0x02, 0x00, 0x05, 0xFF, 0x80, 0xBF, 0x02, 0x00, 0x82, 0xE0, 0xFF, 0xBF, 0x03, 0xAA, 0x80, 0x9A,
+    0x02, 0x00, 0x80, 0xE0, 0x05, 0xFF, 0x80, 0x0B, 0x02, 0x00, 0x82, 0xFE, 0xFF, 0xAB, 0x03, 0xAA,
+    0x80, 0x01, 0x02, 0x00, 0x80, 0xFD, 0x04, 0xFF, 0x80, 0xBF, 0x02, 0x00, 0x82, 0xD0, 0xFF, 0xAF,
+    0x03, 0xAA, 0x80, 0x0A, 0x02, 0x00, 0x80, 0xC0, 0x05, 0xFF, 0x80, 0x0B, 0x02, 0x00, 0x81, 0xFD,
+    0xFF, 0x04, 0xAA, 0x03, 0x00, 0x80, 0xF8, 0x04, 0xFF, 0x80, 0xBF, 0x02, 0x00, 0x82, 0xD0, 0xFF,
+    0xAF, 0x03, 0xAA, 0x80, 0x06, 0x02, 0x00, 0x80, 0x40, 0x05, 0xFF, 0x80, 0x0B, 0x02, 0x00, 0x81,
+    0xFD, 0xFF, 0x03, 0xAA, 0x80, 0x2A, 0x03, 0x00, 0x80, 0xE0, 0x04, 0xFF, 0x80, 0xBF, 0x02, 0x00,
+    0x82, 0xD0, 0xFF, 0xAF, 0x03, 0xAA, 0x80, 0x01, 0x03, 0x00, 0x80, 0xFD, 0x04, 0xFF, 0x84, 0x1B,
+    0x00, 0x40, 0xFE, 0xBF, 0x03, 0xAA, 0x80, 0x0A, 0x03, 0x00, 0x80, 0xD0, 0x05, 0xFF, 0x84, 0x0F,
+    0x00, 0xFE, 0xFF, 0xAB, 0x02, 0xAA, 0x80, 0x6A, 0x04, 0x00, 0x80, 0xFD, 0x05, 0xFF, 0x83, 0x90,
+    0xE0, 0xFF, 0xBF, 0x03, 0xAA, 0x80, 0x02, 0x03, 0x00, 0x80, 0xE0, 0x05, 0xFF, 0x84, 0x4F, 0x2F,
+    0xFE, 0xFF, 0xAB, 0x02, 0xAA, 0x80, 0x6A, 0x04, 0x00, 0x06, 0xFF, 0x83, 0xFD, 0xFB, 0xFF, 0xBF,
+    0x03, 0xAA, 0x80, 0x0A, 0x03, 0x00, 0x80, 0xF4, 0x09, 0xFF, 0x04, 0xAA, 0x03, 0x00, 0x80, 0x80,
+    0x09, 0xFF, 0x80, 0xAF, 0x03, 0xAA, 0x80, 0x1A, 0x03, 0x00, 0x80, 0xF8, 0x09, 0xFF, 0x04, 0xAA,
+    0x80, 0x02, 0x02, 0x00, 0x80, 0xC0, 0x02, 0xFF, 0x80, 0xEB, 0x06, 0xFF, 0x80, 0xAF, 0x03, 0xAA,
+    0x80, 0x2A, 0x03, 0x00, 0x83, 0xFC, 0xFF, 0x2F, 0xFE, 0x05, 0xFF, 0x80, 0xBF, 0x04, 0xAA, 0x80,
+    0x02, 0x02, 0x00, 0x83, 0xD0, 0xFF, 0xBF, 0xF0, 0x06, 0xFF, 0x80, 0xAB, 0x03, 0xAA, 0x80, 0x2A,
+    0x03, 0x00, 0x82, 0xFD, 0xFF, 0x07, 0x06, 0xFF, 0x85, 0xBF, 0xAA, 0x6A, 0xA9, 0xAA, 0x06, 0x02,
+    0x00, 0x8E, 0xD0, 0xFF, 0x7F, 0xF0, 0xFF, 0xFE, 0xBF, 0xFF, 0xEF, 0xFF, 0x9B, 0xAA, 0x81, 0xAA,
+    0x6A, 0x03, 0x00, 0x8E, 0xFD, 0xFF, 0x07, 0xFF, 0xDF, 0xFF, 0xF7, 0xFF, 0xFD, 0x2F, 0xAA, 0x0A,
+    0xA8, 0xAA, 0x06, 0x02, 0x00, 0x8E, 0xD0, 0xFF, 0x7F, 0xE0, 0xFF, 0xFD, 0x7F, 0xFE, 0xCF, 0xFF,
+    0xA2, 0xAA, 0x80, 0xAA, 0x6A, 0x03, 0x00, 0x8E, 0xFD, 0xFF, 0x07, 0xFD, 0x9F, 0xFF, 0xE7, 0xFF,
+    0xFC, 0x2F, 0xAA, 0x0A, 0xA8, 0xAA, 0x06, 0x02, 0x00, 0x8E, 0xD0, 0xFF, 0x7F, 0xD0, 0xFF, 0xF9,
+    0x3F, 0xFE, 0xCF, 0xFF, 0xA2, 0x6A, 0x80, 0xAA, 0x6A, 0x03, 0x00, 0x8E, 0xFC, 0xFF, 0x07, 0xFC,
+    0x9F, 0xFF, 0xE3, 0xFF, 0xFC, 0x1B, 0xAA, 0x02, 0xA8, 0xAA, 0x02, 0x02, 0x00, 0x8E, 0xC0, 0xFF,
+    0x3F, 0x80, 0xFF, 0xF5, 0x3F, 0xFF, 0xCF, 0xBF, 0xA1, 0x2A, 0x80, 0xAA, 0x2A, 0x03, 0x00, 0x8E,
+    0xF8, 0xBF, 0x00, 0xF4, 0x5F, 0xFF, 0xF3, 0xFF, 0xF9, 0x1B, 0xAA, 0x01, 0x90, 0xAA, 0x02, 0x02,
+    0x00, 0x81, 0x40, 0x6F, 0x02, 0x00, 0x8A, 0xFF, 0xF5, 0x3F, 0xFF, 0x9F, 0xAF, 0xA1, 0x0A, 0x00,
+    0xA0, 0x2A, 0x03, 0x00, 0x80, 0x70, 0x02, 0x00, 0x87, 0xF0, 0x5F, 0xFF, 0xF3, 0xFF, 0xF9, 0x1A,
+    0xAA, 0x02, 0x00, 0x81, 0x90, 0x01, 0x06, 0x00, 0x87, 0xFE, 0xF1, 0x2F, 0xFF, 0x5F, 0xAF, 0xA1,
+    0x0A, 0x09, 0x00, 0x87, 0xD0, 0x1F, 0xFF, 0xF2, 0xFF, 0xF5, 0x0A, 0x6A, 0x0A, 0x00, 0x87, 0xFC,
+    0xF2, 0x1F, 0xFF, 0x5F, 0xAB, 0xA0, 0x02, 0x09, 0x00, 0x87, 0xC0, 0x1F, 0xFF, 0xF0, 0xFF, 0xB0,
+    0x0A, 0x2A, 0x0A, 0x00, 0x87, 0xF8, 0xE1, 0x0F, 0xFE, 0x0F, 0xAA, 0xA0, 0x02, 0x09, 0x00, 0x87,
+    0x80, 0x0F, 0x7D, 0xD0, 0x7F, 0x90, 0x06, 0x1A, 0x0A, 0x00, 0x87, 0xB4, 0x80, 0x03, 0xF8, 0x03,
+    0x28, 0x90, 0x01, 0x0A, 0x00, 0x83, 0x02, 0x00, 0x40, 0x1F, 0x02, 0x00, 0x80, 0x08, 0x09, 0x00,
+    0x81, 0x02, 0x0E, 0x02, 0x00, 0x80, 0x50, 0x02, 0x00, 0x82, 0x40, 0x0A, 0x04, 0x07, 0x00, 0x83,
+    0x70, 0xF0, 0x02, 0xA0, 0x02, 0x00, 0x83, 0x40, 0x00, 0xA4, 0x80, 0x07, 0x00, 0x8A, 0x40, 0x0B,
+    0x7F, 0x00, 0x1F, 0xE0, 0x00, 0x0A, 0x80, 0x0A, 0x18, 0x07, 0x00, 0x8A, 0xF8, 0xF0, 0x0F, 0xF4,
+    0x02, 0x1F, 0xA4, 0x01, 0xA9, 0x90, 0x01, 0x06, 0x00, 0x8A, 0x80, 0x1F, 0xFF, 0x82, 0x7F, 0xF4,
+    0x82, 0x1A, 0xA0, 0x0A, 0x2A, 0x07, 0x00, 0x8A, 0xF8, 0xF2, 0x3F, 0xFC, 0xDF, 0xBF, 0xAA, 0x82,
+    0xAA, 0xA4, 0x02, 0x06, 0x00, 0x83, 0x80, 0x7F, 0xFE, 0xDB, 0x02, 0xFF, 0x84, 0xAB, 0x6A, 0xA9,
+    0x8A, 0x2A, 0x07, 0x00, 0x81, 0xF8, 0xEF, 0x03, 0xFF, 0x80, 0xBF, 0x02, 0xAA, 0x82, 0x6A, 0xAA,
+    0x02, 0x06, 0x00, 0x80, 0x80, 0x05, 0xFF, 0x80, 0xAB, 0x03, 0xAA, 0x80, 0x2A, 0x07, 0x00, 0x80,
+    0xF4, 0x04, 0xFF, 0x80, 0xAF, 0x04, 0xAA, 0x80, 0x01, 0x06, 0x00, 0x80, 0x40, 0x05, 0xFF, 0x04,
+    0xAA, 0x80, 0x1A, 0x07, 0x00, 0x80, 0xF0, 0x04, 0xFF, 0x80, 0xAF, 0x04, 0xAA, 0x08, 0x00, 0x80,
+    0xFE, 0x03, 0xFF, 0x80, 0xBF, 0x04, 0xAA, 0x80, 0x0A, 0x07, 0x00, 0x80, 0xE0, 0x04, 0xFF, 0x80,
+    0xAB, 0x03, 0xAA, 0x80, 0x6A, 0x08, 0x00, 0x80, 0xFD, 0x03, 0xFF, 0x80, 0xBF, 0x04, 0xAA, 0x80,
+    0x02, 0x07, 0x00, 0x80, 0xC0, 0x04, 0xFF, 0x04, 0xAA, 0x80, 0x2A, 0x08, 0x00, 0x80, 0xF4, 0x03,
+    0xFF, 0x80, 0xAF, 0x04, 0xAA, 0x80, 0x01, 0x08, 0x00, 0x03, 0xFF, 0x80, 0xBF, 0x04, 0xAA, 0x80,
+    0x0A, 0x08, 0x00, 0x84, 0xE0, 0x6F, 0xFE, 0xFF, 0xAB, 0x02, 0xAA, 0x81, 0x5A, 0x6A, 0x09, 0x00,
+    0x83, 0xFD, 0x40, 0xFF, 0xBF, 0x02, 0xAA, 0x82, 0x0A, 0x90, 0x02, 0x08, 0x00, 0x83, 0x80, 0x07,
+    0x40, 0xFE, 0x02, 0xAA, 0x82, 0x1A, 0x00, 0x28, 0x0C, 0x00, 0x82, 0xA9, 0xAA, 0x05, 0x07, 0x00,
+};
+
+const uint32_t gfx_ghoul_logo_lz_length = 1489;
+
+const uint8_t gfx_ghoul_logo_lz[1489] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0xD1, 0x05, 0x00, 0x00, 0x2E, 0xFA, 0xFF,
+    0xFF, 0x46, 0x00, 0x80, 0x00, 0x01, 0x00, 0x01, 0xFE, 0x04, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+    0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x00, 0x02, 0xFF, 0xE8, 0x03, 0x05, 0xFA, 0xA1, 0x05, 0x00,
+    0x00, 0x00, 0x84, 0x00, 0x01, 0xF9, 0x6F, 0x85, 0x09, 0x83, 0x00, 0x03, 0x40, 0xFE, 0xFF, 0xBF,
+    0x8A, 0x10, 0x04, 0x80, 0xFF, 0xFF, 0xFF, 0x7F, 0x8A, 0x21, 0x80, 0x10, 0x01, 0xFF, 0x2F, 0x8B,
+    0x32, 0x80, 0x00, 0x00, 0x1F, 0x88, 0x11, 0x00, 0xFD, 0x81, 0x10, 0x01, 0xFF, 0x0B, 0x80, 0x09,
+    0x00, 0x01, 0x80, 0x40, 0x80, 0x06, 0x00, 0xF8, 0x82, 0x10, 0x04, 0xFF, 0x03, 0x00, 0x00, 0x20,
+    0x80, 0x0D, 0x03, 0x0E, 0x00, 0x00, 0xE0, 0x83, 0x10, 0x00, 0xFF, 0x80, 0x0D, 0x04, 0x02, 0x00,
+    0x00, 0xF4, 0x01, 0x82, 0x66, 0x81, 0x00, 0x06, 0x3F, 0x00, 0x00, 0xA0, 0x00, 0x00, 0xC0, 0x80,
+    0x4D, 0x82, 0x55, 0x80, 0x00, 0x03, 0x0F, 0x00, 0x00, 0x0A, 0x80, 0x52, 0x02, 0x01, 0x00, 0xF4,
+    0x84, 0x10, 0x09, 0xFF, 0x02, 0x00, 0xA4, 0x01, 0x00, 0xE0, 0x0F, 0x00, 0xD0, 0x85, 0x10, 0x05,
+    0xBF, 0x00, 0x40, 0x2A, 0x00, 0x00, 0x80, 0x4C, 0x85, 0x10, 0x80, 0x8D, 0x04, 0xA4, 0x06, 0x00,
+    0xF4, 0x0F, 0x85, 0x78, 0x81, 0x34, 0x04, 0x40, 0xAA, 0x00, 0x80, 0xBF, 0x87, 0x33, 0x80, 0xD4,
+    0x04, 0xA4, 0x0A, 0x00, 0xFC, 0x0B, 0x86, 0x67, 0x80, 0xB0, 0x04, 0x40, 0xAA, 0x01, 0xC0, 0xBF,
+    0x87, 0x67, 0x07, 0xFF, 0xBF, 0x01, 0xA4, 0x2A, 0x00, 0xFD, 0x0B, 0x85, 0x9B, 0x80, 0x00, 0x05,
+    0x2B, 0x40, 0xAA, 0x02, 0xD0, 0xBF, 0x84, 0xE0, 0x82, 0x22, 0x05, 0x06, 0xA4, 0x6A, 0x00, 0xFE,
+    0x0B, 0x85, 0xCF, 0x80, 0x00, 0x05, 0xAB, 0x40, 0xAA, 0x0A, 0xE0, 0xFF, 0x87, 0x8A, 0x07, 0xFF,
+    0xBF, 0x0A, 0xA4, 0xAA, 0x00, 0xFE, 0x0F, 0x87, 0x56, 0x02, 0xFF, 0xAA, 0x02, 0x81, 0x22, 0x88,
+    0x56, 0x02, 0xAF, 0x2A, 0xA0, 0x80, 0x22, 0x01, 0x1F, 0xFC, 0x88, 0x22, 0x01, 0x06, 0xA9, 0x80,
+    0x22, 0x00, 0xD1, 0x88, 0x22, 0x01, 0x6A, 0x90, 0x80, 0x22, 0x00, 0x2F, 0x87, 0xAD, 0x07, 0xFF,
+    0xAA, 0x0A, 0xA9, 0x0A, 0xF0, 0xFF, 0xF3, 0x88, 0x22, 0x05, 0xAA, 0xA0, 0x6A, 0x00, 0xFF, 0x7F,
+    0x87, 0x10, 0x07, 0xFF, 0xAA, 0x1A, 0xAA, 0x02, 0xF0, 0xFF, 0xFB, 0x89, 0x22, 0x01, 0xA6, 0x1A,
+    0x81, 0x9A, 0x00, 0xF7, 0x86, 0x11, 0x07, 0xA9, 0xAA, 0xAA, 0x00, 0xF0, 0xFF, 0xFF, 0x1F, 0x86,
+    0x10, 0x04, 0x0F, 0xAA, 0xAA, 0x1A, 0x40, 0x80, 0xB5, 0x80, 0x14, 0x84, 0x00, 0x03, 0x90, 0xAA,
+    0xAA, 0x06, 0x80, 0xBD, 0x00, 0x07, 0x86, 0x7B, 0x07, 0x0F, 0xA8, 0xAA, 0xAA, 0x41, 0xFF, 0xFF,
+    0x7F, 0x87, 0xF5, 0x08, 0x80, 0xAA, 0xAA, 0x2A, 0xF8, 0xFF, 0xFF, 0x03, 0xFD, 0x85, 0x10, 0x00,
+    0x0B, 0x80, 0x22, 0x04, 0x86, 0xFF, 0xFF, 0x3F, 0xD0, 0x85, 0x10, 0x00, 0x7F, 0x80, 0x22, 0x00,
+    0x6A, 0x80, 0xE0, 0x00, 0x07, 0x86, 0xE4, 0x00, 0x03, 0x80, 0x22, 0x00, 0xCA, 0x80, 0x68, 0x02,
+    0x80, 0xFF, 0xD7, 0x81, 0x0E, 0x02, 0xBF, 0xFD, 0x3F, 0x80, 0x22, 0x00, 0xAA, 0x80, 0x41, 0x02,
+    0x0F, 0xF4, 0x0F, 0x80, 0x4B, 0x04, 0xFF, 0xFF, 0x02, 0xFE, 0x02, 0x80, 0x9D, 0x00, 0xEA, 0x80,
+    0x09, 0x01, 0x01, 0x2E, 0x81, 0xB4, 0x04, 0xFF, 0x1F, 0x80, 0x0F, 0xA0, 0x80, 0x22, 0x80, 0x09,
+    0x02, 0x3F, 0x00, 0x00, 0x82, 0x7C, 0x01, 0x00, 0x00, 0x81, 0x33, 0x81, 0x22, 0x02, 0x0F, 0x00,
+    0x00, 0x81, 0x7C, 0x02, 0x0B, 0x00, 0x00, 0x80, 0x33, 0x00, 0x6A, 0x81, 0x0A, 0x02, 0x07, 0x00,
+    0x80, 0x83, 0x29, 0x80, 0x10, 0x01, 0xAA, 0xC2, 0x81, 0x61, 0x01, 0x00, 0x00, 0x80, 0xC6, 0x02,
+    0xFF, 0x02, 0x00, 0x81, 0x44, 0x00, 0x2A, 0x81, 0x87, 0x02, 0x07, 0x00, 0x00, 0x80, 0xD4, 0x80,
+    0x3A, 0x85, 0x22, 0x03, 0x2F, 0x00, 0x00, 0xC0, 0x80, 0xAB, 0x02, 0x00, 0x00, 0x00, 0x80, 0x10,
+    0x00, 0x1A, 0x80, 0x85, 0x80, 0x33, 0x81, 0x34, 0x03, 0x02, 0x00, 0x00, 0x90, 0x80, 0x11, 0x00,
+    0x81, 0x83, 0x33, 0x80, 0x69, 0x81, 0x05, 0x80, 0xBF, 0x81, 0x22, 0x80, 0x33, 0x07, 0x00, 0x94,
+    0xFF, 0x6F, 0x01, 0x00, 0x00, 0x40, 0x80, 0x22, 0x00, 0x82, 0x81, 0xAE, 0x80, 0x96, 0x83, 0x45,
+    0x80, 0x69, 0x00, 0x2A, 0x80, 0x22, 0x80, 0x61, 0x00, 0x00, 0x80, 0x6F, 0x00, 0x03, 0x80, 0x06,
+    0x80, 0x69, 0x80, 0x22, 0x81, 0x1B, 0x84, 0x68, 0x80, 0xC0, 0x00, 0x6A, 0x80, 0x22, 0x81, 0x50,
+    0x80, 0x22, 0x84, 0x57, 0x00, 0xC6, 0x82, 0xB8, 0x01, 0x00, 0xD0, 0x83, 0x22, 0x80, 0x57, 0x00,
+    0x6A, 0x80, 0x1B, 0x80, 0x84, 0x81, 0xE3, 0x80, 0xE2, 0x01, 0x00, 0xA4, 0x82, 0x22, 0x81, 0x79,
+    0x02, 0xE0, 0xBF, 0xD0, 0x81, 0xA3, 0x80, 0xAF, 0x81, 0x22, 0x80, 0x79, 0x03, 0x00, 0xFE, 0x03,
+    0xF8, 0x81, 0x6F, 0x80, 0x7A, 0x80, 0x22, 0x00, 0x1F, 0x80, 0x09, 0x03, 0xF0, 0x1F, 0x00, 0xFF,
+    0x8A, 0x22, 0x03, 0x40, 0xBF, 0x00, 0xE0, 0x81, 0x18, 0x87, 0x22, 0x03, 0xF4, 0x07, 0x00, 0xFC,
+    0x81, 0x5E, 0x80, 0xAE, 0x83, 0x68, 0x01, 0x80, 0x3F, 0x81, 0x02, 0x82, 0x22, 0x80, 0xAE, 0x81,
+    0x68, 0x03, 0xFD, 0x02, 0x00, 0xF8, 0x80, 0x7A, 0x80, 0x8B, 0x81, 0xD1, 0x80, 0xCA, 0x80, 0x56,
+    0x00, 0x40, 0x81, 0x57, 0x80, 0xAE, 0x00, 0x41, 0x82, 0xA7, 0x00, 0x80, 0x80, 0x5B, 0x00, 0xF0,
+    0x80, 0x2A, 0x80, 0xD1, 0x01, 0x1A, 0xF0, 0x82, 0xF4, 0x00, 0xFE, 0x80, 0x03, 0x81, 0xAF, 0x80,
+    0xF4, 0x01, 0x00, 0xFE, 0x81, 0x57, 0x00, 0xF8, 0x80, 0x30, 0x00, 0xE0, 0x80, 0xE4, 0x80, 0x56,
+    0x00, 0x0A, 0x80, 0xDC, 0x02, 0xBF, 0x00, 0xF4, 0x82, 0x26, 0x02, 0xFF, 0x02, 0x90, 0x80, 0x9C,
+    0x01, 0x00, 0xBC, 0x80, 0x11, 0x01, 0xFA, 0xFF, 0x82, 0x22, 0x08, 0xBF, 0x96, 0xAA, 0xAA, 0xAA,
+    0x02, 0x40, 0xF3, 0xFF, 0x81, 0x00, 0x80, 0x41, 0x02, 0xFE, 0xFF, 0xAB, 0x80, 0x10, 0x00, 0x1A,
+    0x80, 0x4E, 0x81, 0x00, 0x80, 0xF1, 0x80, 0x22, 0x80, 0x10, 0x00, 0x9A, 0x81, 0x08, 0x8A, 0x22,
+    0x80, 0xDE, 0x00, 0xFD, 0x84, 0x22, 0x02, 0xD0, 0xFF, 0xAF, 0x80, 0x10, 0x03, 0x0A, 0x00, 0x00,
+    0xC0, 0x85, 0x22, 0x01, 0xFD, 0xFF, 0x80, 0x10, 0x00, 0xAA, 0x80, 0xB3, 0x80, 0xC1, 0x88, 0x22,
+    0x00, 0x06, 0x80, 0xD6, 0x8A, 0x22, 0x00, 0x2A, 0x80, 0x22, 0x82, 0x57, 0x86, 0x22, 0x80, 0x56,
+    0x83, 0x57, 0x03, 0x1B, 0x00, 0x40, 0xFE, 0x81, 0x79, 0x80, 0x56, 0x80, 0x1A, 0x81, 0x00, 0x00,
+    0x0F, 0x83, 0x79, 0x00, 0x6A, 0x80, 0x10, 0x83, 0x22, 0x01, 0xFF, 0x90, 0x83, 0x9C, 0x00, 0x02,
+    0x85, 0x45, 0x02, 0xFF, 0x4F, 0x2F, 0x87, 0x22, 0x82, 0x10, 0x02, 0xFF, 0xFD, 0xFB, 0x82, 0x22,
+    0x81, 0x45, 0x00, 0xF4, 0x83, 0x11, 0x80, 0x00, 0x84, 0x9C, 0x00, 0x80, 0x86, 0x10, 0x81, 0x79,
+    0x80, 0xF3, 0x83, 0xAE, 0x86, 0x22, 0x80, 0x57, 0x80, 0xD1, 0x00, 0xEB, 0x87, 0x22, 0x81, 0xAE,
+    0x01, 0xFC, 0xFF, 0x80, 0x63, 0x82, 0xB2, 0x84, 0x22, 0x03, 0xD0, 0xFF, 0xBF, 0xF0, 0x83, 0x22,
+    0x80, 0x79, 0x82, 0x22, 0x02, 0xFD, 0xFF, 0x07, 0x83, 0x10, 0x03, 0xBF, 0xAA, 0x6A, 0xA9, 0x81,
+    0xF4, 0x0C, 0xD0, 0xFF, 0x7F, 0xF0, 0xFF, 0xFE, 0xBF, 0xFF, 0xEF, 0xFF, 0x9B, 0xAA, 0x81, 0x82,
+    0x9D, 0x81, 0x22, 0x08, 0xDF, 0xFF, 0xF7, 0xFF, 0xFD, 0x2F, 0xAA, 0x0A, 0xA8, 0x84, 0x22, 0x09,
+    0xE0, 0xFF, 0xFD, 0x7F, 0xFE, 0xCF, 0xFF, 0xA2, 0xAA, 0x80, 0x85, 0x22, 0x05, 0xFD, 0x9F, 0xFF,
+    0xE7, 0xFF, 0xFC, 0x88, 0x22, 0x03, 0xD0, 0xFF, 0xF9, 0x3F, 0x81, 0x22, 0x00, 0x6A, 0x83, 0x22,
+    0x0C, 0xFC, 0xFF, 0x07, 0xFC, 0x9F, 0xFF, 0xE3, 0xFF, 0xFC, 0x1B, 0xAA, 0x02, 0xA8, 0x83, 0xAE,
+    0x0A, 0x3F, 0x80, 0xFF, 0xF5, 0x3F, 0xFF, 0xCF, 0xBF, 0xA1, 0x2A, 0x80, 0x82, 0x8B, 0x0C, 0xF8,
+    0xBF, 0x00, 0xF4, 0x5F, 0xFF, 0xF3, 0xFF, 0xF9, 0x1B, 0xAA, 0x01, 0x90, 0x81, 0x22, 0x03, 0x40,
+    0x6F, 0x00, 0x00, 0x81, 0x22, 0x05, 0x9F, 0xAF, 0xA1, 0x0A, 0x00, 0xA0, 0x81, 0x22, 0x03, 0x70,
+    0x00, 0x00, 0xF0, 0x82, 0x22, 0x05, 0x1A, 0xAA, 0x00, 0x00, 0x90, 0x01, 0x80, 0x11, 0x80, 0x00,
+    0x04, 0xFE, 0xF1, 0x2F, 0xFF, 0x5F, 0x81, 0x22, 0x85, 0x00, 0x06, 0xD0, 0x1F, 0xFF, 0xF2, 0xFF,
+    0xF5, 0x0A, 0x81, 0x76, 0x84, 0x00, 0x06, 0xFC, 0xF2, 0x1F, 0xFF, 0x5F, 0xAB, 0xA0, 0x80, 0x53,
+    0x84, 0x00, 0x06, 0xC0, 0x1F, 0xFF, 0xF0, 0xFF, 0xB0, 0x0A, 0x81, 0x53, 0x84, 0x00, 0x05, 0xF8,
+    0xE1, 0x0F, 0xFE, 0x0F, 0xAA, 0x88, 0x22, 0x07, 0x80, 0x0F, 0x7D, 0xD0, 0x7F, 0x90, 0x06, 0x1A,
+    0x87, 0x22, 0x05, 0xB4, 0x80, 0x03, 0xF8, 0x03, 0x28, 0x85, 0x76, 0x81, 0x00, 0x06, 0x02, 0x00,
+    0x40, 0x1F, 0x00, 0x00, 0x08, 0x87, 0x0F, 0x03, 0x0E, 0x00, 0x00, 0x50, 0x80, 0xB8, 0x01, 0x0A,
+    0x04, 0x84, 0x10, 0x03, 0x70, 0xF0, 0x02, 0xA0, 0x80, 0x0F, 0x02, 0x00, 0xA4, 0x80, 0x84, 0x10,
+    0x0A, 0x40, 0x0B, 0x7F, 0x00, 0x1F, 0xE0, 0x00, 0x0A, 0x80, 0x0A, 0x18, 0x85, 0x78, 0x07, 0xF0,
+    0x0F, 0xF4, 0x02, 0x1F, 0xA4, 0x01, 0xA9, 0x85, 0x58, 0x08, 0x80, 0x1F, 0xFF, 0x82, 0x7F, 0xF4,
+    0x82, 0x1A, 0xA0, 0x86, 0x9E, 0x09, 0xF8, 0xF2, 0x3F, 0xFC, 0xDF, 0xBF, 0xAA, 0x82, 0xAA, 0xA4,
+    0x84, 0x9E, 0x09, 0x80, 0x7F, 0xFE, 0xDB, 0xFF, 0xFF, 0xAB, 0x6A, 0xA9, 0x8A, 0x86, 0x22, 0x08,
+    0xEF, 0xFF, 0xFF, 0xFF, 0xBF, 0xAA, 0xAA, 0x6A, 0xAA, 0x85, 0x22, 0x80, 0x0F, 0x80, 0x22, 0x02,
+    0xAA, 0xAA, 0xAA, 0x85, 0x22, 0x00, 0xF4, 0x81, 0x10, 0x00, 0xAF, 0x80, 0x10, 0x00, 0xAA, 0x84,
+    0x68, 0x00, 0x40, 0x82, 0x22, 0x81, 0x10, 0x85, 0xE4, 0x00, 0xF0, 0x86, 0x22, 0x85, 0xD1, 0x00,
+    0xFE, 0x83, 0x56, 0x02, 0xAA, 0xAA, 0x0A, 0x84, 0x10, 0x00, 0xE0, 0x85, 0x56, 0x00, 0x6A, 0x85,
+    0x22, 0x00, 0xFD, 0x85, 0x22, 0x84, 0x79, 0x01, 0x00, 0xC0, 0x85, 0x56, 0x85, 0x79, 0x82, 0x7A,
+    0x89, 0x79, 0x01, 0x00, 0x00, 0x8D, 0x56, 0x03, 0x00, 0xE0, 0x6F, 0xFE, 0x81, 0x56, 0x00, 0x5A,
+    0x86, 0x56, 0x02, 0x00, 0xFD, 0x40, 0x81, 0x22, 0x01, 0x0A, 0x90, 0x85, 0x56, 0x04, 0x00, 0x80,
+    0x07, 0x40, 0xFE, 0x81, 0xAB, 0x00, 0x28, 0x86, 0x22, 0x80, 0x00, 0x02, 0xA9, 0xAA, 0x05, 0x84,
+    0x09,
+};
+// clang-format on
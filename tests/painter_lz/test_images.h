@@ -0,0 +1,14 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+// The same image, uncompressed, RLE-compressed, and LZ-compressed
+extern const uint32_t gfx_ghoul_logo_raw_length;
+extern const uint8_t  gfx_ghoul_logo_raw[];
+extern const uint32_t gfx_ghoul_logo_rle_length;
+extern const uint8_t  gfx_ghoul_logo_rle[];
+extern const uint32_t gfx_ghoul_logo_lz_length;
+extern const uint8_t  gfx_ghoul_logo_lz[];
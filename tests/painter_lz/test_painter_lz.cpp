@@ -0,0 +1,123 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+#include "qp_draw.h"
+#include "test_images.h"
+}
+
+#define IMAGE_WIDTH 70
+#define IMAGE_HEIGHT 128
+
+static uint8_t          raw_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(IMAGE_WIDTH, IMAGE_HEIGHT, 16)];
+static uint8_t          rle_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(IMAGE_WIDTH, IMAGE_HEIGHT, 16)];
+static uint8_t          lz_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(IMAGE_WIDTH, IMAGE_HEIGHT, 16)];
+static painter_device_t raw_surface;
+static painter_device_t rle_surface;
+static painter_device_t lz_surface;
+
+class PainterLz : public TestFixture {
+   protected:
+    void SetUp() override {
+        if (!raw_surface) {
+            raw_surface = qp_make_rgb565_surface(IMAGE_WIDTH, IMAGE_HEIGHT, raw_buffer);
+            rle_surface = qp_make_rgb565_surface(IMAGE_WIDTH, IMAGE_HEIGHT, rle_buffer);
+            lz_surface  = qp_make_rgb565_surface(IMAGE_WIDTH, IMAGE_HEIGHT, lz_buffer);
+        }
+        qp_init(raw_surface, QP_ROTATION_0);
+        qp_init(rle_surface, QP_ROTATION_0);
+        qp_init(lz_surface, QP_ROTATION_0);
+    }
+
+    /* Runs the LZ decoder over the given data, until it fails or has produced the expected number of bytes. */
+    static std::vector<int16_t> decode(std::vector<uint8_t> data, size_t count) {
+        qp_memory_stream_t             stream      = qp_make_memory_stream(data.data(), data.size());
+        qp_internal_byte_input_state_t input_state = {.device = nullptr, .src_stream = (qp_stream_t *)&stream};
+        qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, IMAGE_COMPRESSED_LZ);
+
+        std::vector<int16_t> output;
+        while (output.size() < count) {
+            int16_t c = input_callback(&input_state);
+            output.push_back(c);
+            if (c < 0) {
+                break;
+            }
+        }
+        return output;
+    }
+
+    /* Draws the image repeatedly, returning the average time taken per draw. */
+    static double time_draws(painter_device_t surface, const uint8_t *image_data) {
+        painter_image_handle_t image = qp_load_image_mem(image_data);
+        EXPECT_NE(image, nullptr);
+
+        const int iterations = 200;
+        auto      start      = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            qp_drawimage(surface, 0, 0, image);
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        qp_close_image(image);
+        return elapsed.count() / iterations;
+    }
+};
+
+TEST_F(PainterLz, DecodesLiteralsAndBackReferences) {
+    // Output of compress_bytes_qmk_lz() in lib/python/qmk/painter.py
+    std::vector<int16_t> expected = {1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 9, 9, 9, 9, 9, 9, 9, 9, 5};
+    EXPECT_EQ(decode({0x02, 1, 2, 3, 0x85, 2, 0x00, 9, 0x84, 0, 0x00, 5}, expected.size()), expected);
+}
+
+TEST_F(PainterLz, TruncatedDataFails) {
+    std::vector<int16_t> expected = {1, 2, STREAM_EOF};
+    EXPECT_EQ(decode({0x03, 1, 2}, 4), expected);
+
+    // Back-reference with its offset missing
+    expected = {1, STREAM_EOF};
+    EXPECT_EQ(decode({0x00, 1, 0x80}, 4), expected);
+}
+
+TEST_F(PainterLz, ImageMatchesOtherCompressionSchemes) {
+    painter_image_handle_t raw_image = qp_load_image_mem(gfx_ghoul_logo_raw);
+    painter_image_handle_t rle_image = qp_load_image_mem(gfx_ghoul_logo_rle);
+    painter_image_handle_t lz_image  = qp_load_image_mem(gfx_ghoul_logo_lz);
+    ASSERT_NE(raw_image, nullptr);
+    ASSERT_NE(rle_image, nullptr);
+    ASSERT_NE(lz_image, nullptr);
+
+    EXPECT_TRUE(qp_drawimage(raw_surface, 0, 0, raw_image));
+    EXPECT_TRUE(qp_drawimage(rle_surface, 0, 0, rle_image));
+    EXPECT_TRUE(qp_drawimage(lz_surface, 0, 0, lz_image));
+    EXPECT_EQ(memcmp(lz_buffer, raw_buffer, sizeof(lz_buffer)), 0);
+    EXPECT_EQ(memcmp(lz_buffer, rle_buffer, sizeof(lz_buffer)), 0);
+
+    // The image isn't blank
+    uint8_t blank[sizeof(lz_buffer)] = {0};
+    EXPECT_NE(memcmp(lz_buffer, blank, sizeof(lz_buffer)), 0);
+
+    qp_close_image(raw_image);
+    qp_close_image(rle_image);
+    qp_close_image(lz_image);
+}
+
+TEST_F(PainterLz, DecodeThroughput) {
+    // Records how long each compression scheme takes to draw the same image on the host, as test properties
+    double raw_us = time_draws(raw_surface, gfx_ghoul_logo_raw);
+    double rle_us = time_draws(rle_surface, gfx_ghoul_logo_rle);
+    double lz_us  = time_draws(lz_surface, gfx_ghoul_logo_lz);
+
+    RecordProperty("raw_us_per_draw", (int)raw_us);
+    RecordProperty("rle_us_per_draw", (int)rle_us);
+    RecordProperty("lz_us_per_draw", (int)lz_us);
+
+    EXPECT_LT(gfx_ghoul_logo_lz_length, gfx_ghoul_logo_rle_length);
+}
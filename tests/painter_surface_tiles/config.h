@@ -0,0 +1,9 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SURFACE_NUM_DEVICES 2
+#define SURFACE_DIRTY_TILES
@@ -0,0 +1,91 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+}
+
+#define PANEL_WIDTH 240
+#define PANEL_HEIGHT 320
+
+static uint8_t          source_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+static uint8_t          target_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16)];
+static painter_device_t source;
+static painter_device_t target;
+
+class PainterSurfaceTiles : public TestFixture {
+   protected:
+    void SetUp() override {
+        if (!source) {
+            source = qp_make_rgb565_surface(PANEL_WIDTH, PANEL_HEIGHT, source_buffer);
+            target = qp_make_rgb565_surface(PANEL_WIDTH, PANEL_HEIGHT, target_buffer);
+        }
+        qp_init(source, QP_ROTATION_0);
+        qp_init(target, QP_ROTATION_0);
+
+        // Send the blank surface over, then mark the target so anything sent afterwards shows up
+        qp_surface_draw(source, target, 0, 0, false);
+        qp_rect(target, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 0, 255, 255, true);
+    }
+
+    static uint16_t pixel(const uint8_t *buffer, uint16_t x, uint16_t y) {
+        return ((const uint16_t *)buffer)[y * PANEL_WIDTH + x];
+    }
+
+    static bool was_sent(uint16_t x, uint16_t y) {
+        return pixel(target_buffer, x, y) == pixel(source_buffer, x, y);
+    }
+};
+
+TEST_F(PainterSurfaceTiles, OppositeCornersAreSentSeparately) {
+    qp_rect(source, 2, 2, 40, 12, 0, 255, 255, true);
+    qp_rect(source, 200, 300, 236, 316, 85, 255, 255, true);
+    EXPECT_TRUE(qp_surface_draw(source, target, 0, 0, false));
+
+    EXPECT_TRUE(was_sent(2, 2));
+    EXPECT_TRUE(was_sent(40, 12));
+    EXPECT_TRUE(was_sent(200, 300));
+    EXPECT_TRUE(was_sent(236, 316));
+
+    // Everything between the two corners is left alone
+    EXPECT_FALSE(was_sent(120, 160));
+    EXPECT_FALSE(was_sent(236, 12));
+    EXPECT_FALSE(was_sent(2, 316));
+}
+
+TEST_F(PainterSurfaceTiles, SmallChangeSendsOnlyTheChange) {
+    qp_setpixel(source, 100, 100, 0, 255, 255);
+    EXPECT_TRUE(qp_surface_draw(source, target, 0, 0, false));
+    EXPECT_TRUE(was_sent(100, 100));
+    EXPECT_FALSE(was_sent(101, 100));
+    EXPECT_FALSE(was_sent(100, 101));
+}
+
+TEST_F(PainterSurfaceTiles, DrawClearsDirtyTiles) {
+    qp_setpixel(source, 100, 100, 0, 255, 255);
+    EXPECT_TRUE(qp_surface_draw(source, target, 0, 0, false));
+    qp_rect(target, 0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1, 0, 255, 255, true);
+    qp_setpixel(source, 10, 10, 0, 255, 255);
+    EXPECT_TRUE(qp_surface_draw(source, target, 0, 0, false));
+    EXPECT_TRUE(was_sent(10, 10));
+    EXPECT_FALSE(was_sent(0, 0));
+}
+
+TEST_F(PainterSurfaceTiles, ScatteredChangesMatchSource) {
+    for (uint16_t i = 0; i < 50; i++) {
+        qp_setpixel(source, (i * 37) % PANEL_WIDTH, (i * 91) % PANEL_HEIGHT, 0, 255, 255);
+    }
+    qp_rect(source, 30, 30, 90, 200, 170, 255, 255, true);
+    EXPECT_TRUE(qp_surface_draw(source, target, 0, 0, false));
+    for (uint16_t i = 0; i < 50; i++) {
+        EXPECT_TRUE(was_sent((i * 37) % PANEL_WIDTH, (i * 91) % PANEL_HEIGHT));
+    }
+    for (uint16_t y = 30; y <= 200; y++) {
+        for (uint16_t x = 30; x <= 90; x++) {
+            ASSERT_TRUE(was_sent(x, y));
+        }
+    }
+}
@@ -0,0 +1,9 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+POINTING_DEVICE_ENABLE = yes
+POINTING_DEVICE_DRIVER = custom
@@ -0,0 +1,85 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+#include <vector>
+
+extern "C" {
+#include "pointing_device.h"
+
+// Motion the sensor picks up on each sample
+static mouse_xy_report_t sample_x;
+
+report_mouse_t pointing_device_driver_get_report(report_mouse_t mouse_report) {
+    mouse_report.x = sample_x;
+    return mouse_report;
+}
+}
+
+using testing::_;
+using testing::Invoke;
+
+class PointingDeviceSofSync : public TestFixture {
+   protected:
+    TestDriver       driver;
+    std::vector<int> sent_x;
+
+    void SetUp() override {
+        sample_x = 0;
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t &report) { sent_x.push_back(report.x); }));
+    }
+
+    /* Runs one scan loop, preceded by a USB frame. */
+    void run_frame() {
+        pointing_device_sof();
+        run_one_scan_loop();
+    }
+
+    void run_frames(int count) {
+        for (int i = 0; i < count; i++) {
+            run_frame();
+        }
+    }
+};
+
+TEST_F(PointingDeviceSofSync, MotionIsHeldUntilTheNextPoll) {
+    run_frames(POINTING_DEVICE_SOF_INTERVAL);
+
+    // The host hasn't been sent anything for a while, so the first sample goes straight out
+    sample_x = 10;
+    run_frame();
+    EXPECT_EQ(sent_x, std::vector<int>({10}));
+
+    // The samples in between are summed into the next report
+    run_frames(POINTING_DEVICE_SOF_INTERVAL - 1);
+    EXPECT_EQ(sent_x, std::vector<int>({10}));
+    run_frame();
+    EXPECT_EQ(sent_x, std::vector<int>({10, 40}));
+
+    sample_x = 0;
+    run_frames(POINTING_DEVICE_SOF_INTERVAL * 2);
+    EXPECT_EQ(sent_x, std::vector<int>({10, 40}));
+}
+
+TEST_F(PointingDeviceSofSync, MotionBeyondReportRangeIsCarriedOver) {
+    run_frames(POINTING_DEVICE_SOF_INTERVAL);
+
+    sample_x = 100;
+    run_frames(POINTING_DEVICE_SOF_INTERVAL + 1);
+    sample_x = 0;
+    run_frames(POINTING_DEVICE_SOF_INTERVAL * 4);
+
+    // Nothing is lost to clamping, it just arrives over the following reports
+    EXPECT_EQ(sent_x, std::vector<int>({100, XY_REPORT_MAX, XY_REPORT_MAX, XY_REPORT_MAX, 400 - 3 * XY_REPORT_MAX}));
+}
+
+TEST_F(PointingDeviceSofSync, ReportsAreNotHeldWithoutUsbFrames) {
+    idle_for(POINTING_DEVICE_SOF_TIMEOUT);
+
+    sample_x = 10;
+    idle_for(3);
+    sample_x = 0;
+    run_one_scan_loop();
+    EXPECT_EQ(sent_x, std::vector<int>({10, 10, 10}));
+}
@@ -0,0 +1,126 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class ResolvedLayersCache : public TestFixture {
+   protected:
+    void SetUp() override {
+        /* Every layer maps a different subset of keys, everything else is transparent. */
+        for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    uint16_t keycode = (layer == 0 || (row + col + layer) % 5 == 0) ? KC_A + ((row + col + layer) % 26) : KC_TRNS;
+                    add_key(KeymapKey{layer, col, row, keycode});
+                }
+            }
+        }
+        invalidate_resolved_layers_cache();
+    }
+
+    /* Reference implementation of the uncached top-down layer scan. */
+    static uint8_t scan_layers(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+            if ((layers & ((layer_state_t)1 << i)) && action_for_key(i, key).code != ACTION_TRANSPARENT) {
+                return i;
+            }
+        }
+        return 0;
+    }
+};
+
+TEST_F(ResolvedLayersCache, MatchesLayerScan) {
+    TestDriver                         driver;
+    std::mt19937                       rng(0xC0FFEE);
+    std::uniform_int_distribution<int> layer_dist(0, MAX_LAYER - 1);
+
+    for (int i = 0; i < 64; i++) {
+        /* Mix single layer toggles with wholesale state changes. */
+        if (i % 4 == 0) {
+            layer_state_set(rng());
+        } else {
+            layer_invert(layer_dist(rng));
+        }
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                EXPECT_EQ(layer_switch_get_layer(key), scan_layers(key)) << "layer_state " << layer_state << " at (" << +col << "," << +row << ")";
+            }
+        }
+    }
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayersCache, FollowsDirectLayerStateAssignment) {
+    TestDriver driver;
+    keypos_t   key = {.col = 4, .row = 0};
+
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    /* Bypassing layer_state_set must not leave a stale cache behind. */
+    layer_state = (layer_state_t)1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayersCache, KeypressUsesResolvedLayer) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{6, 4, 0, KC_K};
+
+    layer_on(6);
+
+    /* (4,0) on layer 6 maps to KC_K, nothing above it is active. */
+    EXPECT_REPORT(driver, (key.report_code));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Releasing after the layer is gone must still release the same key. */
+    layer_off(6);
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayersCache, Benchmark) {
+    TestDriver    driver;
+    constexpr int iterations = 50;
+
+    /* Worst case for the scan: all 32 layers on, most keys fall through to low layers. */
+    layer_state_set((layer_state_t)~0);
+    layer_switch_get_layer((keypos_t){.col = 0, .row = 0});
+
+    auto bench = [&](uint8_t (*lookup)(keypos_t)) {
+        volatile uint32_t sink  = 0;
+        auto              start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    sink = sink + lookup((keypos_t){.col = col, .row = row});
+                }
+            }
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (iterations * MATRIX_ROWS * MATRIX_COLS);
+    };
+
+    double scan_ns   = bench(scan_layers);
+    double cached_ns = bench(layer_switch_get_layer);
+
+    RecordProperty("layer_scan_ns_per_lookup", (int)scan_ns);
+    RecordProperty("resolved_layers_cache_ns_per_lookup", (int)cached_ns);
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
@@ -0,0 +1,159 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// rgb_matrix_types.h checks its layout with the C11 spelling
+#define _Static_assert static_assert
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "action_layer.h"
+
+void advance_time(uint32_t ms);
+
+led_config_t g_led_config = {};
+
+static int     set_color_calls;
+static int     flush_calls;
+static uint8_t flush_first;
+static uint8_t flush_last;
+static int     indicator_calls;
+static bool    indicator_red;
+
+static void mock_init(void) {}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    set_color_calls++;
+}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void mock_flush(void) {}
+
+static void mock_flush_range(uint8_t first, uint8_t last) {
+    flush_calls++;
+    flush_first = first;
+    flush_last  = last;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+    .flush_range   = mock_flush_range,
+};
+
+bool rgb_matrix_indicators_user(void) {
+    indicator_calls++;
+    if (indicator_red || IS_LAYER_ON(1)) {
+        rgb_matrix_set_color(2, 255, 0, 0);
+    }
+    return true;
+}
+}
+
+class RgbMatrixDirty : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            g_led_config.flags[i] = LED_FLAG_KEYLIGHT;
+        }
+        indicator_red = false;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(0, 0, 100);
+        run_frames(2);
+        reset_counters();
+    }
+
+    static void reset_counters() {
+        set_color_calls = 0;
+        flush_calls     = 0;
+        indicator_calls = 0;
+    }
+
+    /* Steps the task through syncing, starting, rendering and flushing for each frame. */
+    static void run_frames(int count) {
+        for (int i = 0; i < count; i++) {
+            advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+            for (int j = 0; j < 4; j++) {
+                rgb_matrix_task();
+            }
+        }
+    }
+};
+
+TEST_F(RgbMatrixDirty, StaticEffectIsNotRerendered) {
+    run_frames(10);
+    EXPECT_EQ(indicator_calls, 0);
+    EXPECT_EQ(set_color_calls, 0);
+    EXPECT_EQ(flush_calls, 0);
+}
+
+TEST_F(RgbMatrixDirty, ConfigChangeFlushesChangedLeds) {
+    rgb_matrix_sethsv_noeeprom(0, 0, 50);
+    run_frames(3);
+    EXPECT_EQ(indicator_calls, 1);
+    EXPECT_EQ(set_color_calls, RGB_MATRIX_LED_COUNT);
+    EXPECT_EQ(flush_calls, 1);
+    EXPECT_EQ(flush_first, 0);
+    EXPECT_EQ(flush_last, RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrixDirty, LayerChangeRerendersIndicators) {
+    layer_on(1);
+    run_frames(3);
+    EXPECT_EQ(indicator_calls, 1);
+    EXPECT_EQ(set_color_calls, 1);
+    EXPECT_EQ(flush_calls, 1);
+    EXPECT_EQ(flush_first, 2);
+    EXPECT_EQ(flush_last, 3);
+
+    reset_counters();
+    layer_off(1);
+    run_frames(3);
+    EXPECT_EQ(indicator_calls, 1);
+    EXPECT_EQ(set_color_calls, 1);
+    EXPECT_EQ(flush_calls, 1);
+}
+
+TEST_F(RgbMatrixDirty, InvalidateForcesRender) {
+    indicator_red = true;
+    run_frames(3);
+    EXPECT_EQ(indicator_calls, 0);
+
+    rgb_matrix_invalidate();
+    run_frames(3);
+    EXPECT_EQ(indicator_calls, 1);
+    EXPECT_EQ(flush_calls, 1);
+    EXPECT_EQ(flush_first, 2);
+    EXPECT_EQ(flush_last, 3);
+
+    indicator_red = false;
+    rgb_matrix_invalidate();
+    run_frames(1);
+}
+
+TEST_F(RgbMatrixDirty, StaticEffectIsPeriodicallyRefreshed) {
+    advance_time(RGB_MATRIX_STATIC_REFRESH_INTERVAL);
+    run_frames(3);
+    EXPECT_EQ(indicator_calls, 1);
+    EXPECT_EQ(set_color_calls, 0);
+    EXPECT_EQ(flush_calls, 0);
+}
+
+TEST_F(RgbMatrixDirty, IdenticalAnimatedFrameIsNotFlushed) {
+    rgb_matrix_set_speed_noeeprom(0);
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_BREATHING);
+    run_frames(2);
+    reset_counters();
+
+    run_frames(5);
+    EXPECT_EQ(indicator_calls, 5);
+    EXPECT_EQ(set_color_calls, 0);
+    EXPECT_EQ(flush_calls, 0);
+}
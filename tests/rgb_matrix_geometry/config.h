@@ -0,0 +1,14 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 52
+#define RGB_MATRIX_GEOMETRY_CACHE
+#define RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#define ENABLE_RGB_MATRIX_TYPING_HEATMAP
+#define RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP 32
+#define RGB_MATRIX_TYPING_HEATMAP_SPREAD 40
+#define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
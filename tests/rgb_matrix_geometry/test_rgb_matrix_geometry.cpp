@@ -0,0 +1,157 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// rgb_matrix_types.h checks its layout with the C11 spelling
+#define _Static_assert static_assert
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+
+/* A 4x10 grid of keys at the usual 15 by 16 unit pitch, plus twelve underglow LEDs along the bottom edge. */
+led_config_t g_led_config = {};
+
+static void mock_init(void) {}
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+static void mock_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+};
+}
+
+class RgbMatrixGeometry : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        memset(&g_led_config.matrix_co, NO_LED, sizeof(g_led_config.matrix_co));
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint8_t led                      = row * MATRIX_COLS + col;
+                g_led_config.matrix_co[row][col] = led;
+                g_led_config.point[led]          = {(uint8_t)(10 + col * 15), (uint8_t)(8 + row * 16)};
+                g_led_config.flags[led]          = LED_FLAG_KEYLIGHT;
+            }
+        }
+        for (uint8_t i = 0; i < UNDERGLOW_COUNT; i++) {
+            g_led_config.point[FIRST_UNDERGLOW + i] = {(uint8_t)(i * 20), 64};
+            g_led_config.flags[FIRST_UNDERGLOW + i] = LED_FLAG_UNDERGLOW;
+        }
+        rgb_matrix_geometry_init();
+    }
+
+    static const uint8_t FIRST_UNDERGLOW = MATRIX_ROWS * MATRIX_COLS;
+    static const uint8_t UNDERGLOW_COUNT = RGB_MATRIX_LED_COUNT - FIRST_UNDERGLOW;
+
+    static uint8_t distance(uint8_t a, uint8_t b) {
+        int16_t dx = g_led_config.point[a].x - g_led_config.point[b].x;
+        int16_t dy = g_led_config.point[a].y - g_led_config.point[b].y;
+        return sqrt16(dx * dx + dy * dy);
+    }
+
+    /* Reference implementation of the uncached matrix scan. */
+    static void expect_heatmap_matches_full_scan(void) {
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint8_t expected[MATRIX_ROWS][MATRIX_COLS] = {};
+                uint8_t pressed                            = g_led_config.matrix_co[row][col];
+                for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+                    for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                        uint8_t target = g_led_config.matrix_co[i_row][i_col];
+                        if (target == pressed) {
+                            expected[i_row][i_col] = RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP;
+                        } else if (distance(pressed, target) <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                            expected[i_row][i_col] = MIN(RGB_MATRIX_TYPING_HEATMAP_SPREAD - distance(pressed, target), RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT);
+                        }
+                    }
+                }
+
+                memset(g_rgb_frame_buffer, 0, sizeof(g_rgb_frame_buffer));
+                process_rgb_matrix(row, col, true);
+                EXPECT_EQ(memcmp(g_rgb_frame_buffer, expected, sizeof(expected)), 0) << "key " << +row << "," << +col;
+            }
+        }
+    }
+};
+
+TEST_F(RgbMatrixGeometry, CenterGeometry) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        EXPECT_EQ(g_led_geometry[i].dx, dx);
+        EXPECT_EQ(g_led_geometry[i].dy, dy);
+        EXPECT_EQ(g_led_geometry[i].dist, sqrt16(dx * dx + dy * dy));
+        EXPECT_EQ(g_led_geometry[i].angle, atan2_8(dy, dx));
+    }
+    EXPECT_EQ(g_led_geometry[14].row, 1);
+    EXPECT_EQ(g_led_geometry[14].col, 4);
+    EXPECT_EQ(g_led_geometry[FIRST_UNDERGLOW].row, UINT8_MAX);
+}
+
+TEST_F(RgbMatrixGeometry, NeighboursAreNearestSorted) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        // Every LED not in the table is at least as far as the furthest one in it
+        uint8_t furthest = 0;
+        for (uint8_t n = 0; n < RGB_MATRIX_GEOMETRY_NEIGHBOURS; n++) {
+            led_neighbour_t neighbour = g_led_neighbours[i][n];
+            ASSERT_NE(neighbour.index, NO_LED);
+            EXPECT_NE(neighbour.index, i);
+            EXPECT_EQ(neighbour.dist, distance(i, neighbour.index));
+            EXPECT_GE(neighbour.dist, furthest);
+            furthest = neighbour.dist;
+        }
+        for (uint8_t j = 0; j < RGB_MATRIX_LED_COUNT; j++) {
+            bool listed = j == i;
+            for (uint8_t n = 0; n < RGB_MATRIX_GEOMETRY_NEIGHBOURS; n++) {
+                listed |= g_led_neighbours[i][n].index == j;
+            }
+            if (!listed) {
+                EXPECT_GE(distance(i, j), furthest);
+            }
+        }
+    }
+
+    // A key in the second row has the keys beside it closest, then the ones above and below
+    EXPECT_EQ(g_led_neighbours[14][0].dist, 15);
+    EXPECT_EQ(g_led_neighbours[14][1].dist, 15);
+    EXPECT_EQ(g_led_neighbours[14][2].dist, 16);
+    EXPECT_EQ(g_led_neighbours[14][3].dist, 16);
+}
+
+
+TEST_F(RgbMatrixGeometry, TableCoversHeatmapSpread) {
+    // Every key within two columns and one or two rows is within the spread
+    uint8_t within = 0;
+    for (uint8_t i = 0; i < FIRST_UNDERGLOW; i++) {
+        within += i != 14 && distance(14, i) <= RGB_MATRIX_TYPING_HEATMAP_SPREAD;
+    }
+    EXPECT_EQ(within, 17);
+
+    for (uint8_t i = 0; i < FIRST_UNDERGLOW; i++) {
+        EXPECT_GT(g_led_geometry[i].reach, RGB_MATRIX_TYPING_HEATMAP_SPREAD) << "key LED " << +i;
+    }
+}
+
+TEST_F(RgbMatrixGeometry, TypingHeatmapMatchesFullScan) {
+    expect_heatmap_matches_full_scan();
+}
+
+TEST_F(RgbMatrixGeometry, TypingHeatmapFallsBackWhenTableIsShort) {
+    // Crowd the underglow under a key, so it has more LEDs within the spread than the table holds
+    for (uint8_t i = 0; i < UNDERGLOW_COUNT; i++) {
+        g_led_config.point[FIRST_UNDERGLOW + i] = g_led_config.point[14];
+    }
+    rgb_matrix_geometry_init();
+    EXPECT_LE(g_led_geometry[14].reach, RGB_MATRIX_TYPING_HEATMAP_SPREAD);
+
+    expect_heatmap_matches_full_scan();
+}
@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SEND_STRING_ASYNC
+#define SEND_STRING_QUEUE_SIZE 8
+#define UNICODE_SELECTED_MODES UNICODE_MODE_LINUX
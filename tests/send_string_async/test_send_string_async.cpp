@@ -0,0 +1,193 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {};
+
+TEST_F(SendStringAsync, ReturnsBeforeTyping) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    SEND_STRING("aB");
+    EXPECT_TRUE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(10);
+    EXPECT_FALSE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, SendsOneReportPerPass) {
+    TestDriver driver;
+
+    SEND_STRING("ab");
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, DelayDoesNotBlock) {
+    TestDriver driver;
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    SEND_STRING("a" SS_DELAY(100) "b");
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(60);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, KeycodeSequencesAreQueued) {
+    TestDriver driver;
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_C));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    SEND_STRING(SS_DOWN(X_LCTL) SS_TAP(X_C) SS_UP(X_LCTL));
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, StringIsCopiedIntoQueue) {
+    TestDriver driver;
+
+    char buffer[] = "xy";
+    EXPECT_NO_REPORT(driver);
+    send_string(buffer);
+    std::strcpy(buffer, "zz");
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_X));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_Y));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, FullQueueTypesInOrder) {
+    TestDriver driver;
+
+    // Eight operations fit in the queue, so the first characters are typed out before send_string() returns
+    {
+        InSequence s;
+        for (uint8_t keycode = KC_A; keycode <= KC_F; keycode++) {
+            EXPECT_REPORT(driver, (keycode));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+    }
+    send_string("abcdef");
+    EXPECT_TRUE(send_string_is_busy());
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CallbacksRunInOrder) {
+    TestDriver driver;
+    static int calls;
+    calls = 0;
+
+    EXPECT_ANY_REPORT(driver).Times(2);
+    SEND_STRING("a");
+    send_string_call([]() { calls++; });
+    EXPECT_EQ(calls, 0);
+    run_one_scan_loop();
+    EXPECT_EQ(calls, 0);
+    idle_for(10);
+    EXPECT_EQ(calls, 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, UnicodeStringIsQueued) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    // The input sequences don't fit in the queue, so the first few keys are sent straight away
+    {
+        InSequence s;
+        EXPECT_UNICODE(driver, 0xFF31);
+        EXPECT_UNICODE(driver, 0xFF2D);
+        EXPECT_UNICODE(driver, 0xFF2B);
+    }
+    send_unicode_string("ＱＭＫ");
+    EXPECT_TRUE(send_string_is_busy());
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, DirectTapDuringStringLeavesNoKeysHeld) {
+    TestDriver driver;
+
+    SEND_STRING("A");
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // A direct tap goes out straight away, on top of whatever the string is holding
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_X));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    }
+    tap_code(KC_X);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(10);
+    EXPECT_FALSE(send_string_is_busy());
+    EXPECT_EQ(get_mods(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,5 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+TASK_PROFILER_ENABLE = yes
+RAW_ENABLE = yes
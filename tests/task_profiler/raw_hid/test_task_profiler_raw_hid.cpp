@@ -0,0 +1,87 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "raw_hid.h"
+#include "task_profiler.h"
+}
+
+static std::vector<std::vector<uint8_t>> sent;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    sent.emplace_back(data, data + length);
+}
+
+class TaskProfilerRawHid : public TestFixture {
+   protected:
+    void SetUp() override {
+        task_profiler_set_enabled(true);
+        task_profiler_reset();
+        sent.clear();
+    }
+
+    std::vector<uint8_t> request(uint8_t command, uint16_t offset, uint8_t value = 0) {
+        uint8_t packet[32] = {TASK_PROFILER_RAW_HID_ID, command, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), value};
+        EXPECT_TRUE(task_profiler_raw_hid_receive(packet, sizeof(packet)));
+        EXPECT_EQ(sent.size(), 1);
+        auto reply = sent.back();
+        sent.clear();
+        return reply;
+    }
+};
+
+TEST_F(TaskProfilerRawHid, ReadsDumpInChunks) {
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, 1);
+
+    std::vector<uint8_t> dump(task_profiler_dump_size());
+    task_profiler_read_dump(0, dump.data(), dump.size());
+
+    /* The data follows the echoed header, zero padded past the end of the dump. */
+    std::vector<uint8_t> received;
+    for (uint16_t offset = 0; offset < dump.size(); offset += 28) {
+        auto reply = request(0x01, offset);
+        ASSERT_EQ(reply.size(), 32);
+        EXPECT_EQ(reply[0], TASK_PROFILER_RAW_HID_ID);
+        EXPECT_EQ(reply[1], 0x01);
+        EXPECT_EQ(reply[2], offset >> 8);
+        EXPECT_EQ(reply[3], offset & 0xFF);
+        received.insert(received.end(), reply.begin() + 4, reply.end());
+    }
+    EXPECT_TRUE(std::all_of(received.begin() + dump.size(), received.end(), [](uint8_t byte) { return byte == 0; }));
+    received.resize(dump.size());
+    EXPECT_EQ(received, dump);
+    EXPECT_EQ(received[0], 'T');
+    EXPECT_EQ(received[1], 'P');
+    EXPECT_EQ(received[2], TASK_PROFILER_DUMP_VERSION);
+}
+
+TEST_F(TaskProfilerRawHid, ResetsAndPauses) {
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, 1);
+    request(0x02, 0);
+
+    task_profiler_histogram_t histogram;
+    task_profiler_read_dump(offsetof(task_profiler_dump_t, slots), (uint8_t *)&histogram, sizeof(histogram));
+    EXPECT_EQ(histogram.samples, 0);
+
+    request(0x03, 0, 0);
+    EXPECT_FALSE(task_profiler_is_enabled());
+    request(0x03, 0, 1);
+    EXPECT_TRUE(task_profiler_is_enabled());
+}
+
+TEST_F(TaskProfilerRawHid, UnknownCommand) {
+    auto reply = request(0x7F, 0);
+    EXPECT_EQ(reply[0], 0xFF);
+    EXPECT_EQ(reply[1], 0x7F);
+}
+
+TEST_F(TaskProfilerRawHid, IgnoresOtherPackets) {
+    uint8_t packet[32] = {0x01};
+    EXPECT_FALSE(task_profiler_raw_hid_receive(packet, sizeof(packet)));
+    EXPECT_TRUE(sent.empty());
+}
@@ -0,0 +1,91 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "task_profiler.h"
+}
+
+using testing::_;
+
+class TaskProfiler : public TestFixture {
+   protected:
+    void SetUp() override {
+        task_profiler_set_enabled(true);
+        task_profiler_reset();
+    }
+
+    static task_profiler_histogram_t read_slot(task_profiler_slot_t slot) {
+        task_profiler_histogram_t histogram;
+        task_profiler_read_dump(offsetof(task_profiler_dump_t, slots) + slot * sizeof(histogram), (uint8_t *)&histogram, sizeof(histogram));
+        return histogram;
+    }
+};
+
+TEST_F(TaskProfiler, DumpHeader) {
+    task_profiler_dump_t dump;
+
+    EXPECT_EQ(task_profiler_dump_size(), sizeof(dump));
+    EXPECT_EQ(task_profiler_read_dump(0, (uint8_t *)&dump, sizeof(dump)), sizeof(dump));
+    EXPECT_EQ(dump.magic[0], 'T');
+    EXPECT_EQ(dump.magic[1], 'P');
+    EXPECT_EQ(dump.version, TASK_PROFILER_DUMP_VERSION);
+    EXPECT_EQ(dump.slot_count, TASK_PROFILER_SLOT_COUNT);
+    EXPECT_EQ(dump.bucket_count, TASK_PROFILER_BUCKETS);
+    EXPECT_EQ(dump.bucket_shift, TASK_PROFILER_BUCKET_SHIFT);
+
+    /* Reads past the end are clamped. */
+    uint8_t tail[8];
+    EXPECT_EQ(task_profiler_read_dump(sizeof(dump) - 2, tail, sizeof(tail)), 2);
+    EXPECT_EQ(task_profiler_read_dump(sizeof(dump), tail, sizeof(tail)), 0);
+}
+
+TEST_F(TaskProfiler, HistogramBuckets) {
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, 0);
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, (1 << TASK_PROFILER_BUCKET_SHIFT) - 1);
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, 1 << TASK_PROFILER_BUCKET_SHIFT);
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, 3 << TASK_PROFILER_BUCKET_SHIFT);
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, UINT32_MAX);
+
+    auto histogram = read_slot(TASK_PROFILER_MAIN_LOOP);
+    EXPECT_EQ(histogram.samples, 5);
+    EXPECT_EQ(histogram.max, UINT32_MAX);
+    EXPECT_EQ(histogram.buckets[0], 2);
+    EXPECT_EQ(histogram.buckets[1], 1);
+    EXPECT_EQ(histogram.buckets[2], 1);
+    EXPECT_EQ(histogram.buckets[TASK_PROFILER_BUCKETS - 1], 1);
+}
+
+TEST_F(TaskProfiler, PausedDoesNotRecord) {
+    TestDriver driver;
+
+    task_profiler_set_enabled(false);
+    task_profiler_record(TASK_PROFILER_MAIN_LOOP, 1);
+    run_one_scan_loop();
+
+    EXPECT_EQ(read_slot(TASK_PROFILER_MAIN_LOOP).samples, 0);
+    EXPECT_EQ(read_slot(TASK_PROFILER_MATRIX_TASK).samples, 0);
+}
+
+TEST_F(TaskProfiler, RecordsTasksAndKeyLatency) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(read_slot(TASK_PROFILER_KEY_LATENCY).samples, 2);
+    EXPECT_EQ(read_slot(TASK_PROFILER_MATRIX_TASK).samples, 2);
+    EXPECT_EQ(read_slot(TASK_PROFILER_QUANTUM_TASK).samples, 2);
+}
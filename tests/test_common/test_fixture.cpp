@@ -132,7 +132,7 @@ void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
 }
 
 const KeymapKey* TestFixture::find_key(layer_t layer, keypos_t position) const {
-    auto keymap_key_predicate = [&](KeymapKey candidate) { return candidate.layer == layer && candidate.position.col == position.col && candidate.position.row == position.row; };
+    auto keymap_key_predicate = [&](const KeymapKey& candidate) { return candidate.layer == layer && candidate.position.col == position.col && candidate.position.row == position.row; };
 
     auto result = std::find_if(this->keymap.begin(), this->keymap.end(), keymap_key_predicate);
 
@@ -0,0 +1,182 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "tickless_idle.h"
+#include "deferred_exec.h"
+
+void     advance_time(uint32_t ms);
+void     tickless_idle_simulate_wake(uint32_t after_ms);
+uint32_t tickless_idle_sleep_count(void);
+uint32_t tickless_idle_last_sleep(void);
+
+static bool arm_allowed;
+static int  disarm_calls;
+
+bool matrix_idle_arm(void) {
+    return arm_allowed;
+}
+
+void matrix_idle_disarm(void) {
+    disarm_calls++;
+}
+
+static uint32_t deferred_callback(uint32_t trigger_time, void *cb_arg) {
+    return 0;
+}
+}
+
+using testing::_;
+
+class TicklessIdle : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        arm_allowed    = true;
+        disarm_calls   = 0;
+        tickless_idle_simulate_wake(UINT32_MAX);
+        EXPECT_NO_REPORT(driver);
+        idle_for(TICKLESS_IDLE_TIMEOUT);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+    }
+};
+
+TEST_F(TicklessIdle, IdleKeyboardSleepsForTheMaximum) {
+    uint32_t sleeps = tickless_idle_sleep_count();
+    uint32_t start  = timer_read32();
+
+    EXPECT_EQ(tickless_idle_delay(), (uint32_t)TICKLESS_IDLE_MAX_SLEEP);
+    tickless_idle_task();
+
+    EXPECT_EQ(tickless_idle_sleep_count(), sleeps + 1);
+    EXPECT_EQ(tickless_idle_last_sleep(), (uint32_t)TICKLESS_IDLE_MAX_SLEEP);
+    EXPECT_EQ(timer_elapsed32(start), (uint32_t)TICKLESS_IDLE_MAX_SLEEP);
+    EXPECT_EQ(disarm_calls, 1);
+}
+
+TEST_F(TicklessIdle, HeldKeyPreventsSleep) {
+    KeymapKey key(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    key.press();
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    EXPECT_NO_REPORT(driver);
+    idle_for(TICKLESS_IDLE_TIMEOUT * 2);
+    EXPECT_EQ(tickless_idle_delay(), 0u);
+
+    key.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Activity keeps the keyboard scanning at full rate for a while after the release
+    EXPECT_EQ(tickless_idle_delay(), 0u);
+    idle_for(TICKLESS_IDLE_TIMEOUT);
+    EXPECT_EQ(tickless_idle_delay(), (uint32_t)TICKLESS_IDLE_MAX_SLEEP);
+}
+
+TEST_F(TicklessIdle, ArmFailureSkipsSleep) {
+    uint32_t sleeps = tickless_idle_sleep_count();
+    arm_allowed     = false;
+
+    tickless_idle_task();
+    EXPECT_EQ(tickless_idle_sleep_count(), sleeps);
+    EXPECT_EQ(disarm_calls, 0);
+}
+
+TEST_F(TicklessIdle, DeferredExecutorEndsSleep) {
+    deferred_token token = defer_exec(20, deferred_callback, NULL);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    EXPECT_EQ(tickless_idle_delay(), 20u);
+    tickless_idle_task();
+    EXPECT_EQ(tickless_idle_last_sleep(), 20u);
+
+    // The executor is due as soon as the sleep ends
+    EXPECT_EQ(tickless_idle_delay(), 0u);
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    EXPECT_EQ(tickless_idle_delay(), (uint32_t)TICKLESS_IDLE_MAX_SLEEP);
+}
+
+TEST_F(TicklessIdle, ShortSleepsAreSkipped) {
+    uint32_t       sleeps = tickless_idle_sleep_count();
+    deferred_token token  = defer_exec(TICKLESS_IDLE_MIN_SLEEP - 1, deferred_callback, NULL);
+
+    tickless_idle_task();
+    EXPECT_EQ(tickless_idle_sleep_count(), sleeps);
+    EXPECT_TRUE(cancel_deferred_exec(token));
+}
+
+TEST_F(TicklessIdle, PendingTapEndsSleep) {
+    KeymapKey key(0, 1, 0, SFT_T(KC_P));
+    set_keymap({key});
+
+    key.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    key.release();
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The tap stays pending until the tapping term has passed since the press
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM - 30);
+    uint32_t delay = tickless_idle_delay();
+    EXPECT_GE(delay, 28u);
+    EXPECT_LE(delay, 30u);
+
+    // Sleeping through the remainder lets the next scan resolve it
+    advance_time(delay);
+    run_one_scan_loop();
+    EXPECT_EQ(tickless_idle_delay(), (uint32_t)TICKLESS_IDLE_MAX_SLEEP);
+}
+
+TEST_F(TicklessIdle, PinChangeWakesEarly) {
+    uint32_t start = timer_read32();
+    tickless_idle_simulate_wake(5);
+    tickless_idle_task();
+
+    EXPECT_EQ(timer_elapsed32(start), 5u);
+    EXPECT_EQ(disarm_calls, 1);
+
+    // The matrix is scanned at full rate after being woken, so debouncing completes
+    EXPECT_EQ(tickless_idle_delay(), 0u);
+    advance_time(TICKLESS_IDLE_TIMEOUT);
+    EXPECT_EQ(tickless_idle_delay(), (uint32_t)TICKLESS_IDLE_MAX_SLEEP);
+}
+
+TEST_F(TicklessIdle, OneshotTimeoutEndsSleep) {
+    KeymapKey key(0, 2, 0, OSM(MOD_LSFT));
+    set_keymap({key});
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    tap_key(key);
+    idle_for(ONESHOT_TIMEOUT - 30);
+    EXPECT_TRUE(get_oneshot_mods());
+
+    // The sleep ends in time for the oneshot mod to time out
+    uint32_t delay = tickless_idle_delay();
+    EXPECT_GE(delay, 28u);
+    EXPECT_LE(delay, 30u);
+    advance_time(delay);
+    run_one_scan_loop();
+    EXPECT_FALSE(get_oneshot_mods());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(TicklessIdle, UsbPacketWakesEarly) {
+    uint32_t start = timer_read32();
+    tickless_idle_wake_from_isr();
+    tickless_idle_task();
+
+    EXPECT_EQ(timer_elapsed32(start), 0u);
+    EXPECT_EQ(tickless_idle_delay(), 0u);
+}
@@ -24,6 +24,9 @@
 
 #include <hal.h>
 #include "usb_driver.h"
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
 #include <string.h>
 
 /*===========================================================================*/
@@ -447,6 +450,11 @@ void qmkusbDataReceived(USBDriver *usbp, usbep_t ep) {
     (void)qmkusb_start_receive(qmkusbp);
 
     osalSysUnlockFromISR();
+
+#ifdef TICKLESS_IDLE_ENABLE
+    /* The main loop reads the packet, so it can't be left sleeping.*/
+    tickless_idle_wake_from_isr();
+#endif
 }
 
 /**
@@ -44,6 +44,12 @@
 #include "usb_descriptor.h"
 #include "usb_driver.h"
 #include "usb_types.h"
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+#ifdef TASK_PROFILER_ENABLE
+#    include "task_profiler.h"
+#endif
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -51,6 +57,10 @@
 extern keymap_config_t keymap_config;
 #endif
 
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_SOF_SYNC)
+#    include "pointing_device.h"
+#endif
+
 #if defined(CONSOLE_ENABLE)
 #    define RBUF_SIZE 256
 #    include "ring_buffer.h"
@@ -600,6 +610,10 @@ static void set_led_transfer_cb(USBDriver *usbp) {
     } else {
         keyboard_led_state = set_report_buf[0];
     }
+
+#ifdef TICKLESS_IDLE_ENABLE
+    tickless_idle_wake_from_isr();
+#endif
 }
 
 static bool usb_requests_hook_cb(USBDriver *usbp) {
@@ -735,6 +749,9 @@ static void usb_sof_cb(USBDriver *usbp) {
         qmkusbSOFHookI(&drivers.array[i].driver);
     }
     osalSysUnlockFromISR();
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_SOF_SYNC)
+    pointing_device_sof();
+#endif
 }
 
 /* USB driver configuration */
@@ -977,6 +994,9 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_raw_hid_receive(data, length);
+#endif
 }
 
 void raw_hid_task(void) {
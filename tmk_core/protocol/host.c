@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#ifdef TASK_PROFILER_ENABLE
+#    include "task_profiler.h"
+#endif
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -73,6 +76,10 @@ led_t host_keyboard_led_state(void) {
 
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_report_sent();
+#endif
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_keyboard(report);
@@ -96,6 +103,10 @@ void host_keyboard_send(report_keyboard_t *report) {
 }
 
 void host_nkro_send(report_nkro_t *report) {
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_report_sent();
+#endif
+
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
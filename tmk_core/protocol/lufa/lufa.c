@@ -67,6 +67,10 @@
 #    include "raw_hid.h"
 #endif
 
+#ifdef TASK_PROFILER_ENABLE
+#    include "task_profiler.h"
+#endif
+
 uint8_t keyboard_idle = 0;
 /* 0: Boot Protocol, 1: Report Protocol(default) */
 uint8_t        keyboard_protocol  = 1;
@@ -145,6 +149,9 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_raw_hid_receive(data, length);
+#endif
 }
 
 /** \brief Raw HID Task
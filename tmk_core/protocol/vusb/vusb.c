@@ -35,6 +35,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "raw_hid.h"
 #endif
 
+#ifdef TASK_PROFILER_ENABLE
+#    include "task_profiler.h"
+#endif
+
 #ifdef JOYSTICK_ENABLE
 #    include "joystick.h"
 #endif
@@ -159,6 +163,9 @@ __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_raw_hid_receive(data, length);
+#endif
 }
 
 void raw_hid_task(void) {